@@ -0,0 +1,92 @@
+// Packs the static vertex and index buffers of many small geometries into a gl::GLBufferArena through gl::GLAttributes,
+// then removes them again in a different order, on a hidden window.
+// Sizes are deliberately not multiples of the arena alignment (e.g. three 16 bit indices), so every freed range must
+// be the aligned one handed out for the pages to coalesce and be released. Exits with 1 when any page is left over.
+
+#include "threepp/canvas/Canvas.hpp"
+#include "threepp/core/BufferAttribute.hpp"
+
+#include "threepp/renderers/gl/GLAttributes.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int numGeometries = 20000;
+
+    // GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER
+    constexpr unsigned int arrayBuffer = 0x8892;
+    constexpr unsigned int elementArrayBuffer = 0x8893;
+
+    struct Geometry {
+
+        std::shared_ptr<FloatBufferAttribute> position;
+        std::shared_ptr<Uint16BufferAttribute> index;
+    };
+
+}// namespace
+
+int main() {
+
+    Canvas canvas(Canvas::Parameters().size(64, 64).visible(false).antialiasing(0));
+
+    gl::GLAttributes attributes;
+    attributes.packStaticBuffers = true;
+
+    std::mt19937 rng(42);
+
+    std::vector<Geometry> geometries;
+    for (int i = 0; i < numGeometries; i++) {
+
+        const auto numVertices = 1 + rng() % 50;
+        const auto numIndices = 3 * (1 + rng() % 50);
+
+        Geometry geometry{
+                FloatBufferAttribute::create(std::vector<float>(numVertices * 3), 3),
+                Uint16BufferAttribute::create(std::vector<uint16_t>(numIndices), 1)};
+
+        attributes.update(geometry.position.get(), arrayBuffer);
+        attributes.update(geometry.index.get(), elementArrayBuffer);
+
+        geometries.emplace_back(std::move(geometry));
+    }
+
+    const auto numPages = attributes.arena().numPages();
+
+    std::ranges::shuffle(geometries, rng);
+
+    // the first half is removed, then a new set takes its place, so later allocations land in freed ranges
+    for (int i = 0; i < numGeometries / 2; i++) {
+
+        attributes.remove(geometries[i].position.get());
+        attributes.remove(geometries[i].index.get());
+        geometries[i].index.reset();
+
+        geometries[i].position = FloatBufferAttribute::create(std::vector<float>(3 * (1 + rng() % 50)), 3);
+        attributes.update(geometries[i].position.get(), arrayBuffer);
+    }
+
+    const auto numPagesReused = attributes.arena().numPages();
+
+    std::ranges::shuffle(geometries, rng);
+
+    for (const auto& geometry : geometries) {
+
+        attributes.remove(geometry.position.get());
+        if (geometry.index) attributes.remove(geometry.index.get());
+    }
+
+    const auto numPagesLeft = attributes.arena().numPages();
+
+    std::cout << numGeometries << " geometries: " << numPages << " pages, "
+              << numPagesReused << " after replacing half of them, "
+              << numPagesLeft << " after removing all of them" << std::endl;
+
+    attributes.dispose();
+
+    return (numPagesLeft == 0 && numPagesReused <= numPages) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// Renders the same scene with GLRenderer::clusteredLighting off and on, on a hidden window, e.g. with Mesa llvmpipe in headless CI.
+// The scene mixes hemisphere, spot and point lights, one of which casts shadows, so clustered programs (phong, standard)
+// read the shadow-casting lights from their uniform block while lambert keeps every light.
+// Exits with 1 when the two images differ by more than a few levels.
+
+#include "threepp/canvas/Canvas.hpp"
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/PlaneGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/lights/HemisphereLight.hpp"
+#include "threepp/lights/PointLight.hpp"
+#include "threepp/lights/SpotLight.hpp"
+#include "threepp/materials/MeshLambertMaterial.hpp"
+#include "threepp/materials/MeshPhongMaterial.hpp"
+#include "threepp/materials/MeshStandardMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/scenes/Scene.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int maxDifference = 8;
+
+    void buildScene(Scene& scene) {
+
+        scene.add(HemisphereLight::create(0x4444ff, 0x442200, 0.5f));
+
+        auto spot = SpotLight::create(0xffffff, 1.f);
+        spot->position.set(0, 5, 0);
+        scene.add(spot);
+
+        auto shadowed = PointLight::create(0xff0000, 1.f, 20.f);
+        shadowed->position.set(2, 2, 2);
+        shadowed->castShadow = true;
+        scene.add(shadowed);
+
+        for (int i = 0; i < 4; i++) {
+
+            auto light = PointLight::create(0x00ff00, 1.f, 10.f);
+            light->position.set(-2.f + static_cast<float>(i), 1, 1);
+            scene.add(light);
+        }
+
+        auto plane = Mesh::create(PlaneGeometry::create(10, 10), MeshStandardMaterial::create());
+        plane->rotation.x = -math::PI / 2;
+        plane->receiveShadow = true;
+        scene.add(plane);
+
+        auto box = Mesh::create(BoxGeometry::create(1, 1, 1), MeshPhongMaterial::create());
+        box->position.y = 0.5f;
+        box->castShadow = true;
+        scene.add(box);
+
+        auto sphere = Mesh::create(SphereGeometry::create(0.5f), MeshLambertMaterial::create());
+        sphere->position.set(-2, 0.5f, 0);
+        scene.add(sphere);
+    }
+
+    std::vector<unsigned char> renderOnce(GLRenderer& renderer, Scene& scene, Camera& camera, bool clustered) {
+
+        renderer.clusteredLighting = clustered;
+        renderer.render(scene, camera);
+
+        const auto size = renderer.size();
+        std::vector<unsigned char> pixels(size.width() * size.height() * 4);
+        renderer.readPixels({0, 0}, {size.width(), size.height()}, Format::RGBA, pixels.data());
+
+        return pixels;
+    }
+
+}// namespace
+
+int main() {
+
+    Canvas canvas(Canvas::Parameters().size(64, 64).visible(false).antialiasing(0));
+
+    GLRenderer renderer(canvas.size());
+    renderer.checkShaderErrors = true;
+    renderer.shadowMap().enabled = true;
+
+    Scene scene;
+    buildScene(scene);
+
+    PerspectiveCamera camera(60, 1, 0.1f, 100);
+    camera.position.set(0, 3, 6);
+    camera.lookAt({0, 0, 0});
+
+    const auto forward = renderOnce(renderer, scene, camera, false);
+    const auto clustered = renderOnce(renderer, scene, camera, true);
+
+    int difference = 0;
+    for (size_t i = 0; i < forward.size(); i++) {
+
+        difference = std::max(difference, std::abs(forward[i] - clustered[i]));
+    }
+
+    std::cout << "Largest difference between forward and clustered lighting: " << difference << std::endl;
+
+    return difference > maxDifference ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+// Counts the heap allocations made while an image goes from ImageLoader through Texture::create(Image&&)
+// to the pointer the renderer uploads from, to check that the decoded pixels are never copied.
+// No GL context is needed, the upload reads image().pixels() just like GLTextures does.
+// Exits with 1 when a copy of the pixels is made.
+
+#include "threepp/loaders/ImageLoader.hpp"
+#include "threepp/textures/Texture.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace threepp;
+
+namespace {
+
+    size_t largeAllocations = 0;
+    size_t largeThreshold = 0;
+
+    // number of allocations at least the size of the pixels made by fn
+    template<class Fn>
+    size_t count(Fn&& fn) {
+
+        largeAllocations = 0;
+        fn();
+
+        return largeAllocations;
+    }
+
+}// namespace
+
+// stb_image allocates the decoded pixels with malloc, so only copies made afterwards end up here
+void* operator new(size_t size) {
+
+    if (largeThreshold > 0 && size >= largeThreshold) ++largeAllocations;
+
+    if (auto p = std::malloc(size > 0 ? size : 1)) return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+
+    const std::filesystem::path path = argc > 1 ? argv[1] : std::filesystem::path(DATA_FOLDER) / "textures/brick_bump.jpg";
+
+    ImageLoader loader;
+    std::optional<Image> image;
+    std::shared_ptr<Texture> texture;
+
+    // any allocation the size of the pixels counts as a copy of them
+    if (const auto probe = loader.load(path)) {
+
+        largeThreshold = probe->byteSize();
+
+    } else {
+
+        std::cerr << "Unable to load " << path << std::endl;
+        return 1;
+    }
+
+    const auto load = count([&] { image = loader.load(path); });
+    const auto decoded = image->pixels();
+
+    const auto create = count([&] { texture = Texture::create(std::move(*image)); });
+
+    const void* uploaded = nullptr;
+    const auto upload = count([&] { uploaded = texture->image().pixels(); });
+
+    const auto& result = texture->image();
+    const bool sameMemory = uploaded == decoded && result.view().data() == decoded;
+
+    std::cout << result.width << "x" << result.height << ", " << result.byteSize() << " bytes" << std::endl;
+    std::cout << "  load: " << load << " copies" << std::endl;
+    std::cout << "  Texture::create(Image&&): " << create << " copies" << std::endl;
+    std::cout << "  upload: " << upload << " copies, uploads the decoded memory " << std::boolalpha << sameMemory << std::endl;
+
+    return (load + create + upload == 0 && sameMemory) ? 0 : 1;
+}
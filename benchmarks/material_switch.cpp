@@ -0,0 +1,74 @@
+// Measures the CPU cost of refreshing the uniforms of a material on every material switch, with the uniforms
+// looked up by name as the renderer used to (gl::MaterialUniforms without caching) and through cached integer slots.
+// Four kinds of lit materials are drawn in turn, so every draw switches material.
+// No GL context is needed, only GLMaterials::refreshMaterialUniforms is timed.
+
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/materials/MeshLambertMaterial.hpp"
+#include "threepp/materials/MeshPhongMaterial.hpp"
+#include "threepp/materials/MeshStandardMaterial.hpp"
+
+#include "threepp/renderers/gl/GLMaterials.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
+#include "threepp/renderers/shaders/ShaderLib.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int numSwitches = 1000000;
+
+    struct Draw {
+
+        std::shared_ptr<Material> material;
+        UniformMap uniforms;
+    };
+
+    // Refreshes the materials in turn, and returns the mean time per refresh in ns.
+    double measure(gl::GLMaterials& materials, std::vector<Draw>& draws, bool cache) {
+
+        std::vector<gl::MaterialUniforms> slots;
+        for (auto& draw : draws) slots.emplace_back(draw.uniforms, cache);
+
+        // first round fills the slots
+        for (size_t i = 0; i < draws.size(); i++) materials.refreshMaterialUniforms(slots[i], draws[i].material.get(), 1, 600);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < numSwitches; i++) {
+
+            const auto index = i % draws.size();
+            materials.refreshMaterialUniforms(slots[index], draws[index].material.get(), 1, 600);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / numSwitches;
+    }
+
+}// namespace
+
+int main() {
+
+    gl::GLProperties properties;
+    gl::GLMaterials materials(properties);
+
+    auto& lib = shaders::ShaderLib::instance();
+
+    std::vector<Draw> draws;
+    draws.push_back({MeshStandardMaterial::create(), lib.get("physical").uniforms});
+    draws.push_back({MeshPhongMaterial::create(), lib.get("phong").uniforms});
+    draws.push_back({MeshLambertMaterial::create(), lib.get("lambert").uniforms});
+    draws.push_back({MeshBasicMaterial::create(), lib.get("basic").uniforms});
+
+    // set up by the renderer when the program is created
+    for (const auto& draw : draws) properties.materialProperties.get(draw.material.get())->envMap = nullptr;
+
+    const auto byName = measure(materials, draws, false);
+    const auto bySlot = measure(materials, draws, true);
+
+    std::cout << numSwitches << " material switches, ns per refresh: by name " << byName << ", slots " << bySlot << std::endl;
+}
@@ -0,0 +1,81 @@
+// Counts the heap allocations and measures the time of constructing Object3Ds, and checks the size of the class.
+// Object3D keeps its matrices inline and creates its uuid and userData on first use, so constructing one on the stack
+// must not allocate, and create() only allocates the shared_ptr control block together with the object.
+// Exits with 1 when either count or the size grows.
+
+#include "threepp/core/Object3D.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int numObjects = 100000;
+
+    // 64 bit libstdc++, raise only with a good reason
+    constexpr size_t maxObject3DSize = 840;
+
+    constexpr size_t maxConstructAllocations = 0;
+    constexpr size_t maxCreateAllocations = 1;
+
+    size_t allocations = 0;
+
+    // number of allocations made by fn
+    template<class Fn>
+    size_t count(Fn&& fn) {
+
+        allocations = 0;
+        fn();
+
+        return allocations;
+    }
+
+}// namespace
+
+void* operator new(size_t size) {
+
+    ++allocations;
+
+    if (auto p = std::malloc(size > 0 ? size : 1)) return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+
+    std::free(p);
+}
+
+int main() {
+
+    const auto construct = count([] { Object3D object; });
+    const auto create = count([] { auto object = Object3D::create(); });
+
+    std::vector<std::shared_ptr<Object3D>> objects;
+    objects.reserve(numObjects);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numObjects; i++) objects.emplace_back(Object3D::create());
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "sizeof(Object3D): " << sizeof(Object3D) << " bytes (max " << maxObject3DSize << ")" << std::endl;
+    std::cout << "  Object3D(): " << construct << " allocations (max " << maxConstructAllocations << ")" << std::endl;
+    std::cout << "  Object3D::create(): " << create << " allocations (max " << maxCreateAllocations << "), "
+              << elapsed.count() / numObjects << " ns" << std::endl;
+
+    const bool regressed = sizeof(Object3D) > maxObject3DSize ||
+                           construct > maxConstructAllocations ||
+                           create > maxCreateAllocations;
+
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+// Measures the CPU cost of finding the per object GL state of every draw in a 10k draw scene,
+// with the hash maps the renderer used before and with the slot handles (gl::GLSlotMap) it uses now.
+// No GL context is needed, only the bookkeeping is timed.
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+
+#include "threepp/renderers/gl/GLSlotMap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <unordered_map>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int numDraws = 10000;
+    constexpr int numMaterials = 500;
+    constexpr int numFrames = 100;
+
+    struct Buffer {
+
+        unsigned int buffer{};
+        unsigned int version{};
+    };
+
+    struct Draw {
+
+        Material* material;
+        BufferGeometry* geometry;
+        std::vector<BufferAttribute*> attributes;
+    };
+
+    // GLProperties, GLGeometries, GLObjects, GLBindingStates and GLAttributes before slot handles
+    struct HashMapTables {
+
+        std::unordered_map<Material*, int> materialProperties;
+        std::unordered_map<BufferGeometry*, bool> geometries;
+        std::unordered_map<BufferGeometry*, size_t> updateMap;
+        std::unordered_map<unsigned int, std::unordered_map<int, std::unordered_map<bool, int>>> bindingStates;
+        std::unordered_map<BufferAttribute*, Buffer> buffers;
+
+        size_t draw(const Draw& draw, size_t frame) {
+
+            size_t sum = materialProperties[draw.material];
+
+            if (!geometries.contains(draw.geometry) || !geometries.at(draw.geometry)) geometries[draw.geometry] = true;
+
+            if (!updateMap.contains(draw.geometry) || updateMap[draw.geometry] != frame) updateMap[draw.geometry] = frame;
+
+            sum += bindingStates[draw.geometry->id][1][false];
+
+            for (auto attribute : draw.attributes) sum += buffers[attribute].version;
+
+            return sum;
+        }
+    };
+
+    struct SlotMapTables {
+
+        gl::GLSlotMap<Material, int> materialProperties;
+        gl::GLSlotMap<BufferGeometry, bool> geometries;
+        gl::GLSlotMap<BufferGeometry, std::optional<size_t>> updateMap;
+        gl::GLSlotMap<BufferGeometry, int> bindingStates;
+        gl::GLSlotMap<BufferAttribute, Buffer> buffers;
+
+        size_t draw(const Draw& draw, size_t frame) {
+
+            size_t sum = materialProperties.get(draw.material);
+
+            geometries.get(draw.geometry) = true;
+
+            auto& updated = updateMap.get(draw.geometry);
+            if (updated != frame) updated = frame;
+
+            sum += bindingStates.get(draw.geometry);
+
+            for (auto attribute : draw.attributes) sum += buffers.get(attribute).version;
+
+            return sum;
+        }
+    };
+
+    // Renders every frame with each renderer in turn, and returns the mean time per draw and renderer in ns.
+    template<class Tables>
+    double measure(std::vector<Tables>& renderers, const std::vector<Draw>& draws, size_t& checksum) {
+
+        // first frame fills the tables
+        for (auto& renderer : renderers) {
+            for (const auto& draw : draws) checksum += renderer.draw(draw, 0);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t frame = 1; frame <= numFrames; frame++) {
+            for (auto& renderer : renderers) {
+                for (const auto& draw : draws) checksum += renderer.draw(draw, frame);
+            }
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / (static_cast<double>(numFrames) * static_cast<double>(renderers.size()) * numDraws);
+    }
+
+}// namespace
+
+int main() {
+
+    std::vector<std::shared_ptr<Material>> materials;
+    for (int i = 0; i < numMaterials; i++) materials.emplace_back(MeshBasicMaterial::create());
+
+    std::vector<std::shared_ptr<BufferGeometry>> geometries;
+    std::vector<Draw> draws;
+    for (int i = 0; i < numDraws; i++) {
+
+        auto geometry = BufferGeometry::create();
+        geometry->setAttribute("position", FloatBufferAttribute::create(std::vector<float>(9), 3));
+        geometry->setAttribute("normal", FloatBufferAttribute::create(std::vector<float>(9), 3));
+        geometry->setAttribute("uv", FloatBufferAttribute::create(std::vector<float>(6), 2));
+
+        draws.push_back({materials[i % numMaterials].get(), geometry.get(),
+                         {geometry->getAttribute("position"), geometry->getAttribute("normal"), geometry->getAttribute("uv")}});
+        geometries.emplace_back(std::move(geometry));
+    }
+
+    // render lists are sorted by program and depth, not by creation order
+    std::shuffle(draws.begin(), draws.end(), std::mt19937(42));
+
+    size_t checksum = 0;
+
+    std::cout << numDraws << " draws, " << numFrames << " frames, ns per draw:" << std::endl;
+
+    for (int numRenderers : {1, 2}) {
+
+        std::vector<HashMapTables> before(numRenderers);
+        std::vector<SlotMapTables> after(numRenderers);
+
+        const auto beforeNs = measure(before, draws, checksum);
+        const auto afterNs = measure(after, draws, checksum);
+
+        std::cout << "  " << numRenderers << " renderer(s): hash maps " << beforeNs
+                  << ", slot handles " << afterNs << std::endl;
+    }
+
+    // printed so that the lookups are not optimized away
+    std::cout << "checksum " << checksum << std::endl;
+}
@@ -0,0 +1,118 @@
+// Exercises GLRenderer::programBinaryCacheDirectory on a hidden window, e.g. with Mesa llvmpipe in headless CI.
+// The same scene is rendered by three renderers in turn against an empty temporary directory:
+// the first compiles from source and stores the binary (miss), the second loads it (hit), and the third finds
+// a corrupted file, which the driver must reject before the program is linked from source again.
+// Every render must still draw the red quad. Exits with 1 when a count or a pixel is off.
+
+#include "threepp/canvas/Canvas.hpp"
+#include "threepp/cameras/OrthographicCamera.hpp"
+#include "threepp/geometries/PlaneGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/GLRenderer.hpp"
+#include "threepp/scenes/Scene.hpp"
+
+#include <array>
+#include <fstream>
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    struct Expected {
+
+        size_t hits;
+        size_t misses;
+        size_t rejected;
+    };
+
+    // each run gets its own renderer and scene, so nothing from a previous run is reused but the files
+    std::array<unsigned char, 4> renderOnce(const WindowSize& size, const std::filesystem::path& directory, gl::ProgramInfo& info) {
+
+        Scene scene;
+        OrthographicCamera camera;
+        camera.position.z = 1;
+
+        scene.add(Mesh::create(PlaneGeometry::create(2, 2), MeshBasicMaterial::create({{"color", Color(Color::red)}})));
+
+        GLRenderer renderer(size);
+        renderer.checkShaderErrors = true;
+        renderer.programBinaryCacheDirectory = directory;
+        renderer.setClearColor(Color::black);
+
+        renderer.render(scene, camera);
+
+        std::array<unsigned char, 4> pixel{};
+        renderer.readPixels({static_cast<float>(size.width() / 2), static_cast<float>(size.height() / 2)}, {1, 1}, Format::RGBA, pixel.data());
+
+        info = renderer.info().programs;
+
+        return pixel;
+    }
+
+    // flips every byte of the second half of each entry, keeping the header and length intact
+    void corrupt(const std::filesystem::path& directory) {
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+
+            std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+
+            const auto length = static_cast<std::streamoff>(entry.file_size());
+            for (auto offset = length / 2; offset < length; offset++) {
+
+                file.seekg(offset);
+                const auto byte = static_cast<char>(~file.get());
+                file.seekp(offset);
+                file.put(byte);
+            }
+        }
+    }
+
+    bool check(const std::string& name, const gl::ProgramInfo& info, const Expected& expected, const std::array<unsigned char, 4>& pixel) {
+
+        const bool red = pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0;
+        const bool ok = red &&
+                        info.binaryCacheHits == expected.hits &&
+                        info.binaryCacheMisses == expected.misses &&
+                        info.binaryCacheRejected == expected.rejected;
+
+        std::cout << "  " << name << ": " << info << ", drew the quad " << std::boolalpha << red << (ok ? "" : " <- unexpected") << std::endl;
+
+        return ok;
+    }
+
+}// namespace
+
+int main() {
+
+    const auto directory = std::filesystem::temp_directory_path() / "threepp_program_binary_cache";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    Canvas canvas(Canvas::Parameters().size(64, 64).visible(false).antialiasing(0));
+
+    gl::ProgramInfo info;
+
+    auto pixel = renderOnce(canvas.size(), directory, info);
+
+    if (info.binaryCacheMisses == 0) {
+
+        std::cout << "Program binaries are not supported by this driver, nothing to check" << std::endl;
+        return 0;
+    }
+
+    bool ok = check("first run", info, {0, 1, 0}, pixel);
+
+    pixel = renderOnce(canvas.size(), directory, info);
+    ok = check("second run", info, {1, 0, 0}, pixel) && ok;
+
+    corrupt(directory);
+
+    pixel = renderOnce(canvas.size(), directory, info);
+    ok = check("corrupted binary", info, {0, 1, 1}, pixel) && ok;
+
+    std::filesystem::remove_all(directory);
+
+    return ok ? 0 : 1;
+}
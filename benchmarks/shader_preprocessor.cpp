@@ -0,0 +1,218 @@
+// Checks that gl::resolveIncludes and gl::unrollLoops produce exactly what the regex based passes they replaced did,
+// for every ShaderLib source across light and clipping plane counts, and for randomly assembled sources.
+// Also prints the time both take per source. Exits with 1 on any difference.
+
+#include "threepp/renderers/gl/ShaderPreprocessor.hpp"
+#include "threepp/renderers/shaders/ShaderChunk.hpp"
+#include "threepp/renderers/shaders/ShaderLib.hpp"
+#include "threepp/utils/RegexUtil.hpp"
+#include "threepp/utils/StringUtils.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+
+using namespace threepp;
+
+namespace {
+
+    // GLProgram.cpp before the hand written preprocessor
+    namespace reference {
+
+        std::string loopReplacer(const std::smatch& match) {
+
+            static std::regex reg1(R"(\[\s*i\s*\])");
+
+            auto start = utils::parseInt(match[1].str());
+            auto end = utils::parseInt(match[2].str());
+
+            std::stringstream ss;
+            for (int i = start; i < end; ++i) {
+
+                auto str = std::regex_replace(match[3].str(), reg1, "[ " + std::to_string(i) + " ]");
+                utils::replaceAll(str, "UNROLLED_LOOP_INDEX", std::to_string(i));
+                ss << str;
+            }
+
+            return ss.str();
+        }
+
+        std::string resolveIncludes(const std::string& str) {
+
+            static const std::regex rex("#include +<([\\w\\d.]+)>");
+
+            std::string result;
+
+            std::sregex_iterator rex_it(str.begin(), str.end(), rex);
+            std::sregex_iterator rex_end;
+            size_t pos = 0;
+
+            while (rex_it != rex_end) {
+                std::smatch match = *rex_it;
+                result.append(str, pos, match.position(0) - pos);
+                pos = match.position(0) + match.length(0);
+
+                const std::ssub_match& sub = match[1];
+                const std::string& r = shaders::ShaderChunk::instance().get(sub.str());
+                if (r.empty()) {
+                    std::stringstream ss;
+                    ss << "unable to resolve #include <" << sub.str() << ">";
+                    throw std::logic_error(ss.str());
+                }
+                result.append(r);
+                ++rex_it;
+            }
+
+            if (pos == 0) return str;
+            else {
+                result.append(str, pos, str.length());
+                return result;
+            }
+        }
+
+        std::string unrollLoops(const std::string& glsl) {
+
+            static const std::regex rex(R"(#pragma unroll_loop_start\s+for\s*\(\s*int\s+i\s*=\s*(\d+)\s*;\s*i\s*<\s*(\d+)\s*;\s*i\s*\+\+\s*\)\s*\{([\s\S]+?)\}\s+#pragma unroll_loop_end)");
+
+            return ::regex_replace(glsl, rex, loopReplacer);
+        }
+
+    }// namespace reference
+
+    const char* shaderNames[]{
+            "basic", "lambert", "phong", "standard", "toon", "matcap", "points", "dashed", "depth",
+            "normal", "sprite", "background", "cube", "equirect", "distanceRGBA", "shadow", "physical"};
+
+    struct Counts {
+
+        int lights;
+        int shadows;
+        int clippingPlanes;
+        int clipIntersection;
+    };
+
+    // what GLProgram does between resolving includes and unrolling loops
+    void replaceNums(std::string& str, const Counts& counts) {
+
+        utils::replaceAll(str, "NUM_DIR_LIGHTS", std::to_string(counts.lights));
+        utils::replaceAll(str, "NUM_SPOT_LIGHTS", std::to_string(counts.lights));
+        utils::replaceAll(str, "NUM_RECT_AREA_LIGHTS", "0");
+        utils::replaceAll(str, "NUM_POINT_LIGHTS", std::to_string(counts.lights));
+        utils::replaceAll(str, "NUM_HEMI_LIGHTS", std::to_string(counts.lights));
+        utils::replaceAll(str, "NUM_DIR_LIGHT_SHADOWS", std::to_string(counts.shadows));
+        utils::replaceAll(str, "NUM_SPOT_LIGHT_SHADOWS", std::to_string(counts.shadows));
+        utils::replaceAll(str, "NUM_POINT_LIGHT_SHADOWS", std::to_string(counts.shadows));
+        utils::replaceAll(str, "NUM_CLIPPING_PLANES", std::to_string(counts.clippingPlanes));
+        utils::replaceAll(str, "UNION_CLIPPING_PLANES", std::to_string(counts.clippingPlanes - counts.clipIntersection));
+    }
+
+    // output, or nullopt when the passes throw
+    template<class Resolve, class Unroll>
+    std::optional<std::string> preprocess(const std::string& source, const Counts& counts, Resolve resolve, Unroll unroll) {
+
+        try {
+
+            auto str = resolve(source);
+            replaceNums(str, counts);
+
+            return unroll(str);
+
+        } catch (const std::exception&) {
+
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::string> referenceOutput(const std::string& source, const Counts& counts) {
+
+        return preprocess(source, counts, reference::resolveIncludes, reference::unrollLoops);
+    }
+
+    std::optional<std::string> output(const std::string& source, const Counts& counts) {
+
+        return preprocess(source, counts, gl::resolveIncludes, gl::unrollLoops);
+    }
+
+    constexpr int numFuzzedSources = 20000;
+
+    // pieces of unroll loops and includes, valid and broken, in random order
+    std::string fuzzedSource(std::mt19937& rng) {
+
+        static const char* pieces[]{
+                "#pragma unroll_loop_start", " ", "\n", "\t", "for", "(", "int", "i", "=", "0", "3", "12", ";", "<", "++", ")",
+                "{", "}", "#pragma unroll_loop_end", "[", "]", "[ i ]", "UNROLLED_LOOP_INDEX", "x", "ii",
+                "#include <common>", "#include  <x", "#include <>", " #include <packing>"};
+
+        std::string str;
+        if (rng() % 2) str = "#pragma unroll_loop_start\nfor ( int i = 0; i < 3; i ++ ) {";
+
+        const auto length = rng() % 40;
+        for (unsigned i = 0; i < length; i++) str += pieces[rng() % std::size(pieces)];
+
+        if (rng() % 2) str += "}\n#pragma unroll_loop_end";
+
+        return str;
+    }
+
+}// namespace
+
+int main() {
+
+    using Clock = std::chrono::steady_clock;
+
+    int numSources = 0;
+    int mismatches = 0;
+    std::chrono::duration<double, std::micro> referenceTime{}, time{};
+
+    for (const auto name : shaderNames) {
+
+        const auto& shader = shaders::ShaderLib::instance().get(name);
+
+        for (const auto& source : {shader.vertexShader, shader.fragmentShader}) {
+            for (const int lights : {0, 1, 3, 8}) {
+                for (const int clippingPlanes : {0, 2, 5}) {
+
+                    const Counts counts{lights, std::min(lights, 2), clippingPlanes, clippingPlanes / 2};
+
+                    const auto start = Clock::now();
+                    const auto expected = referenceOutput(source, counts);
+                    const auto middle = Clock::now();
+                    const auto actual = output(source, counts);
+
+                    referenceTime += middle - start;
+                    time += Clock::now() - middle;
+                    ++numSources;
+
+                    if (actual != expected) {
+
+                        ++mismatches;
+                        std::cout << "  mismatch: " << name << ", " << lights << " lights, " << clippingPlanes << " clipping planes" << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << numSources << " ShaderLib sources, " << mismatches << " mismatches, us per source: regex "
+              << referenceTime.count() / numSources << ", preprocessor " << time.count() / numSources << std::endl;
+
+    std::mt19937 rng(42);
+    int fuzzedMismatches = 0;
+
+    for (int i = 0; i < numFuzzedSources; i++) {
+
+        const auto source = fuzzedSource(rng);
+        const Counts counts{1, 0, 0, 0};
+
+        if (output(source, counts) != referenceOutput(source, counts) && fuzzedMismatches++ < 3) {
+
+            std::cout << "  mismatch: [" << source << "]" << std::endl;
+        }
+    }
+
+    std::cout << numFuzzedSources << " fuzzed sources, " << fuzzedMismatches << " mismatches" << std::endl;
+
+    return (mismatches + fuzzedMismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+
+#ifdef USE_BATCHING
+
+	mat4 batchingMatrix = getBatchingMatrix( batchId );
+
+#endif
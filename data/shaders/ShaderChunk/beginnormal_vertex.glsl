@@ -1,5 +1,14 @@
 
-vec3 objectNormal = vec3( normal );
+#ifdef USE_OCTAHEDRAL_NORMALS
+
+	// two component normals leave normal.z at zero
+	vec3 objectNormal = octahedronDecode( normal.xy );
+
+#else
+
+	vec3 objectNormal = vec3( normal );
+
+#endif
 
 #ifdef USE_TANGENT
 
@@ -130,3 +130,18 @@ vec2 equirectUv( in vec3 dir ) {
 
 }
 
+#ifdef USE_OCTAHEDRAL_NORMALS
+
+// inverse of the octahedral mapping written by BufferGeometryUtils' encodeNormalsOctahedral
+vec3 octahedronDecode( in vec2 f ) {
+
+	vec3 n = vec3( f.x, f.y, 1.0 - abs( f.x ) - abs( f.y ) );
+	float t = max( - n.z, 0.0 );
+	n.x += n.x >= 0.0 ? - t : t;
+	n.y += n.y >= 0.0 ? - t : t;
+
+	return normalize( n );
+
+}
+
+#endif
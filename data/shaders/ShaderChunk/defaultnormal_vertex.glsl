@@ -1,6 +1,18 @@
 
 vec3 transformedNormal = objectNormal;
 
+#ifdef USE_BATCHING
+
+	// as with instancing, shear transforms in the batching matrix are not supported
+
+	mat3 bm = mat3( batchingMatrix );
+
+	transformedNormal /= vec3( dot( bm[ 0 ], bm[ 0 ] ), dot( bm[ 1 ], bm[ 1 ] ), dot( bm[ 2 ], bm[ 2 ] ) );
+
+	transformedNormal = bm * transformedNormal;
+
+#endif
+
 #ifdef USE_INSTANCING
 
 	// this is in lieu of a per-instance normal-matrix
@@ -24,7 +36,15 @@ transformedNormal = normalMatrix * transformedNormal;
 
 #ifdef USE_TANGENT
 
-	vec3 transformedTangent = ( modelViewMatrix * vec4( objectTangent, 0.0 ) ).xyz;
+	#ifdef USE_BATCHING
+
+		vec3 transformedTangent = ( modelViewMatrix * batchingMatrix * vec4( objectTangent, 0.0 ) ).xyz;
+
+	#else
+
+		vec3 transformedTangent = ( modelViewMatrix * vec4( objectTangent, 0.0 ) ).xyz;
+
+	#endif
 
 	#ifdef FLIP_SIDED
 
@@ -1,19 +1,33 @@
 
 #ifdef USE_FOG
 
-	uniform vec3 fogColor;
-	varying float fogDepth;
-
-	#ifdef FOG_EXP2
+	#ifdef USE_UNIFORM_BLOCKS
 
-		uniform float fogDensity;
+		layout( std140 ) uniform threeFog {
+			vec3 fogColor;
+			float fogDensity;
+			float fogNear;
+			float fogFar;
+		};
 
 	#else
 
-		uniform float fogNear;
-		uniform float fogFar;
+		uniform vec3 fogColor;
+
+		#ifdef FOG_EXP2
+
+			uniform float fogDensity;
+
+		#else
+
+			uniform float fogNear;
+			uniform float fogFar;
+
+		#endif
 
 	#endif
 
+	varying float fogDepth;
+
 #endif
 
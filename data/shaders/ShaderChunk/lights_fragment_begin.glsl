@@ -80,6 +80,20 @@ IncidentLight directLight;
 
 #endif
 
+#if defined( USE_CLUSTERED_LIGHTS ) && defined( RE_Direct )
+
+	vec2 clusterRange = getClusterRange( geometry.position );
+
+	for ( int i = 0; i < int( clusterRange.y ); i ++ ) {
+
+		getClusteredDirectLightIrradiance( getClusterLightIndex( int( clusterRange.x ) + i ), geometry, directLight );
+
+		RE_Direct( directLight, geometry, material, reflectedLight );
+
+	}
+
+#endif
+
 #if ( NUM_DIR_LIGHTS > 0 ) && defined( RE_Direct )
 
 	DirectionalLight directionalLight;
@@ -96,7 +110,7 @@ IncidentLight directLight;
 
 		#if defined( USE_SHADOWMAP ) && ( UNROLLED_LOOP_INDEX < NUM_DIR_LIGHT_SHADOWS )
 		directionalLightShadow = directionalLightShadows[ i ];
-		directLight.color *= all( bvec2( directLight.visible, receiveShadow ) ) ? getShadow( directionalShadowMap[ i ], directionalLightShadow.shadowMapSize, directionalLightShadow.shadowBias, directionalLightShadow.shadowRadius, vDirectionalShadowCoord[ i ] ) : 1.0;
+		directLight.color *= all( bvec2( directLight.visible, receiveShadow ) ) ? getShadow( directionalShadowMap[ i ], directionalLightShadow.shadowMapSize, directionalLightShadow.shadowBias, directionalLightShadow.shadowRadius, getDirectionalShadowCoord( UNROLLED_LOOP_INDEX, directionalLightShadow, vDirectionalShadowCoord[ i ] ) ) : 1.0;
 		#endif
 
 		RE_Direct( directLight, geometry, material, reflectedLight );
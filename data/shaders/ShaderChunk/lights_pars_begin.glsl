@@ -1,7 +1,93 @@
 
 uniform bool receiveShadow;
-uniform vec3 ambientLightColor;
-uniform vec3 lightProbe[ 9 ];
+
+#if NUM_DIR_LIGHTS > 0
+
+	struct DirectionalLight {
+		vec3 direction;
+		vec3 color;
+	};
+
+#endif
+
+#if NUM_POINT_LIGHTS > 0
+
+	struct PointLight {
+		vec3 position;
+		vec3 color;
+		float distance;
+		float decay;
+	};
+
+#endif
+
+#if NUM_SPOT_LIGHTS > 0
+
+	struct SpotLight {
+		vec3 position;
+		vec3 direction;
+		vec3 color;
+		float distance;
+		float decay;
+		float coneCos;
+		float penumbraCos;
+	};
+
+#endif
+
+#if NUM_HEMI_LIGHTS > 0
+
+	struct HemisphereLight {
+		vec3 direction;
+		vec3 skyColor;
+		vec3 groundColor;
+	};
+
+#endif
+
+#ifdef USE_UNIFORM_BLOCKS
+
+	// std140, filled once per frame by GLUniformBlocks
+	#ifdef USE_CLUSTERED_LIGHTS
+	layout( std140 ) uniform threeClusteredLights {
+	#else
+	layout( std140 ) uniform threeLights {
+	#endif
+		vec3 ambientLightColor;
+		vec3 lightProbe[ 9 ];
+		#if NUM_DIR_LIGHTS > 0
+			DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
+		#endif
+		#if NUM_POINT_LIGHTS > 0
+			PointLight pointLights[ NUM_POINT_LIGHTS ];
+		#endif
+		#if NUM_SPOT_LIGHTS > 0
+			SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+		#endif
+		#if NUM_HEMI_LIGHTS > 0
+			HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
+		#endif
+	};
+
+#else
+
+	uniform vec3 ambientLightColor;
+	uniform vec3 lightProbe[ 9 ];
+
+	#if NUM_DIR_LIGHTS > 0
+		uniform DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
+	#endif
+	#if NUM_POINT_LIGHTS > 0
+		uniform PointLight pointLights[ NUM_POINT_LIGHTS ];
+	#endif
+	#if NUM_SPOT_LIGHTS > 0
+		uniform SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+	#endif
+	#if NUM_HEMI_LIGHTS > 0
+		uniform HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
+	#endif
+
+#endif
 
 // get the irradiance (radiance convolved with cosine lobe) at the point 'normal' on the unit sphere
 // source: https://graphics.stanford.edu/papers/envmap/envmap.pdf
@@ -56,13 +142,6 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 #if NUM_DIR_LIGHTS > 0
 
-	struct DirectionalLight {
-		vec3 direction;
-		vec3 color;
-	};
-
-	uniform DirectionalLight directionalLights[ NUM_DIR_LIGHTS ];
-
 	void getDirectionalDirectLightIrradiance( const in DirectionalLight directionalLight, const in GeometricContext geometry, out IncidentLight directLight ) {
 
 		directLight.color = directionalLight.color;
@@ -76,15 +155,6 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 #if NUM_POINT_LIGHTS > 0
 
-	struct PointLight {
-		vec3 position;
-		vec3 color;
-		float distance;
-		float decay;
-	};
-
-	uniform PointLight pointLights[ NUM_POINT_LIGHTS ];
-
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getPointDirectLightIrradiance( const in PointLight pointLight, const in GeometricContext geometry, out IncidentLight directLight ) {
 
@@ -104,18 +174,6 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 #if NUM_SPOT_LIGHTS > 0
 
-	struct SpotLight {
-		vec3 position;
-		vec3 direction;
-		vec3 color;
-		float distance;
-		float decay;
-		float coneCos;
-		float penumbraCos;
-	};
-
-	uniform SpotLight spotLights[ NUM_SPOT_LIGHTS ];
-
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getSpotDirectLightIrradiance( const in SpotLight spotLight, const in GeometricContext geometry, out IncidentLight directLight ) {
 
@@ -144,6 +202,74 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 #endif
 
 
+#ifdef USE_CLUSTERED_LIGHTS
+
+	// written by GLClusteredLights: 4 texels per light, and one (offset, count) texel per cluster into the packed light indices
+	uniform highp sampler2D clusterLights;
+	uniform highp sampler2D clusterGrid;
+	uniform highp sampler2D clusterIndices;
+
+	uniform mat4 clusterProjection;
+	uniform vec4 clusterSize; // tiles x, tiles y, depth slices, logarithmic slices
+	uniform vec2 clusterSlicing;
+
+	vec2 getClusterRange( const in vec3 viewPosition ) {
+
+		vec4 clip = clusterProjection * vec4( viewPosition, 1.0 );
+		ivec2 tile = clamp( ivec2( ( clip.xy / clip.w * 0.5 + 0.5 ) * clusterSize.xy ), ivec2( 0 ), ivec2( clusterSize.xy ) - 1 );
+
+		float depth = - viewPosition.z;
+		float slice = ( clusterSize.w > 0.5 ? log( max( depth, 1e-6 ) ) : depth ) * clusterSlicing.x + clusterSlicing.y;
+
+		if ( slice < 0.0 || slice >= clusterSize.z ) return vec2( 0.0 );
+
+		return texelFetch( clusterGrid, ivec2( tile.x + tile.y * int( clusterSize.x ), int( slice ) ), 0 ).xy;
+
+	}
+
+	int getClusterLightIndex( const in int i ) {
+
+		int texel = i / 4;
+
+		return int( texelFetch( clusterIndices, ivec2( texel % 1024, texel / 1024 ), 0 )[ i - texel * 4 ] );
+
+	}
+
+	// point lights are stored as spot lights that let every direction through
+	void getClusteredDirectLightIrradiance( const in int index, const in GeometricContext geometry, out IncidentLight directLight ) {
+
+		ivec2 texel = ivec2( ( index % 64 ) * 4, index / 64 );
+
+		vec4 positionDistance = texelFetch( clusterLights, texel, 0 );
+		vec4 colorDecay = texelFetch( clusterLights, texel + ivec2( 1, 0 ), 0 );
+		vec4 directionConeCos = texelFetch( clusterLights, texel + ivec2( 2, 0 ), 0 );
+		float penumbraCos = texelFetch( clusterLights, texel + ivec2( 3, 0 ), 0 ).x;
+
+		vec3 lVector = positionDistance.xyz - geometry.position;
+		directLight.direction = normalize( lVector );
+
+		float angleCos = dot( directLight.direction, directionConeCos.xyz );
+
+		if ( angleCos > directionConeCos.w ) {
+
+			float spotEffect = smoothstep( directionConeCos.w, penumbraCos, angleCos );
+
+			directLight.color = colorDecay.rgb;
+			directLight.color *= spotEffect * punctualLightIntensityToIrradianceFactor( length( lVector ), positionDistance.w, colorDecay.w );
+			directLight.visible = ( directLight.color != vec3( 0.0 ) );
+
+		} else {
+
+			directLight.color = vec3( 0.0 );
+			directLight.visible = false;
+
+		}
+
+	}
+
+#endif
+
+
 #if NUM_RECT_AREA_LIGHTS > 0
 
 	struct RectAreaLight {
@@ -165,14 +291,6 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 #if NUM_HEMI_LIGHTS > 0
 
-	struct HemisphereLight {
-		vec3 direction;
-		vec3 skyColor;
-		vec3 groundColor;
-	};
-
-	uniform HemisphereLight hemisphereLights[ NUM_HEMI_LIGHTS ];
-
 	vec3 getHemisphereLightIrradiance( const in HemisphereLight hemiLight, const in GeometricContext geometry ) {
 
 		float dotNL = dot( geometry.normal, hemiLight.direction );
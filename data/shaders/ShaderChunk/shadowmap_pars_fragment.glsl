@@ -11,10 +11,44 @@
 			float shadowNormalBias;
 			float shadowRadius;
 			vec2 shadowMapSize;
+			int shadowCascades;
 		};
 
 		uniform DirectionalLightShadow directionalLightShadows[ NUM_DIR_LIGHT_SHADOWS ];
 
+		#define MAX_DIR_LIGHT_SHADOW_CASCADES 4
+
+		// cascades sit side by side in the shadow map, and shadowCoord is in light view space when there are several
+		uniform mat4 directionalShadowCascadeMatrix[ NUM_DIR_LIGHT_SHADOWS * MAX_DIR_LIGHT_SHADOW_CASCADES ];
+
+		vec4 getDirectionalShadowCoord( const in int light, const in DirectionalLightShadow shadow, const in vec4 shadowCoord ) {
+
+			if ( shadow.shadowCascades < 2 ) return shadowCoord;
+
+			float cascades = float( shadow.shadowCascades );
+
+			// keeps the filter footprint inside the cascade
+			vec2 margin = 2.0 * vec2( cascades, 1.0 ) / shadow.shadowMapSize;
+
+			for ( int i = 0; i < MAX_DIR_LIGHT_SHADOW_CASCADES; i ++ ) {
+
+				if ( i >= shadow.shadowCascades ) break;
+
+				vec3 coord = ( directionalShadowCascadeMatrix[ light * MAX_DIR_LIGHT_SHADOW_CASCADES + i ] * shadowCoord ).xyz;
+
+				if ( all( greaterThanEqual( coord.xy, margin ) ) && all( lessThanEqual( coord.xy, 1.0 - margin ) ) ) {
+
+					return vec4( ( coord.x + float( i ) ) / cascades, coord.y, coord.z, 1.0 );
+
+				}
+
+			}
+
+			// outside of all cascades, unshadowed
+			return vec4( 2.0, 2.0, 0.0, 1.0 );
+
+		}
+
 	#endif
 
 	#if NUM_SPOT_LIGHT_SHADOWS > 0
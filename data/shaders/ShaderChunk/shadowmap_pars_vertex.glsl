@@ -11,6 +11,7 @@
 			float shadowNormalBias;
 			float shadowRadius;
 			vec2 shadowMapSize;
+			int shadowCascades;
 		};
 
 		uniform DirectionalLightShadow directionalLightShadows[ NUM_DIR_LIGHT_SHADOWS ];
@@ -4,6 +4,7 @@
 #include <displacementmap_pars_vertex>
 #include <morphtarget_pars_vertex>
 #include <skinning_pars_vertex>
+#include <batching_pars_vertex>
 #include <logdepthbuf_pars_vertex>
 #include <clipping_planes_pars_vertex>
 
@@ -17,6 +18,7 @@ void main() {
 	#include <uv_vertex>
 
 	#include <skinbase_vertex>
+	#include <batching_vertex>
 
 	#ifdef USE_DISPLACEMENTMAP
 
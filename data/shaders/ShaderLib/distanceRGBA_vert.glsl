@@ -8,6 +8,7 @@ varying vec3 vWorldPosition;
 #include <displacementmap_pars_vertex>
 #include <morphtarget_pars_vertex>
 #include <skinning_pars_vertex>
+#include <batching_pars_vertex>
 #include <clipping_planes_pars_vertex>
 
 void main() {
@@ -15,6 +16,7 @@ void main() {
 	#include <uv_vertex>
 
 	#include <skinbase_vertex>
+	#include <batching_vertex>
 
 	#ifdef USE_DISPLACEMENTMAP
 
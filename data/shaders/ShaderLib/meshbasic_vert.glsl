@@ -7,6 +7,7 @@
 #include <fog_pars_vertex>
 #include <morphtarget_pars_vertex>
 #include <skinning_pars_vertex>
+#include <batching_pars_vertex>
 #include <logdepthbuf_pars_vertex>
 #include <clipping_planes_pars_vertex>
 
@@ -16,6 +17,7 @@ void main() {
 	#include <uv2_vertex>
 	#include <color_vertex>
 	#include <skinbase_vertex>
+	#include <batching_vertex>
 
 	#ifdef USE_ENVMAP
 
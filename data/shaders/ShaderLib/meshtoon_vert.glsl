@@ -17,6 +17,7 @@ varying vec3 vViewPosition;
 #include <fog_pars_vertex>
 #include <morphtarget_pars_vertex>
 #include <skinning_pars_vertex>
+#include <batching_pars_vertex>
 #include <shadowmap_pars_vertex>
 #include <logdepthbuf_pars_vertex>
 #include <clipping_planes_pars_vertex>
@@ -30,6 +31,7 @@ void main() {
 	#include <beginnormal_vertex>
 	#include <morphnormal_vertex>
 	#include <skinbase_vertex>
+	#include <batching_vertex>
 	#include <skinnormal_vertex>
 	#include <defaultnormal_vertex>
 
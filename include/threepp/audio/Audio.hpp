@@ -22,6 +22,11 @@ namespace threepp {
 
         void updateMatrixWorld(bool force) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         ~AudioListener() override;
 
     private:
@@ -66,6 +71,11 @@ namespace threepp {
         PositionalAudio(AudioListener& ctx, const std::filesystem::path& file);
 
         void updateMatrixWorld(bool force) override;
+
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
     };
 
 }// namespace threepp
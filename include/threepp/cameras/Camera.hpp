@@ -38,7 +38,11 @@ namespace threepp {
         // The inverse of projectionMatrix.
         Matrix4 projectionMatrixInverse;
 
-        Camera() = default;
+        Camera() {
+
+            addKind(this);
+        }
+
         Camera(float near, float far);
 
         // Copies the world space direction in which the camera is looking into target.
@@ -47,6 +51,11 @@ namespace threepp {
 
         void updateMatrixWorld(bool force = false) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         void updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) override;
 
         virtual void updateProjectionMatrix() {};
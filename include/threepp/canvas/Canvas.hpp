@@ -72,6 +72,9 @@ namespace threepp {
 
             Parameters& resizable(bool flag);
 
+            // A hidden window still has a working context, e.g. for rendering offscreen or in headless CI.
+            Parameters& visible(bool flag);
+
             Parameters& favicon(const std::filesystem::path& path);
 
             Parameters& exitOnKeyEscape(bool flag);
@@ -82,6 +85,7 @@ namespace threepp {
             std::string title_{"threepp"};
             bool vsync_{true};
             bool resizable_{true};
+            bool visible_{true};
             bool exitOnKeyEscape_{true};
             std::optional<std::filesystem::path> favicon_;
 
@@ -151,9 +151,24 @@ namespace threepp {
         RG,
         RGInteger,
         RGBInteger,
-        RGBAInteger
+        RGBAInteger,
+
+        // block compressed, see CompressedTexture
+        RGB_S3TC_DXT1,  // BC1
+        RGBA_S3TC_DXT1, // BC1 with 1-bit alpha
+        RGBA_S3TC_DXT5, // BC3
+        RED_RGTC1,      // BC4
+        RED_GREEN_RGTC2,// BC5
+        RGBA_BPTC,      // BC7
+        RGB_ETC2,
+        RGBA_ETC2_EAC
     };
 
+    constexpr bool isCompressed(Format format) {
+
+        return format >= Format::RGB_S3TC_DXT1;
+    }
+
     enum class Loop {
         Once = 2200,
         Repeat = 2201,
@@ -5,6 +5,7 @@
 
 #include "threepp/math/Box3.hpp"
 #include "threepp/math/Color.hpp"
+#include "threepp/math/HalfFloat.hpp"
 #include "threepp/math/Vector2.hpp"
 #include "threepp/math/Vector3.hpp"
 #include "threepp/math/Vector4.hpp"
@@ -12,6 +13,7 @@
 #include "threepp/constants.hpp"
 #include "threepp/core/misc.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -25,8 +27,15 @@ namespace threepp {
     public:
         UpdateRange updateRange{0, -1};
 
+        // Element ranges to upload on the next update, merged where they touch. Cleared once uploaded.
+        // When empty (and updateRange.count is -1) the whole array is uploaded.
+        std::vector<UpdateRange> updateRanges;
+
         unsigned int version = 0;
 
+        // used by the renderer, see RendererHandle
+        RendererHandles rendererHandles;
+
         [[nodiscard]] virtual int count() const = 0;
 
         [[nodiscard]] int itemSize() const {
@@ -39,6 +48,12 @@ namespace threepp {
             return normalized_;
         }
 
+        // Number of instances that share each item, 0 for per vertex attributes. See InstancedBufferAttribute.
+        [[nodiscard]] int meshPerAttribute() const {
+
+            return meshPerAttribute_;
+        }
+
         [[nodiscard]] DrawUsage getUsage() const {
 
             return usage_;
@@ -54,6 +69,16 @@ namespace threepp {
             this->usage_ = value;
         }
 
+        void addUpdateRange(int start, int count) {
+
+            updateRanges.emplace_back(UpdateRange{start, count});
+        }
+
+        void clearUpdateRanges() {
+
+            updateRanges.clear();
+        }
+
         template<class T>
         TypedBufferAttribute<T>* typed() {
 
@@ -65,6 +90,7 @@ namespace threepp {
     protected:
         int itemSize_{};
         bool normalized_{};
+        int meshPerAttribute_{};
 
         DrawUsage usage_{DrawUsage::Static};
 
@@ -77,6 +103,7 @@ namespace threepp {
 
             this->itemSize_ = source.itemSize_;
             this->normalized_ = source.normalized_;
+            this->meshPerAttribute_ = source.meshPerAttribute_;
 
             this->usage_ = source.usage_;
         }
@@ -425,6 +452,13 @@ namespace threepp {
     typedef TypedBufferAttribute<unsigned int> IntBufferAttribute;
     typedef TypedBufferAttribute<float> FloatBufferAttribute;
 
+    // Compact vertex formats. Integer attributes are read as floats by shaders, divided by the type's maximum when normalized.
+    typedef TypedBufferAttribute<int8_t> Int8BufferAttribute;
+    typedef TypedBufferAttribute<uint8_t> Uint8BufferAttribute;
+    typedef TypedBufferAttribute<int16_t> Int16BufferAttribute;
+    typedef TypedBufferAttribute<uint16_t> Uint16BufferAttribute;
+    typedef TypedBufferAttribute<HalfFloat> Float16BufferAttribute;
+
 
 }// namespace threepp
 
@@ -9,6 +9,7 @@
 #include "threepp/core/EventDispatcher.hpp"
 
 #include "threepp/core/BufferAttribute.hpp"
+#include "threepp/core/IndexBufferAttribute.hpp"
 
 #include <optional>
 #include <unordered_map>
@@ -33,6 +34,9 @@ namespace threepp {
 
         DrawRange drawRange{0, std::numeric_limits<int>::max() / 2};
 
+        // used by the renderer, see RendererHandle
+        RendererHandles rendererHandles;
+
         BufferGeometry();
 
         BufferGeometry(const BufferGeometry&) = delete;
@@ -42,16 +46,20 @@ namespace threepp {
 
         [[nodiscard]] virtual std::string type() const;
 
+        // Whether this is an InstancedBufferGeometry, so that draws can tell without a dynamic_cast.
+        [[nodiscard]] bool isInstanced() const;
+
         [[nodiscard]] bool hasIndex() const;
 
-        IntBufferAttribute* getIndex();
+        IndexBufferAttribute* getIndex();
 
-        [[nodiscard]] const IntBufferAttribute* getIndex() const;
+        [[nodiscard]] const IndexBufferAttribute* getIndex() const;
 
+        // Indices are stored with 16 bits when all of them fit, see IndexBufferAttribute.
         template<class ArrayLike>
         BufferGeometry& setIndex(const ArrayLike& index) {
 
-            this->index_ = IntBufferAttribute::create(index, 1);
+            this->index_ = IndexBufferAttribute::create(index);
 
             return *this;
         }
@@ -86,6 +94,9 @@ namespace threepp {
 
         [[nodiscard]] bool hasAttribute(const std::string& name) const;
 
+        // Incremented whenever an attribute is set or deleted.
+        [[nodiscard]] unsigned int attributesVersion() const;
+
         [[nodiscard]] const std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribute>>>& getMorphAttributes() const;
 
         void addGroup(int start, int count, unsigned int materialIndex = 0);
@@ -134,9 +145,13 @@ namespace threepp {
 
         static std::shared_ptr<BufferGeometry> create();
 
+    protected:
+        bool instanced_ = false;
+
     private:
         bool disposed_ = false;
-        std::unique_ptr<IntBufferAttribute> index_;
+        unsigned int attributesVersion_ = 0;
+        std::unique_ptr<IndexBufferAttribute> index_;
         std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> attributes_;
         std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribute>>> morphAttributes_;
 
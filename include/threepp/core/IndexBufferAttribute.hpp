@@ -0,0 +1,117 @@
+
+#ifndef THREEPP_INDEXBUFFERATTRIBUTE_HPP
+#define THREEPP_INDEXBUFFERATTRIBUTE_HPP
+
+#include "threepp/core/BufferAttribute.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+namespace threepp {
+
+    // Element indices of a BufferGeometry.
+    // Stored with 16 bits while every index fits, which halves index memory and bandwidth for most meshes,
+    // and widened to 32 bits on demand.
+    class IndexBufferAttribute: public BufferAttribute {
+
+    public:
+        // 0xFFFF is kept free, as it is the primitive restart index of 16 bit index buffers
+        static constexpr unsigned int maxUint16Index = 0xFFFE;
+
+        [[nodiscard]] int count() const override {
+
+            return static_cast<int>(wide_ ? array32_.size() : array16_.size());
+        }
+
+        [[nodiscard]] bool is16Bit() const {
+
+            return !wide_;
+        }
+
+        [[nodiscard]] int bytesPerElement() const {
+
+            return wide_ ? sizeof(uint32_t) : sizeof(uint16_t);
+        }
+
+        // Raw storage, count() elements of bytesPerElement() bytes each.
+        [[nodiscard]] const void* data() const {
+
+            return wide_ ? static_cast<const void*>(array32_.data()) : static_cast<const void*>(array16_.data());
+        }
+
+        [[nodiscard]] unsigned int getX(size_t index) const {
+
+            return wide_ ? array32_[index] : array16_[index];
+        }
+
+        IndexBufferAttribute& setX(size_t index, unsigned int value) {
+
+            if (!wide_ && value > maxUint16Index) widen();
+
+            if (wide_) {
+
+                array32_[index] = value;
+
+            } else {
+
+                array16_[index] = static_cast<uint16_t>(value);
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] std::unique_ptr<IndexBufferAttribute> clone() const {
+
+            return std::unique_ptr<IndexBufferAttribute>(new IndexBufferAttribute(*this));
+        }
+
+        template<std::ranges::range Range>
+        static std::unique_ptr<IndexBufferAttribute> create(const Range& range) {
+
+            auto attribute = std::unique_ptr<IndexBufferAttribute>(new IndexBufferAttribute());
+
+            const auto fits16 = std::ranges::all_of(range, [](auto i) { return static_cast<unsigned int>(i) <= maxUint16Index; });
+            attribute->wide_ = !fits16;
+
+            if (fits16) {
+
+                attribute->array16_.reserve(std::ranges::size(range));
+                for (auto i : range) attribute->array16_.emplace_back(static_cast<uint16_t>(i));
+
+            } else {
+
+                attribute->array32_.reserve(std::ranges::size(range));
+                for (auto i : range) attribute->array32_.emplace_back(static_cast<uint32_t>(i));
+            }
+
+            return attribute;
+        }
+
+    private:
+        bool wide_ = false;
+        std::vector<uint16_t> array16_;
+        std::vector<uint32_t> array32_;
+
+        IndexBufferAttribute(): BufferAttribute(1, false) {}
+
+        IndexBufferAttribute(const IndexBufferAttribute& source)
+            : BufferAttribute(1, false), wide_(source.wide_), array16_(source.array16_), array32_(source.array32_) {
+
+            copy(source);
+        }
+
+        void widen() {
+
+            array32_.assign(array16_.begin(), array16_.end());
+            array16_.clear();
+            array16_.shrink_to_fit();
+            wide_ = true;
+        }
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_INDEXBUFFERATTRIBUTE_HPP
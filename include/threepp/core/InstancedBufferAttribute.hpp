@@ -0,0 +1,51 @@
+// https://github.com/mrdoob/three.js/blob/r129/src/core/InstancedBufferAttribute.js
+
+#ifndef THREEPP_INSTANCEDBUFFERATTRIBUTE_HPP
+#define THREEPP_INSTANCEDBUFFERATTRIBUTE_HPP
+
+#include "threepp/core/BufferAttribute.hpp"
+
+namespace threepp {
+
+    // Attribute with one item per instance (or per meshPerAttribute instances) rather than per vertex.
+    // Used with InstancedBufferGeometry, and read by shaders like any other attribute.
+    template<class T>
+    class InstancedBufferAttribute: public TypedBufferAttribute<T> {
+
+    public:
+        void setMeshPerAttribute(int value) {
+
+            this->meshPerAttribute_ = value;
+        }
+
+        static std::unique_ptr<InstancedBufferAttribute> create(std::initializer_list<T>&& array, int itemSize, bool normalized = false, int meshPerAttribute = 1) {
+
+            return create(std::vector<T>{array.begin(), array.end()}, itemSize, normalized, meshPerAttribute);
+        }
+
+        template<std::ranges::range Range>
+        static std::unique_ptr<InstancedBufferAttribute> create(const Range& range, int itemSize, bool normalized = false, int meshPerAttribute = 1) {
+
+            return std::unique_ptr<InstancedBufferAttribute>(new InstancedBufferAttribute({std::ranges::begin(range), std::ranges::end(range)}, itemSize, normalized, meshPerAttribute));
+        }
+
+    protected:
+        InstancedBufferAttribute(const std::vector<T>& array, int itemSize, bool normalized, int meshPerAttribute)
+            : TypedBufferAttribute<T>(array, itemSize, normalized) {
+
+            this->meshPerAttribute_ = meshPerAttribute;
+        }
+    };
+
+    typedef InstancedBufferAttribute<unsigned int> IntInstancedBufferAttribute;
+    typedef InstancedBufferAttribute<float> FloatInstancedBufferAttribute;
+
+    typedef InstancedBufferAttribute<int8_t> Int8InstancedBufferAttribute;
+    typedef InstancedBufferAttribute<uint8_t> Uint8InstancedBufferAttribute;
+    typedef InstancedBufferAttribute<int16_t> Int16InstancedBufferAttribute;
+    typedef InstancedBufferAttribute<uint16_t> Uint16InstancedBufferAttribute;
+    typedef InstancedBufferAttribute<HalfFloat> Float16InstancedBufferAttribute;
+
+}// namespace threepp
+
+#endif//THREEPP_INSTANCEDBUFFERATTRIBUTE_HPP
@@ -0,0 +1,45 @@
+// https://github.com/mrdoob/three.js/blob/r129/src/core/InstancedBufferGeometry.js
+
+#ifndef THREEPP_INSTANCEDBUFFERGEOMETRY_HPP
+#define THREEPP_INSTANCEDBUFFERGEOMETRY_HPP
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/core/InstancedBufferAttribute.hpp"
+
+#include <optional>
+
+namespace threepp {
+
+    // Geometry drawn instanceCount times in a single draw call.
+    // Per instance data goes into InstancedBufferAttributes, next to the per vertex attributes.
+    class InstancedBufferGeometry: public BufferGeometry {
+
+    public:
+        // Drawn instances, limited to what the per instance attributes hold data for.
+        // 0 draws all of those, and nothing when there are no per instance attributes.
+        int instanceCount = 0;
+
+        InstancedBufferGeometry();
+
+        [[nodiscard]] std::string type() const override;
+
+        // Instances that all per instance attributes hold data for, or instanceCount when there are none.
+        // Recounted when attributes are set or deleted, so set an attribute again after resizing it or changing its meshPerAttribute.
+        [[nodiscard]] int maxInstanceCount() const;
+
+        // The instances a draw of this geometry covers, see instanceCount.
+        [[nodiscard]] int drawInstanceCount() const;
+
+        void copy(const InstancedBufferGeometry& source);
+
+        static std::shared_ptr<InstancedBufferGeometry> create();
+
+    private:
+        // capacity of the per instance attributes (none without any), at attributesVersion
+        mutable std::optional<int> attributeInstanceCount_;
+        mutable std::optional<unsigned int> countedVersion_;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_INSTANCEDBUFFERGEOMETRY_HPP
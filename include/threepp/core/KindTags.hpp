@@ -0,0 +1,70 @@
+
+#ifndef THREEPP_KINDTAGS_HPP
+#define THREEPP_KINDTAGS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace threepp {
+
+    // Kind of a class that registers itself in KindTags, specialised next to the list of kinds.
+    template<class T>
+    struct KindOf {};
+
+    // The classes an object derives from, out of a fixed set of kinds (much like the isMesh, isLight, ... flags of three.js).
+    // Each kind is recorded together with the offset of its subobject, so testing and casting to these classes
+    // needs no dynamic_cast, which is slow through the virtual bases of objects and materials.
+    // Offsets are relative to the tags themselves, so they stay valid when copied into an object of the same class.
+    // last is the highest kind, every kind must be declared before it.
+    template<class Kind, Kind last>
+    class KindTags {
+
+    public:
+        template<Kind kind>
+        [[nodiscard]] bool has() const {
+
+            return mask_ & bit(kind);
+        }
+
+        template<Kind kind>
+        [[nodiscard]] void* get() const {
+
+            if (!has<kind>()) return nullptr;
+
+            // through an integer, as the subobject lies outside of the tags as far as the compiler can tell
+            // (pointer arithmetic on this trips -Warray-bounds once inlined into callers)
+            return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(this) + static_cast<intptr_t>(offsets_[index(kind)]));
+        }
+
+        template<Kind kind>
+        void add(void* self) {
+
+            static_assert(kind <= last, "Kind declared after the last kind of its KindTags");
+
+            offsets_[index(kind)] = static_cast<int32_t>(static_cast<char*>(self) - reinterpret_cast<char*>(this));
+            mask_ |= bit(kind);
+        }
+
+    private:
+        static constexpr size_t numKinds = static_cast<size_t>(last) + 1;
+        static_assert(numKinds <= 64, "The kinds must fit in the mask");
+
+        uint64_t mask_ = 0;
+        std::array<int32_t, numKinds> offsets_{};
+
+        static constexpr size_t index(Kind kind) {
+
+            return static_cast<size_t>(kind);
+        }
+
+        static constexpr uint64_t bit(Kind kind) {
+
+            return uint64_t{1} << index(kind);
+        }
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_KINDTAGS_HPP
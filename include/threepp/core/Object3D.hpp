@@ -10,6 +10,7 @@
 #include "threepp/math/Vector3.hpp"
 
 #include "threepp/core/EventDispatcher.hpp"
+#include "threepp/core/KindTags.hpp"
 #include "threepp/core/Layers.hpp"
 
 #include "misc.hpp"
@@ -18,6 +19,9 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 
 namespace threepp {
 
@@ -29,6 +33,174 @@ namespace threepp {
 
     typedef std::function<void(void*, Object3D*, Camera*, BufferGeometry*, Material*, std::optional<GeometryGroup>)> RenderCallback;
 
+    // Arbitrary data attached to an Object3D. Behaves like the underlying map, but storage is only allocated once something is stored.
+    class UserData {
+
+    public:
+        using Map = std::unordered_map<std::string, std::any>;
+
+        UserData() = default;
+
+        UserData(const UserData& other)
+            : map_(other.map_ ? std::make_unique<Map>(*other.map_) : nullptr) {}
+
+        UserData& operator=(const UserData& other) {
+
+            map_ = other.map_ ? std::make_unique<Map>(*other.map_) : nullptr;
+
+            return *this;
+        }
+
+        UserData(UserData&&) noexcept = default;
+        UserData& operator=(UserData&&) noexcept = default;
+
+        std::any& operator[](const std::string& key) {
+
+            if (!map_) map_ = std::make_unique<Map>();
+
+            return (*map_)[key];
+        }
+
+        std::any& at(const std::string& key) {
+
+            if (!map_) throw std::out_of_range("UserData has no key " + key);
+
+            return map_->at(key);
+        }
+
+        [[nodiscard]] const std::any& at(const std::string& key) const {
+
+            if (!map_) throw std::out_of_range("UserData has no key " + key);
+
+            return map_->at(key);
+        }
+
+        [[nodiscard]] bool contains(const std::string& key) const {
+
+            return map_ && map_->contains(key);
+        }
+
+        size_t erase(const std::string& key) {
+
+            return map_ ? map_->erase(key) : 0;
+        }
+
+        void clear() {
+
+            map_.reset();
+        }
+
+        [[nodiscard]] bool empty() const {
+
+            return !map_ || map_->empty();
+        }
+
+        [[nodiscard]] size_t size() const {
+
+            return map_ ? map_->size() : 0;
+        }
+
+        [[nodiscard]] Map::const_iterator begin() const {
+
+            return map_ ? map_->cbegin() : emptyMap().cbegin();
+        }
+
+        [[nodiscard]] Map::const_iterator end() const {
+
+            return map_ ? map_->cend() : emptyMap().cend();
+        }
+
+    private:
+        std::unique_ptr<Map> map_;
+
+        static const Map& emptyMap() {
+
+            static const Map empty;
+            return empty;
+        }
+    };
+
+    // Object classes that is<T>() and as<T>() resolve without dynamic_cast, see KindTags.
+    enum class ObjectKind {
+        Mesh,
+        InstancedMesh,
+        BatchedMesh,
+        SkinnedMesh,
+        Line,
+        LineSegments,
+        LineLoop,
+        Points,
+        Sprite,
+        LOD,
+        Group,
+        Scene,
+        Bone,
+        Light,
+        AmbientLight,
+        DirectionalLight,
+        PointLight,
+        SpotLight,
+        HemisphereLight,
+        LightProbe,
+        Camera,
+        PerspectiveCamera,
+        OrthographicCamera,
+        ObjectWithMaterials,
+        ObjectWithMorphTargetInfluences// last, see kinds_
+    };
+
+    class Mesh;
+    class InstancedMesh;
+    class BatchedMesh;
+    class SkinnedMesh;
+    class Line;
+    class LineSegments;
+    class LineLoop;
+    class Points;
+    class Sprite;
+    class LOD;
+    class Group;
+    class Scene;
+    class Bone;
+    class Light;
+    class AmbientLight;
+    class DirectionalLight;
+    class PointLight;
+    class SpotLight;
+    class HemisphereLight;
+    class LightProbe;
+    class Camera;
+    class PerspectiveCamera;
+    class OrthographicCamera;
+    class ObjectWithMaterials;
+    class ObjectWithMorphTargetInfluences;
+
+    template<> struct KindOf<Mesh>: std::integral_constant<ObjectKind, ObjectKind::Mesh> {};
+    template<> struct KindOf<InstancedMesh>: std::integral_constant<ObjectKind, ObjectKind::InstancedMesh> {};
+    template<> struct KindOf<BatchedMesh>: std::integral_constant<ObjectKind, ObjectKind::BatchedMesh> {};
+    template<> struct KindOf<SkinnedMesh>: std::integral_constant<ObjectKind, ObjectKind::SkinnedMesh> {};
+    template<> struct KindOf<Line>: std::integral_constant<ObjectKind, ObjectKind::Line> {};
+    template<> struct KindOf<LineSegments>: std::integral_constant<ObjectKind, ObjectKind::LineSegments> {};
+    template<> struct KindOf<LineLoop>: std::integral_constant<ObjectKind, ObjectKind::LineLoop> {};
+    template<> struct KindOf<Points>: std::integral_constant<ObjectKind, ObjectKind::Points> {};
+    template<> struct KindOf<Sprite>: std::integral_constant<ObjectKind, ObjectKind::Sprite> {};
+    template<> struct KindOf<LOD>: std::integral_constant<ObjectKind, ObjectKind::LOD> {};
+    template<> struct KindOf<Group>: std::integral_constant<ObjectKind, ObjectKind::Group> {};
+    template<> struct KindOf<Scene>: std::integral_constant<ObjectKind, ObjectKind::Scene> {};
+    template<> struct KindOf<Bone>: std::integral_constant<ObjectKind, ObjectKind::Bone> {};
+    template<> struct KindOf<Light>: std::integral_constant<ObjectKind, ObjectKind::Light> {};
+    template<> struct KindOf<AmbientLight>: std::integral_constant<ObjectKind, ObjectKind::AmbientLight> {};
+    template<> struct KindOf<DirectionalLight>: std::integral_constant<ObjectKind, ObjectKind::DirectionalLight> {};
+    template<> struct KindOf<PointLight>: std::integral_constant<ObjectKind, ObjectKind::PointLight> {};
+    template<> struct KindOf<SpotLight>: std::integral_constant<ObjectKind, ObjectKind::SpotLight> {};
+    template<> struct KindOf<HemisphereLight>: std::integral_constant<ObjectKind, ObjectKind::HemisphereLight> {};
+    template<> struct KindOf<LightProbe>: std::integral_constant<ObjectKind, ObjectKind::LightProbe> {};
+    template<> struct KindOf<Camera>: std::integral_constant<ObjectKind, ObjectKind::Camera> {};
+    template<> struct KindOf<PerspectiveCamera>: std::integral_constant<ObjectKind, ObjectKind::PerspectiveCamera> {};
+    template<> struct KindOf<OrthographicCamera>: std::integral_constant<ObjectKind, ObjectKind::OrthographicCamera> {};
+    template<> struct KindOf<ObjectWithMaterials>: std::integral_constant<ObjectKind, ObjectKind::ObjectWithMaterials> {};
+    template<> struct KindOf<ObjectWithMorphTargetInfluences>: std::integral_constant<ObjectKind, ObjectKind::ObjectWithMorphTargetInfluences> {};
+
     // This is the base class for most objects in three.js and provides a set of properties and methods for manipulating objects in 3D space.
     //Note that this can be used for grouping objects via the .add( object ) method which adds the object as a child, however it is better to use Group for this.
     class Object3D: public EventDispatcher {
@@ -40,9 +212,6 @@ namespace threepp {
         // Unique number for this object instance.
         unsigned int id{_object3Did++};
 
-        // UUID of this object instance. This gets automatically assigned, so this shouldn't be edited.
-        const std::string uuid;
-
         // Optional name of the object (doesn't need to be unique). Default is an empty string.
         std::string name;
 
@@ -72,9 +241,9 @@ namespace threepp {
         Matrix3 normalMatrix;
 
         // The local transform matrix.
-        std::shared_ptr<Matrix4> matrix;
+        Matrix4 matrix;
         // The global transform of the object. If the Object3D has no parent, then it's identical to the local transform .matrix.
-        std::shared_ptr<Matrix4> matrixWorld;
+        Matrix4 matrixWorld;
 
         // When this is set, it calculates the matrix of position, (rotation or quaternion) and scale every frame and also recalculates the matrixWorld property.
         // Default is Object3D::defaultMatrixAutoUpdate (true).
@@ -92,6 +261,9 @@ namespace threepp {
         // Whether the object gets rendered into shadow map. Default is false.
         bool castShadow = false;
         bool receiveShadow = false;
+        // Whether the object never moves or changes. Shadow maps draw such casters once and reuse them, see LightShadow::cacheStaticCasters.
+        // Setting or clearing it on an object is noticed when updateMatrixWorld runs.
+        bool staticShadow = false;
 
         // When this is set, it checks every frame if the object is in the frustum of the camera before rendering the object.
         // If set to false the object gets rendered every frame even if it is not in the frustum of the camera. Default is true.
@@ -100,13 +272,15 @@ namespace threepp {
         // When this property is set for an instance of Group, all descendants objects will be sorted and rendered together. Sorting is from lowest to highest renderOrder. Default value is 0.
         unsigned int renderOrder = 0;
 
-        std::unordered_map<std::string, std::any> userData;
+        // An object that can be used to store custom data about the Object3D.
+        UserData userData;
 
         std::optional<RenderCallback> onBeforeRender;
         std::optional<RenderCallback> onAfterRender;
 
         Object3D();
 
+        // Keeps the kinds of source, so it must be moved into an object of the same class.
         Object3D(Object3D&& source) noexcept;
         Object3D& operator=(Object3D&&) = delete;
         Object3D(const Object3D&) = delete;
@@ -114,6 +288,9 @@ namespace threepp {
 
         [[nodiscard]] virtual std::string type() const;
 
+        // UUID of this object instance. Generated on first access.
+        [[nodiscard]] const std::string& uuid() const;
+
         // Applies the matrix transform to the object and updates the object's position, rotation and scale.
         void applyMatrix4(const Matrix4& matrix);
 
@@ -229,6 +406,16 @@ namespace threepp {
 
         virtual void updateMatrixWorld(bool force = false);
 
+        // Incremented whenever a static shadow caster (see staticShadow) may have been added, removed, shown or hidden, in any scene.
+        [[nodiscard]] static unsigned int staticShadowVersion();
+
+        // True for types whose updateMatrixWorld does more than compose matrices (e.g. cameras update their inverse).
+        // TransformHierarchy leaves such nodes, and their subtrees, to updateMatrixWorld.
+        [[nodiscard]] virtual bool hasCustomMatrixWorldUpdate() const {
+
+            return false;
+        }
+
         virtual void updateWorldMatrix(std::optional<bool> updateParents = std::nullopt, std::optional<bool> updateChildren = std::nullopt);
 
         static std::shared_ptr<Object3D> create() {
@@ -250,21 +437,42 @@ namespace threepp {
             requires std::is_base_of<Object3D, T>::value
         T* as() {
 
-            return dynamic_cast<T*>(this);
+            if constexpr (requires { KindOf<T>::value; }) {
+
+                return static_cast<T*>(kinds_.get<KindOf<T>::value>());
+
+            } else {
+
+                return dynamic_cast<T*>(this);
+            }
         }
 
         template<class T>
             requires std::is_base_of<Object3D, T>::value
         const T* as() const {
 
-            return dynamic_cast<const T*>(this);
+            if constexpr (requires { KindOf<T>::value; }) {
+
+                return static_cast<const T*>(kinds_.get<KindOf<T>::value>());
+
+            } else {
+
+                return dynamic_cast<const T*>(this);
+            }
         }
 
         template<class T>
             requires std::is_base_of<Object3D, T>::value
         [[nodiscard]] bool is() const {
 
-            return dynamic_cast<const T*>(this) != nullptr;
+            if constexpr (requires { KindOf<T>::value; }) {
+
+                return kinds_.has<KindOf<T>::value>();
+
+            } else {
+
+                return dynamic_cast<const T*>(this) != nullptr;
+            }
         }
 
         virtual void copy(const Object3D& source, bool recursive = true);
@@ -286,8 +494,25 @@ namespace threepp {
             return std::make_shared<Object3D>();
         }
 
+        // Called from the constructor of each class with a KindOf specialisation.
+        template<class T>
+        void addKind(T* self) {
+
+            kinds_.add<KindOf<T>::value>(self);
+        }
+
     private:
         inline static unsigned int _object3Did{0};
+        inline static unsigned int staticShadowVersion_{0};
+
+        KindTags<ObjectKind, ObjectKind::ObjectWithMorphTargetInfluences> kinds_;
+
+        // visible, castShadow, receiveShadow and staticShadow as last seen by updateMatrixWorld
+        uint8_t shadowFlags_ = 0;
+
+        [[nodiscard]] bool hasStaticShadow() const;
+
+        mutable std::string uuid_;
 
         std::vector<std::shared_ptr<Object3D>> children_;
     };
@@ -29,6 +29,7 @@ namespace threepp {
         std::optional<Vector2> uv2;
         std::optional<Face3> face;
         std::optional<int> instanceId;
+        std::optional<int> batchId;// geometry id within a BatchedMesh
         std::optional<float> distanceToRay;
     };
 
@@ -0,0 +1,85 @@
+
+#ifndef THREEPP_TRANSFORMHIERARCHY_HPP
+#define THREEPP_TRANSFORMHIERARCHY_HPP
+
+#include "threepp/math/Matrix4.hpp"
+#include "threepp/math/Vector3.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace threepp {
+
+    class Object3D;
+    class ThreadPool;
+
+    // An optional replacement for root.updateMatrixWorld() aimed at large, mostly static scene graphs.
+    //
+    // The hierarchy below root is mirrored into flat arrays in depth-first order (local TRS, local matrix,
+    // world matrix and parent index). Each update only recomposes nodes whose position, quaternion or scale changed
+    // (or that have matrixWorldNeedsUpdate set) and only recomputes world matrices below those nodes.
+    // Levels of the hierarchy are processed in parallel when a ThreadPool is supplied.
+    //
+    // Results are written back to Object3D::matrix and Object3D::matrixWorld, so existing code keeps working.
+    // As a consequence, set matrixWorldNeedsUpdate after editing matrix or matrixWorld by hand.
+    // Structural changes (add/remove) are detected automatically and trigger a rebuild of the flat layout.
+    //
+    // Typical use is to set scene.autoUpdate = false and call update() once per frame before rendering.
+    class TransformHierarchy {
+
+    public:
+        explicit TransformHierarchy(Object3D& root, ThreadPool* pool = nullptr);
+
+        // Equivalent to root.updateMatrixWorld(force).
+        void update(bool force = false);
+
+        // Forces the flat layout to be rebuilt on the next update.
+        void invalidate();
+
+        // Number of mirrored nodes.
+        [[nodiscard]] size_t size() const;
+
+        // Number of world matrices recomputed by the last update (excluding nodes left to updateMatrixWorld).
+        [[nodiscard]] size_t numUpdated() const;
+
+    private:
+        Object3D& root_;
+        ThreadPool* pool_;
+
+        bool valid_ = false;
+        size_t numUpdated_ = 0;
+
+        // per node, depth-first order
+        std::vector<Object3D*> nodes_;
+        std::vector<int> parents_;
+        std::vector<Vector3> positions_;
+        std::vector<std::array<float, 4>> quaternions_;
+        std::vector<Vector3> scales_;
+        std::vector<Matrix4> localMatrices_;
+        std::vector<Matrix4> worldMatrices_;
+        std::vector<uint8_t> flags_;
+
+        // children of every node as seen at build time, used to detect structural changes
+        std::vector<Object3D*> children_;
+        std::vector<size_t> childOffsets_;
+
+        // node indices grouped by depth
+        std::vector<std::vector<uint32_t>> levels_;
+
+        // nodes with custom updateMatrixWorld, in depth-first order, with the index of their mirrored parent
+        std::vector<std::pair<Object3D*, int>> delegated_;
+
+        Matrix4 rootParentWorld_;
+
+        void rebuild();
+
+        [[nodiscard]] bool structureChanged() const;
+
+        void forEach(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_TRANSFORMHIERARCHY_HPP
@@ -2,6 +2,8 @@
 #ifndef THREEPP_MISC_HPP
 #define THREEPP_MISC_HPP
 
+#include <vector>
+
 namespace threepp {
 
     struct GeometryGroup {
@@ -23,6 +25,17 @@ namespace threepp {
         int count{};
     };
 
+    // The slot of an object in a renderer side table (gl::GLSlotMap), cached on the object
+    // so that finding its GPU state each draw is array indexing rather than a hash lookup.
+    struct RendererHandle {
+
+        unsigned int index{};
+        unsigned int generation{};
+    };
+
+    // Indexed by table id, grown as the object is stored in more tables.
+    using RendererHandles = std::vector<RendererHandle>;
+
 }// namespace threepp
 
 #endif//THREEPP_MISC_HPP
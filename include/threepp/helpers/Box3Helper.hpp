@@ -12,6 +12,11 @@ namespace threepp {
     public:
         void updateMatrixWorld(bool force) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         static std::shared_ptr<Box3Helper> create(const Box3& box, const Color& color = 0xffff00);
 
     protected:
@@ -17,6 +17,13 @@ namespace threepp {
 
         void update();
 
+        void updateMatrixWorld(bool force) override;
+
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         ~CameraHelper() override;
 
     private:
@@ -16,6 +16,13 @@ namespace threepp {
     public:
         void update();
 
+        void updateMatrixWorld(bool force) override;
+
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         static std::shared_ptr<DirectionalLightHelper> create(
                 DirectionalLight& light,
                 float size = 1,
@@ -20,6 +20,13 @@ namespace threepp {
 
         void update();
 
+        void updateMatrixWorld(bool force) override;
+
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         void dispose();
 
         static std::shared_ptr<HemisphereLightHelper> create(HemisphereLight& light, float size, const std::optional<Color>& color = std::nullopt);
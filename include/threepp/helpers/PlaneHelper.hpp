@@ -17,6 +17,11 @@ namespace threepp {
 
         void updateMatrixWorld(bool force) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         static std::shared_ptr<PlaneHelper> create(const Plane& plane, float size = 1, const Color& color = 0xffff00);
 
     protected:
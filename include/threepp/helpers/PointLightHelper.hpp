@@ -17,6 +17,13 @@ namespace threepp {
     public:
         void update();
 
+        void updateMatrixWorld(bool force) override;
+
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         static std::shared_ptr<PointLightHelper> create(PointLight& light, float sphereSize, std::optional<Color> color = std::nullopt);
 
     private:
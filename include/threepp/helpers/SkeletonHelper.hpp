@@ -18,6 +18,11 @@ namespace threepp {
 
         void updateMatrixWorld(bool force) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         static std::shared_ptr<SkeletonHelper> create(Object3D& skeleton) {
 
             return std::make_shared<SkeletonHelper>(skeleton);
@@ -7,17 +7,42 @@
 
 #include "threepp/cameras/OrthographicCamera.hpp"
 
+#include <array>
+
 namespace threepp {
 
     class DirectionalLightShadow: public LightShadow {
 
     public:
+        static constexpr int maxCascades = 4;
+
+        // Blend between uniform (0) and logarithmic (1) cascade splits.
+        float cascadeSplitLambda = 0.5f;
+        // View distance covered by the cascades. Zero covers up to the far plane of the view camera.
+        float cascadeFar = 0;
+        // Extra depth towards the light, so that casters outside the view still shadow it.
+        float cascadeMargin = 100;
+
+        // Maps light view space (matrix when cascaded) into the uv and depth of each cascade.
+        std::array<Matrix4, maxCascades> cascadeMatrices;
+
+        // Splits the view frustum into cascades, each mapSize large and placed side by side in map.
+        // One cascade (the default) uses the frustum of camera as is.
+        void setCascades(int cascades);
+
+        [[nodiscard]] int cascades() const;
+
+        // Fits the shadow camera to a cascade of the view frustum of camera.
+        void updateCascade(Light& light, const Camera& camera, size_t cascade);
+
         static std::shared_ptr<DirectionalLightShadow> create() {
 
             return std::shared_ptr<DirectionalLightShadow>(new DirectionalLightShadow());
         }
 
     protected:
+        int cascades_ = 1;
+
         DirectionalLightShadow()
             : LightShadow(std::make_unique<OrthographicCamera>(-50.f, 50.f, 50.f, -50.f, 0.5f, 500.f)) {}
     };
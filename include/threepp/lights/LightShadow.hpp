@@ -27,11 +27,16 @@ namespace threepp {
 
         std::unique_ptr<GLRenderTarget> map;
         std::unique_ptr<GLRenderTarget> mapPass;
+        // Depth of the casters marked Object3D::staticShadow, copied into map before the other casters are drawn.
+        std::unique_ptr<GLRenderTarget> staticMap;
 
         Matrix4 matrix;
 
         bool autoUpdate = true;
         bool needsUpdate = false;
+        // Draws static casters again only when they, the light or the shadow camera change.
+        // Ignored for cascaded directional shadows.
+        bool cacheStaticCasters = true;
 
         LightShadow(LightShadow&&) = delete;
         LightShadow(const LightShadow&) = delete;
@@ -0,0 +1,28 @@
+// https://github.com/mrdoob/three.js/blob/r129/examples/jsm/loaders/DDSLoader.js
+
+#ifndef THREEPP_DDSLOADER_HPP
+#define THREEPP_DDSLOADER_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace threepp {
+
+    // Loads 2D DDS textures in BC1 (DXT1), BC3 (DXT5), BC4, BC5 and BC7, with the mip chain stored in the file.
+    // Throws for other formats, cube maps and texture arrays.
+    class DDSLoader {
+
+    public:
+        // Compressed blocks can't be flipped, so flipY flips the texture through its offset and repeat instead.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> load(const std::filesystem::path& path, bool flipY = true) const;
+
+        // The levels of the texture point into data, which is kept alive by them.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> parse(std::vector<unsigned char> data, bool flipY = true) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_DDSLOADER_HPP
@@ -9,6 +9,7 @@
 
 namespace threepp {
 
+    // Decodes through stb_image. Safe to use from several threads at once, flipY is set per thread.
     class ImageLoader {
 
     public:
@@ -0,0 +1,28 @@
+// https://github.com/mrdoob/three.js/blob/r129/examples/jsm/loaders/KTX2Loader.js
+
+#ifndef THREEPP_KTX2LOADER_HPP
+#define THREEPP_KTX2LOADER_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace threepp {
+
+    // Loads 2D KTX2 textures in BC1, BC3, BC4, BC5, BC7, ETC2 RGB and ETC2 RGBA (EAC), with the mip chain stored in the file.
+    // Unlike three.js there is no Basis Universal transcoder, so supercompressed files are not supported.
+    class KTX2Loader {
+
+    public:
+        // Compressed blocks can't be flipped, so flipY flips the texture through its offset and repeat instead.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> load(const std::filesystem::path& path, bool flipY = true) const;
+
+        // The levels of the texture point into data, which is kept alive by them.
+        [[nodiscard]] std::shared_ptr<CompressedTexture> parse(std::vector<unsigned char> data, bool flipY = true) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_KTX2LOADER_HPP
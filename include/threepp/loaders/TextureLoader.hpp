@@ -5,6 +5,7 @@
 #include "threepp/textures/Texture.hpp"
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 
 namespace threepp {
@@ -18,6 +19,20 @@ namespace threepp {
 
         std::shared_ptr<Texture> loadFromMemory(const std::string& name, const std::vector<unsigned char>& data, bool flipY = true);
 
+        // Returns at once with a texture holding a 1x1 white placeholder, while the file is decoded on a worker thread.
+        // update() swaps the decoded image in and then invokes onLoad. Requests for a path already in flight share its texture.
+        // When decoding fails, the placeholder is dropped from the cache and onError is invoked instead.
+        std::shared_ptr<Texture> loadAsync(const std::filesystem::path& path, bool flipY = true,
+                                           const std::function<void(Texture&)>& onLoad = nullptr,
+                                           const std::function<void(Texture&)>& onError = nullptr);
+
+        // Applies the decodes finished since the last call, flagging their textures for upload.
+        // Call from the render thread, e.g. once per frame. Returns the number of loads still in flight.
+        size_t update();
+
+        // Blocks until every load in flight is decoded, then applies them as update() does.
+        void waitAll();
+
         void clearCache();
 
         ~TextureLoader();
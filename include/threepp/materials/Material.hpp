@@ -5,7 +5,9 @@
 
 #include "threepp/constants.hpp"
 #include "threepp/core/EventDispatcher.hpp"
+#include "threepp/core/KindTags.hpp"
 #include "threepp/core/Uniform.hpp"
+#include "threepp/core/misc.hpp"
 #include "threepp/math/Plane.hpp"
 
 #include <optional>
@@ -15,6 +17,155 @@ namespace threepp {
 
     typedef std::variant<bool, int, float, Vector2, Side, Blending, BlendFactor, BlendEquation, StencilFunc, StencilOp, CombineOperation, DepthFunc, NormalMapType, Color, std::string, std::shared_ptr<Texture>> MaterialValue;
 
+    // Material classes and capabilities that is<T>() and as<T>() resolve without dynamic_cast, see KindTags.
+    enum class MaterialKind {
+        LineBasicMaterial,
+        MeshBasicMaterial,
+        MeshDepthMaterial,
+        MeshDistanceMaterial,
+        MeshLambertMaterial,
+        MeshMatcapMaterial,
+        MeshNormalMaterial,
+        MeshPhongMaterial,
+        MeshStandardMaterial,
+        MeshToonMaterial,
+        PointsMaterial,
+        RawShaderMaterial,
+        ShaderMaterial,
+        ShadowMaterial,
+        SpriteMaterial,
+
+        MaterialWithColor,
+        MaterialWithRotation,
+        MaterialWithClipping,
+        MaterialWithLights,
+        MaterialWithSize,
+        MaterialWithLineWidth,
+        MaterialWithEmissive,
+        MaterialWithSpecular,
+        MaterialWithReflectivityRatio,
+        MaterialWithReflectivity,
+        MaterialWithWireframe,
+        MaterialWithMap,
+        MaterialWithAlphaMap,
+        MaterialWithSpecularMap,
+        MaterialWithEnvMap,
+        MaterialWithGradientMap,
+        MaterialWithAoMap,
+        MaterialWithBumpMap,
+        MaterialWithLightMap,
+        MaterialWithDisplacementMap,
+        MaterialWithNormalMap,
+        MaterialWithMatCap,
+        MaterialWithRoughness,
+        MaterialWithMetalness,
+        MaterialWithThickness,
+        MaterialWithSheen,
+        MaterialWithCombine,
+        MaterialWithDepthPacking,
+        MaterialWithFlatShading,
+        MaterialWithVertexTangents,
+        MaterialWithDefines,
+        MaterialWithMorphTargets// last, see kinds_
+    };
+
+    class LineBasicMaterial;
+    class MeshBasicMaterial;
+    class MeshDepthMaterial;
+    class MeshDistanceMaterial;
+    class MeshLambertMaterial;
+    class MeshMatcapMaterial;
+    class MeshNormalMaterial;
+    class MeshPhongMaterial;
+    class MeshStandardMaterial;
+    class MeshToonMaterial;
+    class PointsMaterial;
+    class RawShaderMaterial;
+    class ShaderMaterial;
+    class ShadowMaterial;
+    class SpriteMaterial;
+
+    struct MaterialWithColor;
+    struct MaterialWithRotation;
+    struct MaterialWithClipping;
+    struct MaterialWithLights;
+    struct MaterialWithSize;
+    struct MaterialWithLineWidth;
+    struct MaterialWithEmissive;
+    struct MaterialWithSpecular;
+    struct MaterialWithReflectivityRatio;
+    struct MaterialWithReflectivity;
+    struct MaterialWithWireframe;
+    struct MaterialWithMap;
+    struct MaterialWithAlphaMap;
+    struct MaterialWithSpecularMap;
+    struct MaterialWithEnvMap;
+    struct MaterialWithGradientMap;
+    struct MaterialWithAoMap;
+    struct MaterialWithBumpMap;
+    struct MaterialWithLightMap;
+    struct MaterialWithDisplacementMap;
+    struct MaterialWithNormalMap;
+    struct MaterialWithMatCap;
+    struct MaterialWithRoughness;
+    struct MaterialWithMetalness;
+    struct MaterialWithThickness;
+    struct MaterialWithSheen;
+    struct MaterialWithCombine;
+    struct MaterialWithDepthPacking;
+    struct MaterialWithFlatShading;
+    struct MaterialWithVertexTangents;
+    struct MaterialWithDefines;
+    struct MaterialWithMorphTargets;
+
+    template<> struct KindOf<LineBasicMaterial>: std::integral_constant<MaterialKind, MaterialKind::LineBasicMaterial> {};
+    template<> struct KindOf<MeshBasicMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshBasicMaterial> {};
+    template<> struct KindOf<MeshDepthMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshDepthMaterial> {};
+    template<> struct KindOf<MeshDistanceMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshDistanceMaterial> {};
+    template<> struct KindOf<MeshLambertMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshLambertMaterial> {};
+    template<> struct KindOf<MeshMatcapMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshMatcapMaterial> {};
+    template<> struct KindOf<MeshNormalMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshNormalMaterial> {};
+    template<> struct KindOf<MeshPhongMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshPhongMaterial> {};
+    template<> struct KindOf<MeshStandardMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshStandardMaterial> {};
+    template<> struct KindOf<MeshToonMaterial>: std::integral_constant<MaterialKind, MaterialKind::MeshToonMaterial> {};
+    template<> struct KindOf<PointsMaterial>: std::integral_constant<MaterialKind, MaterialKind::PointsMaterial> {};
+    template<> struct KindOf<RawShaderMaterial>: std::integral_constant<MaterialKind, MaterialKind::RawShaderMaterial> {};
+    template<> struct KindOf<ShaderMaterial>: std::integral_constant<MaterialKind, MaterialKind::ShaderMaterial> {};
+    template<> struct KindOf<ShadowMaterial>: std::integral_constant<MaterialKind, MaterialKind::ShadowMaterial> {};
+    template<> struct KindOf<SpriteMaterial>: std::integral_constant<MaterialKind, MaterialKind::SpriteMaterial> {};
+    template<> struct KindOf<MaterialWithColor>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithColor> {};
+    template<> struct KindOf<MaterialWithRotation>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithRotation> {};
+    template<> struct KindOf<MaterialWithClipping>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithClipping> {};
+    template<> struct KindOf<MaterialWithLights>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithLights> {};
+    template<> struct KindOf<MaterialWithSize>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithSize> {};
+    template<> struct KindOf<MaterialWithLineWidth>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithLineWidth> {};
+    template<> struct KindOf<MaterialWithEmissive>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithEmissive> {};
+    template<> struct KindOf<MaterialWithSpecular>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithSpecular> {};
+    template<> struct KindOf<MaterialWithReflectivityRatio>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithReflectivityRatio> {};
+    template<> struct KindOf<MaterialWithReflectivity>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithReflectivity> {};
+    template<> struct KindOf<MaterialWithWireframe>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithWireframe> {};
+    template<> struct KindOf<MaterialWithMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithMap> {};
+    template<> struct KindOf<MaterialWithAlphaMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithAlphaMap> {};
+    template<> struct KindOf<MaterialWithSpecularMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithSpecularMap> {};
+    template<> struct KindOf<MaterialWithEnvMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithEnvMap> {};
+    template<> struct KindOf<MaterialWithGradientMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithGradientMap> {};
+    template<> struct KindOf<MaterialWithAoMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithAoMap> {};
+    template<> struct KindOf<MaterialWithBumpMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithBumpMap> {};
+    template<> struct KindOf<MaterialWithLightMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithLightMap> {};
+    template<> struct KindOf<MaterialWithDisplacementMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithDisplacementMap> {};
+    template<> struct KindOf<MaterialWithNormalMap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithNormalMap> {};
+    template<> struct KindOf<MaterialWithMatCap>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithMatCap> {};
+    template<> struct KindOf<MaterialWithRoughness>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithRoughness> {};
+    template<> struct KindOf<MaterialWithMetalness>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithMetalness> {};
+    template<> struct KindOf<MaterialWithThickness>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithThickness> {};
+    template<> struct KindOf<MaterialWithSheen>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithSheen> {};
+    template<> struct KindOf<MaterialWithCombine>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithCombine> {};
+    template<> struct KindOf<MaterialWithDepthPacking>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithDepthPacking> {};
+    template<> struct KindOf<MaterialWithFlatShading>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithFlatShading> {};
+    template<> struct KindOf<MaterialWithVertexTangents>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithVertexTangents> {};
+    template<> struct KindOf<MaterialWithDefines>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithDefines> {};
+    template<> struct KindOf<MaterialWithMorphTargets>: std::integral_constant<MaterialKind, MaterialKind::MaterialWithMorphTargets> {};
+
     class Material: public EventDispatcher {
 
     public:
@@ -76,6 +227,9 @@ namespace threepp {
 
         std::unordered_map<std::string, UniformValue> defaultAttributeValues;
 
+        // used by the renderer, see RendererHandle
+        RendererHandles rendererHandles;
+
         Material(Material&&) = delete;
         Material& operator=(Material&&) = delete;
         Material(const Material&) = delete;
@@ -97,14 +251,28 @@ namespace threepp {
             requires std::derived_from<T, Material>
         T* as() {
 
-            return dynamic_cast<T*>(this);
+            if constexpr (requires { KindOf<T>::value; }) {
+
+                return static_cast<T*>(kinds_.get<KindOf<T>::value>());
+
+            } else {
+
+                return dynamic_cast<T*>(this);
+            }
         }
 
         template<class T>
             requires std::derived_from<T, Material>
         [[nodiscard]] bool is() const {
 
-            return dynamic_cast<const T*>(this) != nullptr;
+            if constexpr (requires { KindOf<T>::value; }) {
+
+                return kinds_.has<KindOf<T>::value>();
+
+            } else {
+
+                return dynamic_cast<const T*>(this) != nullptr;
+            }
         }
 
         template<class T = Material>
@@ -144,7 +312,16 @@ namespace threepp {
 
         virtual bool setValue(const std::string& key, const MaterialValue& value);
 
+        // Called from the constructor of each class with a KindOf specialisation.
+        template<class T>
+        void addKind(T* self) {
+
+            kinds_.add<KindOf<T>::value>(self);
+        }
+
     private:
+        KindTags<MaterialKind, MaterialKind::MaterialWithMorphTargets> kinds_;
+
         bool disposed_ = false;
         std::string uuid_;
         unsigned int version_ = 0;
@@ -55,6 +55,8 @@ namespace threepp {
               MaterialWithDisplacementMap(1, 0),
               MaterialWithWireframe(false, 1) {
 
+            addKind(this);
+
             this->fog = false;
         }
 
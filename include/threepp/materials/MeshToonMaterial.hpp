@@ -82,6 +82,8 @@ namespace threepp {
               MaterialWithWireframe(false, 1),
               MaterialWithNormalMap(NormalMapType::TangentSpace, {1, 1}) {
 
+            addKind(this);
+
             this->defines["TOON"] = "";
         }
 
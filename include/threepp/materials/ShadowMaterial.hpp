@@ -25,6 +25,8 @@ namespace threepp {
     protected:
         ShadowMaterial(): MaterialWithColor(0x000000) {
 
+            addKind(this);
+
             this->transparent = true;
         }
 
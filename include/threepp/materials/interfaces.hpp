@@ -14,26 +14,40 @@ namespace threepp {
 
         Color color;
 
-        explicit MaterialWithColor(Color color): color(color) {}
+        explicit MaterialWithColor(Color color): color(color) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithRotation: virtual Material {
 
         float rotation{};
+
+        MaterialWithRotation() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithClipping: virtual Material {
 
         bool clipping;
 
-        explicit MaterialWithClipping(bool clipping): clipping(clipping) {}
+        explicit MaterialWithClipping(bool clipping): clipping(clipping) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithLights: virtual Material {
 
         bool lights;
 
-        explicit MaterialWithLights(bool lights): lights(lights) {}
+        explicit MaterialWithLights(bool lights): lights(lights) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithSize: virtual Material {
@@ -41,14 +55,20 @@ namespace threepp {
         float size;
         bool sizeAttenuation;
 
-        MaterialWithSize(float size, bool sizeAttenuation): size(size), sizeAttenuation(sizeAttenuation) {}
+        MaterialWithSize(float size, bool sizeAttenuation): size(size), sizeAttenuation(sizeAttenuation) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithLineWidth: virtual Material {
 
         float linewidth;
 
-        explicit MaterialWithLineWidth(float linewidth): linewidth(linewidth) {}
+        explicit MaterialWithLineWidth(float linewidth): linewidth(linewidth) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithEmissive: virtual Material {
@@ -57,7 +77,10 @@ namespace threepp {
         float emissiveIntensity;
         std::shared_ptr<Texture> emissiveMap;
 
-        MaterialWithEmissive(Color emissive, float emissiveIntensity): emissive(emissive), emissiveIntensity(emissiveIntensity) {}
+        MaterialWithEmissive(Color emissive, float emissiveIntensity): emissive(emissive), emissiveIntensity(emissiveIntensity) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithSpecular: virtual Material {
@@ -65,21 +88,30 @@ namespace threepp {
         Color specular;
         float shininess;
 
-        MaterialWithSpecular(Color specular, float shininess): specular(specular), shininess(shininess) {}
+        MaterialWithSpecular(Color specular, float shininess): specular(specular), shininess(shininess) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithReflectivityRatio: virtual Material {
 
         float refractionRatio;
 
-        explicit MaterialWithReflectivityRatio(float refractionRatio): refractionRatio(refractionRatio) {}
+        explicit MaterialWithReflectivityRatio(float refractionRatio): refractionRatio(refractionRatio) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithReflectivity: virtual Material, public MaterialWithReflectivityRatio {
 
         float reflectivity;
 
-        MaterialWithReflectivity(float reflectivity, float refractionRatio): MaterialWithReflectivityRatio(refractionRatio), reflectivity(reflectivity) {}
+        MaterialWithReflectivity(float reflectivity, float refractionRatio): MaterialWithReflectivityRatio(refractionRatio), reflectivity(reflectivity) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithWireframe: virtual Material {
@@ -87,22 +119,40 @@ namespace threepp {
         bool wireframe;
         float wireframeLinewidth;
 
-        MaterialWithWireframe(bool wireframe, float wireframeLinewidth): wireframe(wireframe), wireframeLinewidth(wireframeLinewidth) {}
+        MaterialWithWireframe(bool wireframe, float wireframeLinewidth): wireframe(wireframe), wireframeLinewidth(wireframeLinewidth) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithMap: virtual Material {
 
         std::shared_ptr<Texture> map;
+
+        MaterialWithMap() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithAlphaMap: virtual Material {
 
         std::shared_ptr<Texture> alphaMap;
+
+        MaterialWithAlphaMap() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithSpecularMap: virtual Material {
 
         std::shared_ptr<Texture> specularMap;
+
+        MaterialWithSpecularMap() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithEnvMap: virtual Material {
@@ -110,12 +160,20 @@ namespace threepp {
         float envMapIntensity;// Only used by MeshStandardMaterial
         std::shared_ptr<Texture> envMap;
 
-        explicit MaterialWithEnvMap(std::optional<float> envMapIntensity = std::nullopt): envMapIntensity(envMapIntensity.value_or(1)) {}
+        explicit MaterialWithEnvMap(std::optional<float> envMapIntensity = std::nullopt): envMapIntensity(envMapIntensity.value_or(1)) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithGradientMap: virtual Material {
 
         std::shared_ptr<Texture> gradientMap;
+
+        MaterialWithGradientMap() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithAoMap: virtual Material {
@@ -123,7 +181,10 @@ namespace threepp {
         std::shared_ptr<Texture> aoMap;
         float aoMapIntensity;
 
-        explicit MaterialWithAoMap(float aoMapIntensity): aoMapIntensity(aoMapIntensity) {}
+        explicit MaterialWithAoMap(float aoMapIntensity): aoMapIntensity(aoMapIntensity) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithBumpMap: virtual Material {
@@ -131,7 +192,10 @@ namespace threepp {
         std::shared_ptr<Texture> bumpMap;
         float bumpScale;
 
-        explicit MaterialWithBumpMap(float bumpScale): bumpScale(bumpScale) {}
+        explicit MaterialWithBumpMap(float bumpScale): bumpScale(bumpScale) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithLightMap: virtual Material {
@@ -139,7 +203,10 @@ namespace threepp {
         std::shared_ptr<Texture> lightMap;
         float lightMapIntensity;
 
-        explicit MaterialWithLightMap(float lightMapIntensity): lightMapIntensity(lightMapIntensity) {}
+        explicit MaterialWithLightMap(float lightMapIntensity): lightMapIntensity(lightMapIntensity) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithDisplacementMap: virtual Material {
@@ -148,7 +215,10 @@ namespace threepp {
         float displacementScale;
         float displacementBias;
 
-        MaterialWithDisplacementMap(float displacementScale, float displacementBias): displacementScale(displacementScale), displacementBias(displacementBias) {}
+        MaterialWithDisplacementMap(float displacementScale, float displacementBias): displacementScale(displacementScale), displacementBias(displacementBias) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithNormalMap: virtual Material {
@@ -157,12 +227,20 @@ namespace threepp {
         NormalMapType normalMapType;
         Vector2 normalScale;
 
-        MaterialWithNormalMap(NormalMapType normalMapType, Vector2 normalScale): normalMapType(normalMapType), normalScale(normalScale) {}
+        MaterialWithNormalMap(NormalMapType normalMapType, Vector2 normalScale): normalMapType(normalMapType), normalScale(normalScale) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithMatCap: virtual Material {
 
         std::shared_ptr<Texture> matcap;
+
+        MaterialWithMatCap() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithRoughness: virtual Material {
@@ -170,7 +248,10 @@ namespace threepp {
         float roughness;
         std::shared_ptr<Texture> roughnessMap;
 
-        explicit MaterialWithRoughness(float roughness): roughness(roughness) {}
+        explicit MaterialWithRoughness(float roughness): roughness(roughness) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithMetalness: virtual Material {
@@ -178,56 +259,91 @@ namespace threepp {
         float metalness;
         std::shared_ptr<Texture> metalnessMap;
 
-        explicit MaterialWithMetalness(float metalness): metalness(metalness) {}
+        explicit MaterialWithMetalness(float metalness): metalness(metalness) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithThickness: virtual Material {
 
         std::shared_ptr<Texture> thicknessMap;
+
+        MaterialWithThickness() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithSheen: virtual Material {
 
         std::optional<Color> sheen;
+
+        MaterialWithSheen() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithCombine: virtual Material {
 
         CombineOperation combine;
 
-        explicit MaterialWithCombine(CombineOperation combine): combine(combine) {}
+        explicit MaterialWithCombine(CombineOperation combine): combine(combine) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithDepthPacking: virtual Material {
 
         DepthPacking depthPacking;
 
-        explicit MaterialWithDepthPacking(DepthPacking depthPacking): depthPacking(depthPacking) {}
+        explicit MaterialWithDepthPacking(DepthPacking depthPacking): depthPacking(depthPacking) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithFlatShading: virtual Material {
 
         bool flatShading;
 
-        explicit MaterialWithFlatShading(bool flatShading): flatShading(flatShading) {}
+        explicit MaterialWithFlatShading(bool flatShading): flatShading(flatShading) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithVertexTangents: virtual Material {
 
         bool vertexTangents;
 
-        explicit MaterialWithVertexTangents(bool vertexTangents): vertexTangents(vertexTangents) {}
+        explicit MaterialWithVertexTangents(bool vertexTangents): vertexTangents(vertexTangents) {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithDefines: virtual Material {
 
         std::unordered_map<std::string, std::string> defines;
+
+        MaterialWithDefines() {
+
+            addKind(this);
+        }
     };
 
     struct MaterialWithMorphTargets: virtual Material {
 
         bool morphTargets = false;
         bool morphNormals = false;
+
+        MaterialWithMorphTargets() {
+
+            addKind(this);
+        }
     };
 
 }// namespace threepp
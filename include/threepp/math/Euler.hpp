@@ -5,6 +5,8 @@
 
 #include "float_view.hpp"
 
+#include <optional>
+
 namespace threepp {
 
     class Vector3;
@@ -40,6 +42,12 @@ namespace threepp {
 
         explicit Euler(float x = 0, float y = 0, float z = 0, RotationOrders order = default_order);
 
+        // Copies the angles and order, but not the change listener.
+        Euler(const Euler& e);
+
+        // Same as copy(e).
+        Euler& operator=(const Euler& e);
+
         [[nodiscard]] RotationOrders getOrder() const;
 
         void setOrder(RotationOrders value);
@@ -54,7 +62,7 @@ namespace threepp {
 
         Euler& setFromVector3(const Vector3& v, std::optional<RotationOrders> order = std::nullopt);
 
-        Euler& _onChange(std::function<void()> callback);
+        Euler& _onChange(void (*callback)(void*), void* context);
 
         [[nodiscard]] bool equals(const Euler& euler) const;
 
@@ -82,7 +90,9 @@ namespace threepp {
     private:
         RotationOrders order_ = default_order;
 
-        std::function<void()> onChangeCallback_ = [] {};
+        float_view::Listener onChangeCallback_;
+
+        void bindComponents();
 
         friend class Object3D;
         friend class Quaternion;
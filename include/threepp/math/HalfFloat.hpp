@@ -0,0 +1,91 @@
+
+#ifndef THREEPP_HALFFLOAT_HPP
+#define THREEPP_HALFFLOAT_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace threepp {
+
+    // IEEE 754 binary16 conversions, rounding to nearest even.
+    inline uint16_t toHalfFloat(float value) {
+
+        const auto x = std::bit_cast<uint32_t>(value);
+
+        const auto sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+        uint32_t mantissa = x & 0x007fffff;
+        int exponent = static_cast<int>((x >> 23) & 0xff);
+
+        if (exponent == 0xff) {// Inf or NaN
+
+            return sign | 0x7c00 | (mantissa ? 0x0200 : 0);
+        }
+
+        exponent = exponent - 127 + 15;
+
+        if (exponent >= 0x1f) return sign | 0x7c00;
+
+        if (exponent <= 0) {// subnormal or zero
+
+            if (exponent < -10) return sign;
+
+            mantissa |= 0x00800000;
+            const auto shift = static_cast<uint32_t>(14 - exponent);
+            auto half = mantissa >> shift;
+            const auto rest = mantissa & ((1u << shift) - 1);
+            const auto halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1))) ++half;
+
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // a carry out of the mantissa correctly bumps the exponent, up to Inf
+        auto half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        const auto rest = mantissa & 0x1fff;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) ++half;
+
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    inline float fromHalfFloat(uint16_t value) {
+
+        const auto sign = static_cast<uint32_t>(value & 0x8000) << 16;
+        const auto exponent = static_cast<uint32_t>((value >> 10) & 0x1f);
+        const auto mantissa = static_cast<uint32_t>(value & 0x03ff);
+
+        if (exponent == 0) {// subnormal or zero
+
+            const auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        if (exponent == 0x1f) {// Inf or NaN
+
+            return std::bit_cast<float>(sign | 0x7f800000 | (mantissa << 13));
+        }
+
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    // A 16 bit float as stored in GPU buffers, converts implicitly to and from float.
+    struct HalfFloat {
+
+        uint16_t bits{};
+
+        HalfFloat() = default;
+
+        HalfFloat(float value)
+            : bits(toHalfFloat(value)) {}
+
+        operator float() const {
+
+            return fromHalfFloat(bits);
+        }
+    };
+
+    static_assert(sizeof(HalfFloat) == sizeof(uint16_t));
+
+}// namespace threepp
+
+#endif//THREEPP_HALFFLOAT_HPP
@@ -5,7 +5,7 @@
 
 #include "threepp/math/float_view.hpp"
 
-#include <functional>
+#include <ostream>
 
 namespace threepp {
 
@@ -23,6 +23,12 @@ namespace threepp {
 
         explicit Quaternion(float x = 0, float y = 0, float z = 0, float w = 1);
 
+        // Copies the components, but not the change listener.
+        Quaternion(const Quaternion& q);
+
+        // Same as copy(q).
+        Quaternion& operator=(const Quaternion& q);
+
         float operator[](unsigned int index) const;
 
         Quaternion& set(float x, float y, float z, float w);
@@ -73,7 +79,7 @@ namespace threepp {
 
         bool operator!=(const Quaternion& other) const;
 
-        Quaternion& _onChange(std::function<void()> callback);
+        Quaternion& _onChange(void (*callback)(void*), void* context);
 
         template<class ArrayLike>
         Quaternion& fromArray(const ArrayLike& array, unsigned int offset = 0) {
@@ -103,7 +109,9 @@ namespace threepp {
         }
 
     private:
-        std::function<void()> onChangeCallback_ = [] {};
+        float_view::Listener onChangeCallback_;
+
+        void bindComponents();
     };
 
 }// namespace threepp
@@ -2,8 +2,7 @@
 #ifndef THREEPP_FLOAT_VIEW_HPP
 #define THREEPP_FLOAT_VIEW_HPP
 
-#include <functional>
-#include <optional>
+#include <algorithm>
 #include <ostream>
 #include <utility>
 
@@ -13,9 +12,31 @@ namespace threepp {
     class float_view {
 
     public:
+        // Change notification shared by all components of an owner (Euler, Quaternion).
+        // A plain function pointer and context rather than std::function, as every Object3D carries seven of these components.
+        struct Listener {
+
+            void (*callback)(void*) = nullptr;
+            void* context = nullptr;
+
+            void operator()() const {
+
+                if (callback) callback(context);
+            }
+        };
+
         float_view(float value = 0)
             : value_(value) {}
 
+        // Copies the value only, the listener belongs to the owner.
+        float_view(const float_view& other)
+            : value_(other.value_) {}
+
+        float_view& operator=(const float_view& other) {
+
+            return *this = other.value_;
+        }
+
         operator float() const {
 
             return value_;
@@ -24,7 +45,7 @@ namespace threepp {
         float_view& operator=(float v) {
 
             this->value_ = v;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -42,7 +63,7 @@ namespace threepp {
         float_view& operator*=(float f) {
 
             value_ *= f;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -55,7 +76,7 @@ namespace threepp {
         float_view& operator/=(float f) {
 
             value_ /= f;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -73,7 +94,7 @@ namespace threepp {
         float_view& operator+=(float f) {
 
             value_ += f;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -91,7 +112,7 @@ namespace threepp {
         float_view& operator-=(float f) {
 
             value_ -= f;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -99,7 +120,7 @@ namespace threepp {
         float_view& operator++() {
 
             value_++;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -107,7 +128,7 @@ namespace threepp {
         float_view& operator--() {
 
             value_--;
-            if (f_) f_.value()();
+            if (listener_) (*listener_)();
 
             return *this;
         }
@@ -139,11 +160,6 @@ namespace threepp {
             return *this;
         }
 
-        void setCallback(std::function<void()> f) {
-
-            f_ = std::move(f);
-        }
-
         friend std::ostream& operator<<(std::ostream& os, const float_view& f) {
             os << f.value_;
             return os;
@@ -151,7 +167,7 @@ namespace threepp {
 
     private:
         float value_;
-        std::optional<std::function<void()>> f_;
+        const Listener* listener_ = nullptr;
 
         friend class Euler;
         friend class Quaternion;
@@ -0,0 +1,115 @@
+
+#ifndef THREEPP_BATCHEDMESH_HPP
+#define THREEPP_BATCHEDMESH_HPP
+
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/textures/DataTexture.hpp"
+
+#include <memory>
+
+namespace threepp {
+
+    class Camera;
+
+    // Draws many different geometries sharing one material with a single draw call.
+    // The geometries are copied into one geometry, and each of them keeps its own matrix and visibility.
+    // When all copies share the same geometry, InstancedMesh is the better fit.
+    class BatchedMesh: public Mesh {
+
+    public:
+        // Skips geometries outside the camera frustum when drawing.
+        bool perObjectFrustumCulled = true;
+
+        std::optional<Sphere> boundingSphere;
+        std::optional<Box3> boundingBox;
+
+        BatchedMesh(size_t maxGeometryCount, size_t maxVertexCount, size_t maxIndexCount = 0, std::shared_ptr<Material> material = nullptr);
+
+        [[nodiscard]] std::string type() const override;
+
+        [[nodiscard]] size_t maxGeometryCount() const;
+
+        // Number of geometries added so far, deleted ones included.
+        [[nodiscard]] size_t geometryCount() const;
+
+        // Copies geometry into the batch and returns its id.
+        // All geometries need the same attributes as the first one, and need an index if (and only if) it had one.
+        size_t addGeometry(const BufferGeometry& geometry);
+
+        // Stops drawing the geometry. Its space in the batch is not reused.
+        void deleteGeometry(size_t id);
+
+        void setMatrixAt(size_t id, const Matrix4& matrix);
+
+        void getMatrixAt(size_t id, Matrix4& matrix) const;
+
+        void setVisibleAt(size_t id, bool visible);
+
+        [[nodiscard]] bool getVisibleAt(size_t id) const;
+
+        // Bounds of a geometry, without its matrix applied. Empty if its positions are not float.
+        [[nodiscard]] const Box3& getBoundingBoxAt(size_t id) const;
+
+        [[nodiscard]] const Sphere& getBoundingSphereAt(size_t id) const;
+
+        void computeBoundingBox();
+
+        void computeBoundingSphere();
+
+        // The matrices of all geometries, laid out as Skeleton::boneTexture.
+        [[nodiscard]] DataTexture* matricesTexture() const;
+
+        [[nodiscard]] int matricesTextureSize() const;
+
+        // Index ranges (vertex ranges when not indexed) of the geometries to draw for camera, with adjacent ranges merged.
+        void getDrawRanges(const Camera& camera, std::vector<int>& starts, std::vector<int>& counts) const;
+
+        void raycast(const Raycaster& raycaster, std::vector<Intersection>& intersects) override;
+
+        static std::shared_ptr<BatchedMesh> create(
+                size_t maxGeometryCount,
+                size_t maxVertexCount,
+                size_t maxIndexCount = 0,
+                std::shared_ptr<Material> material = nullptr);
+
+        ~BatchedMesh() override;
+
+    private:
+        struct Item {
+
+            int vertexStart = 0;
+            int vertexCount = 0;
+            int indexStart = 0;
+            int indexCount = 0;
+
+            Box3 box;
+            Sphere sphere;
+
+            bool visible = true;
+            bool active = true;
+        };
+
+        size_t maxGeometryCount_;
+        size_t maxVertexCount_;
+        size_t maxIndexCount_;
+
+        int vertexCount_ = 0;
+        int indexCount_ = 0;
+
+        std::vector<Item> items_;
+
+        std::shared_ptr<DataTexture> matricesTexture_;
+        int matricesTextureSize_;
+
+        // stands in for one geometry at a time when raycasting, created on first use
+        std::unique_ptr<Mesh> _mesh;
+        std::vector<Intersection> _itemIntersects;
+
+        void reserve(const BufferGeometry& geometry);
+
+        void checkId(size_t id) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_BATCHEDMESH_HPP
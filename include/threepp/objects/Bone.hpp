@@ -9,6 +9,11 @@ namespace threepp {
     class Bone: public Object3D {
 
     public:
+        Bone() {
+
+            addKind(this);
+        }
+
         [[nodiscard]] std::string type() const override {
 
             return "Bone";
@@ -10,6 +10,8 @@ namespace threepp {
     class Group: public Object3D {
 
     public:
+        Group();
+
         [[nodiscard]] std::string type() const override;
 
         static std::shared_ptr<Group> create();
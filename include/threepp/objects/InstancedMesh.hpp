@@ -9,12 +9,34 @@
 
 namespace threepp {
 
+    class Camera;
+    class ThreadPool;
+
     class InstancedMesh: public Mesh {
 
     public:
+        // A geometry used for the instances at least distance away from the camera.
+        struct Level {
+
+            std::shared_ptr<BufferGeometry> geometry;
+            float distance;
+        };
+
+        // Instances [start, start + count) of visibleInstanceMatrix, drawn with geometry (nullptr for the geometry of the mesh).
+        struct InstanceRange {
+
+            BufferGeometry* geometry;
+            int start;
+            int count;
+        };
+
         std::optional<Sphere> boundingSphere;
         std::optional<Box3> boundingBox;
 
+        // Opt-in: tests every instance against the camera frustum before drawing,
+        // and uploads only the matrices (and colors) of the visible ones.
+        bool perInstanceFrustumCulled = false;
+
         InstancedMesh(
                 std::shared_ptr<BufferGeometry> geometry,
                 std::shared_ptr<Material> material,
@@ -36,7 +58,30 @@ namespace threepp {
 
         void setColorAt(size_t index, const Color& color);
 
-        void setMatrixAt(size_t index, const Matrix4& matrix) const;
+        void setMatrixAt(size_t index, const Matrix4& matrix);
+
+        // Adds a level of detail, which enables the per instance pipeline as for perInstanceFrustumCulled.
+        // The geometry of the mesh is level 0, used up to the nearest added distance.
+        void addLevel(std::shared_ptr<BufferGeometry> geometry, float distance);
+
+        [[nodiscard]] const std::vector<Level>& levels() const;
+
+        // Whether instances are culled and sorted into levels before drawing, see updateVisibleInstances.
+        [[nodiscard]] bool hasVisibilityPipeline() const;
+
+        // Tests the instances against the frustum of camera (in batches, spread over pool when given),
+        // picks the level of each visible instance and compacts their matrices and colors level by level.
+        // Returns the range of compacted instances per level. Results are kept per camera (for a few cameras, such as
+        // the view and shadow cameras of a frame), and nothing is redone while camera, mesh and instances are unchanged.
+        const std::vector<InstanceRange>& updateVisibleInstances(const Camera& camera, ThreadPool* pool = nullptr);
+
+        // The compacted instances of the camera last passed to updateVisibleInstances.
+        [[nodiscard]] FloatBufferAttribute* visibleInstanceMatrix() const;
+
+        [[nodiscard]] FloatBufferAttribute* visibleInstanceColor() const;
+
+        // The compacted matrices and colors of every camera, for releasing their GPU buffers.
+        [[nodiscard]] std::vector<FloatBufferAttribute*> visibleInstanceBuffers() const;
 
         void computeBoundingBox();
 
@@ -70,6 +115,41 @@ namespace threepp {
         Box3 _box3;
 
         std::vector<Intersection> _instanceIntersects;
+
+        std::vector<Level> levels_;
+        std::vector<int8_t> instanceLevels_;// per instance, -1 when culled
+
+        struct VisibilityKey {
+
+            Matrix4 projScreenMatrix;
+            Matrix4 matrixWorld;
+            unsigned int matrixVersion;
+            unsigned int colorVersion;
+            size_t count;
+            size_t numLevels;
+
+            bool operator==(const VisibilityKey&) const = default;
+        };
+
+        // The visible instances for one camera. Entries are reused, not freed, so that the renderer never
+        // sees a new buffer at the address of one it has uploaded.
+        struct Visibility {
+
+            unsigned int cameraId;
+            size_t lastUse;
+            std::optional<VisibilityKey> key;
+            std::vector<InstanceRange> ranges;
+            std::unique_ptr<FloatBufferAttribute> matrix;
+            std::unique_ptr<FloatBufferAttribute> color;
+        };
+
+        std::vector<Visibility> visibilities_;
+        Visibility* currentVisibility_ = nullptr;
+        size_t visibilityUses_ = 0;
+
+        Visibility& visibilityFor(const Camera& camera);
+
+        void invalidateVisibility();
     };
 
 }// namespace threepp
@@ -11,6 +11,11 @@ namespace threepp {
     class ObjectWithMorphTargetInfluences: public virtual Object3D {
 
     public:
+        ObjectWithMorphTargetInfluences() {
+
+            addKind(this);
+        }
+
         std::vector<float>& morphTargetInfluences() {
 
             if (copyMorphTargetInfluences_) {
@@ -97,7 +97,7 @@ namespace threepp {
                 }
             }
 
-            return result.premultiply(*matrix);
+            return result.premultiply(matrix);
         }
 
         void finalize() {
@@ -34,6 +34,11 @@ namespace threepp {
 
         void updateMatrixWorld(bool force) override;
 
+        [[nodiscard]] bool hasCustomMatrixWorldUpdate() const override {
+
+            return true;
+        }
+
         void boneTransform(size_t index, Vector3& target);
 
         static std::shared_ptr<SkinnedMesh> create(const std::shared_ptr<BufferGeometry>& geometry, const std::shared_ptr<Material>& material) {
@@ -17,6 +17,8 @@
 #include "threepp/renderers/gl/GLShadowMap.hpp"
 #include "threepp/renderers/gl/GLState.hpp"
 
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -52,6 +54,12 @@ namespace threepp {
 
         bool sortObjects = true;
 
+        // Cull and project the scene graph on a pool of worker threads, which also cull large instanced meshes
+        // and assign clustered lights.
+        // Produces the same render lists as the serial traversal, GL resources are still updated on the calling thread.
+        // No threads are started while this is false.
+        bool parallelProjection = false;
+
         // user-defined clipping
 
         std::vector<Plane> clippingPlanes;
@@ -66,6 +74,11 @@ namespace threepp {
 
         bool physicallyCorrectLights = false;
 
+        // Shade point and spot lights that cast no shadow through a per-frame grid of view space clusters,
+        // so each fragment only loops over the lights that reach it, and adding or removing lights never recompiles programs.
+        // Applies to materials lit per fragment (Phong, Toon, Standard and Physical), other lit materials loop over every light.
+        bool clusteredLighting = false;
+
         // tone mapping
 
         ToneMapping toneMapping{ToneMapping::None};
@@ -73,6 +86,22 @@ namespace threepp {
 
         bool checkShaderErrors = false;
 
+        // Share camera, light and fog uniforms between programs through std140 uniform buffers, uploaded once per frame.
+        // RawShaderMaterial always uses plain uniforms.
+        bool uniformBlocks = true;
+
+        // Re-specify the storage of Dynamic and Stream attributes when most of them changes (buffer orphaning),
+        // instead of updating in place and waiting for the GPU to finish reading the previous contents.
+        bool streamingUploads = false;
+
+        // Pack the vertex and index data of Static attributes into a few large shared buffers, rather than one buffer each,
+        // which avoids fragmenting driver memory with thousands of small buffers.
+        bool packStaticBuffers = false;
+
+        // Directory used to store linked program binaries between runs, so that shaders are not compiled from source again.
+        // Disabled when empty, or when the driver does not support program binaries. See info().programs for hit/miss counts.
+        std::filesystem::path programBinaryCacheDirectory;
+
         explicit GLRenderer(WindowSize size = {}, const Parameters& parameters = {});
 
         GLRenderer(GLRenderer&&) = delete;
@@ -136,6 +165,14 @@ namespace threepp {
 
         void dispose();
 
+        // Builds the programs needed to render scene with camera up front, instead of on first use.
+        void compile(Object3D& scene, Camera& camera);
+
+        // Like compile, but only issues the compile and link commands. Programs finish linking in the background
+        // (polled without blocking when GL_KHR_parallel_shader_compile is available) and objects using them are skipped until then.
+        // onReady is invoked from render() once every program requested by this call is ready.
+        void compileAsync(Object3D& scene, Camera& camera, const std::function<void()>& onReady = nullptr);
+
         void render(Object3D& scene, Camera& camera);
 
         void renderBufferDirect(Camera* camera, Scene* scene, BufferGeometry* geometry, Material* material, Object3D* object, std::optional<GeometryGroup> group);
@@ -34,11 +34,26 @@ namespace threepp::gl {
         }
     };
 
+    struct ProgramInfo {
+
+        // see GLRenderer::programBinaryCacheDirectory
+        size_t binaryCacheHits{0};
+        size_t binaryCacheMisses{0};
+        // binaries found on disk, but rejected by the driver (counted as misses too)
+        size_t binaryCacheRejected{0};
+
+        friend std::ostream& operator<<(std::ostream& os, const ProgramInfo& m) {
+            os << "ProgramInfo: binaryCacheHits=" << m.binaryCacheHits << ", binaryCacheMisses=" << m.binaryCacheMisses << ", binaryCacheRejected=" << m.binaryCacheRejected;
+            return os;
+        }
+    };
+
     class GLInfo {
 
     public:
         MemoryInfo memory{};
         RenderInfo render{};
+        ProgramInfo programs{};
 
         bool autoReset = true;
 
@@ -48,7 +63,8 @@ namespace threepp::gl {
 
         friend std::ostream& operator<<(std::ostream& os, const GLInfo& m) {
             os << m.memory << "\n"
-               << m.render;
+               << m.render << "\n"
+               << m.programs;
             return os;
         }
     };
@@ -18,6 +18,7 @@ namespace threepp {
     namespace gl {
 
         class GLObjects;
+        class GLProperties;
 
         struct GLShadowMap {
 
@@ -28,7 +29,7 @@ namespace threepp {
 
             ShadowMap type;
 
-            explicit GLShadowMap(GLObjects& objects);
+            GLShadowMap(GLObjects& objects, GLProperties& properties);
 
             void render(GLRenderer& renderer, const std::vector<Light*>& lights, Object3D* scene, Camera* camera);
 
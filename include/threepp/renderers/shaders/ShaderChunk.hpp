@@ -3,6 +3,7 @@
 #ifndef THREEPP_SHADERCHUNK_HPP
 #define THREEPP_SHADERCHUNK_HPP
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -44,6 +45,14 @@ namespace threepp::shaders {
             return get("aomap_pars_fragment");
         }
 
+        const std::string& batching_pars_vertex() {
+            return get("batching_pars_vertex");
+        }
+
+        const std::string& batching_vertex() {
+            return get("batching_vertex");
+        }
+
         const std::string& begin_vertex() {
             return get("begin_vertex");
         }
@@ -544,6 +553,18 @@ namespace threepp::shaders {
             return data_.at(key);
         }
 
+        // Changes whenever the content of any chunk does.
+        [[nodiscard]] size_t fingerprint() const {
+
+            size_t h = data_.size();
+            for (const auto& [key, value] : data_) {
+
+                h += std::hash<std::string>{}(key) * 31 + std::hash<std::string>{}(value);
+            }
+
+            return h;
+        }
+
         static ShaderChunk& instance() {
             static ShaderChunk instance;
             return instance;
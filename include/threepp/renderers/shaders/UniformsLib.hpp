@@ -80,6 +80,7 @@ namespace threepp::shaders {
                 {"directionalLightShadows", Uniform()},
                 {"directionalShadowMap", Uniform()},
                 {"directionalShadowMatrix", Uniform()},
+                {"directionalShadowCascadeMatrix", Uniform()},
                 {"spotLights", Uniform()},
                 {"spotLightShadows", Uniform()},
                 {"spotShadowMap", Uniform()},
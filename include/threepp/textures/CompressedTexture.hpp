@@ -0,0 +1,38 @@
+// https://github.com/mrdoob/three.js/blob/r129/src/textures/CompressedTexture.js
+
+#ifndef THREEPP_COMPRESSEDTEXTURE_HPP
+#define THREEPP_COMPRESSEDTEXTURE_HPP
+
+#include "threepp/textures/Texture.hpp"
+
+namespace threepp {
+
+    // A texture whose levels are blocks of a compressed format, uploaded as is.
+    // Mipmaps can't be generated, so every level to be used must be in mipmaps(), level 0 first.
+    class CompressedTexture: public Texture {
+
+    public:
+        static std::shared_ptr<CompressedTexture> create(
+                std::vector<Image> mipmaps,
+                unsigned int width, unsigned int height,
+                Format format) {
+
+            return std::shared_ptr<CompressedTexture>(new CompressedTexture(std::move(mipmaps), width, height, format));
+        }
+
+    private:
+        CompressedTexture(std::vector<Image> mipmaps, unsigned int width, unsigned int height, Format format)
+            : Texture({Image({}, width, height, false)}) {
+
+            this->mipmaps() = std::move(mipmaps);
+            this->format = format;
+
+            this->generateMipmaps = false;
+
+            this->needsUpdate();
+        }
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_COMPRESSEDTEXTURE_HPP
@@ -2,6 +2,10 @@
 #ifndef THREEPP_IMAGE_HPP
 #define THREEPP_IMAGE_HPP
 
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -23,6 +27,18 @@ namespace threepp {
         Image(ImageData data, unsigned int width, unsigned int height, unsigned int depth, bool flipped = true)
             : width(width), height(height), depth(depth), flipped_(flipped), data_(std::move(data)){};
 
+        // Adopts count elements of pixel memory allocated elsewhere (a decoder, a mapped file, a user buffer) without copying them.
+        // deleter(pixels) is called once this image and every copy of it have let go of the memory.
+        template<class T, class Deleter>
+        static Image adopt(T* pixels, size_t count, unsigned int width, unsigned int height, Deleter deleter, bool flipped = true) {
+
+            Image image({}, width, height, flipped);
+            image.adopted_ = std::shared_ptr<void>(pixels, std::move(deleter));
+            image.adoptedSize_ = count * sizeof(T);
+
+            return image;
+        }
+
         [[nodiscard]] bool flipped() const {
 
             return flipped_;
@@ -31,17 +47,79 @@ namespace threepp {
         void setData(ImageData data) {
 
             data_ = std::move(data);
+            adopted_.reset();
+            adoptedSize_ = 0;
         }
 
+        // Only for images holding their pixels in a vector, see adopted(). Throws for adopted memory (e.g. images from ImageLoader),
+        // use view() to read or write the pixels of any image, or setData() to give it a vector of its own.
         template<class T = unsigned char>
         [[nodiscard]] std::vector<T>& data() {
 
+            if (adopted_) throw std::runtime_error("[Image] Pixel memory is adopted, use view() or pixels() instead");
+
             return std::get<std::vector<T>>(data_);
         }
 
+        // The pixels as elements of T, whoever owns them. T must be the element type the image was created with.
+        template<class T = unsigned char>
+        [[nodiscard]] std::span<const T> view() const {
+
+            if (!adopted_) {
+
+                const auto& data = std::get<std::vector<T>>(data_);
+                return {data.data(), data.size()};
+            }
+
+            return {static_cast<const T*>(adopted_.get()), adoptedSize_ / sizeof(T)};
+        }
+
+        template<class T = unsigned char>
+        [[nodiscard]] std::span<T> view() {
+
+            const auto view = std::as_const(*this).view<T>();
+            return {const_cast<T*>(view.data()), view.size()};
+        }
+
+        [[nodiscard]] bool adopted() const {
+
+            return adopted_ != nullptr;
+        }
+
+        // Start of the pixel memory, whoever owns it. Null when there are no pixels.
+        [[nodiscard]] const void* pixels() const {
+
+            if (adopted_) return adopted_.get();
+
+            return std::visit([](const auto& data) -> const void* { return data.empty() ? nullptr : data.data(); }, data_);
+        }
+
+        [[nodiscard]] void* pixels() {
+
+            return const_cast<void*>(std::as_const(*this).pixels());
+        }
+
+        [[nodiscard]] size_t byteSize() const {
+
+            if (adopted_) return adoptedSize_;
+
+            return std::visit([](const auto& data) { return data.size() * sizeof(data.front()); }, data_);
+        }
+
+        // Frees the pixel memory, keeping the size of the image and the type of its data.
+        void releaseData() {
+
+            adopted_.reset();
+            adoptedSize_ = 0;
+            std::visit([](auto& data) { data = std::decay_t<decltype(data)>(); }, data_);
+        }
+
     private:
         bool flipped_;
         ImageData data_;
+
+        std::shared_ptr<void> adopted_;
+        size_t adoptedSize_ = 0;
     };
 
 }// namespace threepp
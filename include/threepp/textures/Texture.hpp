@@ -58,6 +58,10 @@ namespace threepp {
         // update. You need to explicitly call Material.needsUpdate to trigger it to recompile.
         Encoding encoding{Encoding::Linear};
 
+        // Frees the pixels of images and mipmaps once uploaded, leaving the GPU with the only copy.
+        // Updating such a texture again uploads undefined contents unless new data is set first.
+        bool releaseDataAfterUpload = false;
+
         Texture(const Texture&) = delete;
         Texture& operator=(const Texture&) = delete;
         Texture(Texture&&) = delete;
@@ -99,6 +103,8 @@ namespace threepp {
 
         static std::shared_ptr<Texture> create(const Image& image);
 
+        static std::shared_ptr<Texture> create(Image&& image);
+
         static std::shared_ptr<Texture> create(std::vector<Image> image);
 
     protected:
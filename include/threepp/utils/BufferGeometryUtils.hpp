@@ -4,6 +4,7 @@
 #define THREEPP_BUFFERGEOMETRYUTILS_HPP
 
 #include "threepp/core/BufferGeometry.hpp"
+#include "threepp/math/Matrix4.hpp"
 
 #include <vector>
 
@@ -13,6 +14,17 @@ namespace threepp {
 
     std::shared_ptr<BufferGeometry> mergeBufferGeometries(const std::vector<std::shared_ptr<BufferGeometry>>& geometries, bool useGroups = false);
 
+    // Replaces the float position attribute with normalized unsigned integers of the given bit depth (8 or 16)
+    // spanning the bounding box of the geometry, using one scale for all axes so that normals are unaffected.
+    // Bounding volumes are recomputed in the quantized space.
+    // Returns the dequantization matrix, which must be applied to the right of the object's transform
+    // (for an object without a transform of its own: object.applyMatrix4(matrix)).
+    Matrix4 quantizePositions(BufferGeometry& geometry, int bits = 16);
+
+    // Replaces the float normal attribute with a two component, octahedral encoded, normalized signed integer attribute
+    // of the given bit depth (8 or 16). Such normals are decoded by the built-in shaders.
+    void encodeNormalsOctahedral(BufferGeometry& geometry, int bits = 16);
+
 
 }// namespace threepp
 
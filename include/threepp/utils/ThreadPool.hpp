@@ -0,0 +1,41 @@
+
+#ifndef THREEPP_THREADPOOL_HPP
+#define THREEPP_THREADPOOL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace threepp {
+
+    // A fixed set of worker threads used to spread CPU-bound work (culling, transforms, decoding) across cores.
+    class ThreadPool {
+
+    public:
+        // numThreads == 0 uses std::thread::hardware_concurrency()
+        explicit ThreadPool(unsigned int numThreads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Number of threads that take part in parallelFor, including the calling thread.
+        [[nodiscard]] size_t size() const;
+
+        // Invokes fn(i) for every i in [0, count) and returns once all invocations have completed.
+        // The calling thread takes part in the work.
+        void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+        // Queues fn to run on a worker thread and returns at once. Tasks still queued when the pool is destroyed are discarded.
+        // Without worker threads (size() == 1), fn runs on the calling thread before submit returns.
+        void submit(std::function<void()> fn);
+
+        ~ThreadPool();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_THREADPOOL_HPP
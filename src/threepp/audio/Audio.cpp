@@ -76,7 +76,7 @@ void AudioListener::setMasterVolume(float volume) {
 void AudioListener::updateMatrixWorld(bool force) {
     Object3D::updateMatrixWorld(force);
 
-    matrixWorld->decompose(_pos, _quat, _scale);
+    matrixWorld.decompose(_pos, _quat, _scale);
 
     _orientation.set(0, 0, -1).applyQuaternion(_quat);
 
@@ -150,7 +150,7 @@ PositionalAudio::PositionalAudio(AudioListener& ctx, const std::filesystem::path
 void PositionalAudio::updateMatrixWorld(bool force) {
     Object3D::updateMatrixWorld(force);
 
-    matrixWorld->decompose(_pos, _quat, scale);
+    matrixWorld.decompose(_pos, _quat, scale);
 
     _orientation.set(0, 0, -1).applyQuaternion(_quat);
 
@@ -5,7 +5,10 @@ using namespace threepp;
 
 
 Camera::Camera(float near, float far)
-    : near(near), far(far) {}
+    : near(near), far(far) {
+
+    addKind(this);
+}
 
 void Camera::getWorldDirection(Vector3& target) {
 
@@ -17,12 +20,12 @@ void Camera::updateMatrixWorld(bool force) {
 
     Object3D::updateMatrixWorld(force);
 
-    this->matrixWorldInverse.copy(*this->matrixWorld).invert();
+    this->matrixWorldInverse.copy(this->matrixWorld).invert();
 }
 
 void Camera::updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) {
 
     Object3D::updateWorldMatrix(updateParents, updateChildren);
 
-    this->matrixWorldInverse.copy(*this->matrixWorld).invert();
+    this->matrixWorldInverse.copy(this->matrixWorld).invert();
 }
@@ -6,6 +6,8 @@ using namespace threepp;
 OrthographicCamera::OrthographicCamera(float left, float right, float top, float bottom, float near, float far)
     : Camera(near, far), left(left), right(right), top(top), bottom(bottom) {
 
+    addKind(this);
+
     OrthographicCamera::updateProjectionMatrix();
 }
 
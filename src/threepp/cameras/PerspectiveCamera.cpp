@@ -11,6 +11,8 @@ using namespace threepp;
 PerspectiveCamera::PerspectiveCamera(float fov, float aspect, float near, float far)
     : Camera(near, far), fov(fov), aspect(aspect) {
 
+    addKind(this);
+
     PerspectiveCamera::updateProjectionMatrix();
 }
 
@@ -53,7 +53,7 @@ namespace {
             GLFWimage images[1];
             images[0] = {static_cast<int>(favicon->width),
                          static_cast<int>(favicon->height),
-                         favicon->data().data()};
+                         static_cast<unsigned char*>(favicon->pixels())};
             glfwSetWindowIcon(window, 1, images);
         }
     }
@@ -185,7 +185,7 @@ struct Canvas::Impl {
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
         glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-        // glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_VISIBLE, params.visible_);
         glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
         glfwWindowHint(GLFW_RESIZABLE, params.resizable_);
         glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, GLFW_TRUE);
@@ -444,6 +444,11 @@ Canvas::Parameters::Parameters(const std::unordered_map<std::string, ParameterVa
             resizable(std::get<bool>(value));
             used = true;
 
+        } else if (key == "visible") {
+
+            visible(std::get<bool>(value));
+            used = true;
+
         } else if (key == "size") {
 
             auto _size = std::get<WindowSize>(value);
@@ -513,6 +518,13 @@ Canvas::Parameters& Canvas::Parameters::resizable(bool flag) {
     return *this;
 }
 
+Canvas::Parameters& Canvas::Parameters::visible(bool flag) {
+
+    this->visible_ = flag;
+
+    return *this;
+}
+
 Canvas::Parameters& Canvas::Parameters::favicon(const std::filesystem::path& path) {
 
     if (std::filesystem::exists(path)) {
@@ -76,7 +76,7 @@ struct DragControls::Impl: public MouseListener {
 
                 Vector3 worldDir = _plane.normal;
                 _camera->getWorldDirection(worldDir);
-                _plane.setFromNormalAndCoplanarPoint(worldDir, _worldPosition.setFromMatrixPosition(*object->matrixWorld));
+                _plane.setFromNormalAndCoplanarPoint(worldDir, _worldPosition.setFromMatrixPosition(object->matrixWorld));
 
                 if (_hovered && _hovered != object) {
 
@@ -130,15 +130,15 @@ struct DragControls::Impl: public MouseListener {
 
             Vector3 worldDir = _plane.normal;
             _camera->getWorldDirection(worldDir);
-            _plane.setFromNormalAndCoplanarPoint(worldDir, _worldPosition.setFromMatrixPosition(*_selected->matrixWorld));
+            _plane.setFromNormalAndCoplanarPoint(worldDir, _worldPosition.setFromMatrixPosition(_selected->matrixWorld));
 
             _raycaster.ray.intersectPlane(_plane, _intersection);
             if (!_intersection.isNan()) {
 
                 if (scope->mode == Mode::Translate) {
 
-                    _inverseMatrix.copy(*_selected->parent->matrixWorld).invert();
-                    _offset.copy(_intersection).sub(_worldPosition.setFromMatrixPosition(*_selected->matrixWorld));
+                    _inverseMatrix.copy(_selected->parent->matrixWorld).invert();
+                    _offset.copy(_intersection).sub(_worldPosition.setFromMatrixPosition(_selected->matrixWorld));
 
                 } else {
 
@@ -230,8 +230,8 @@ struct OrbitControls::Impl {
 
             // we use only clientHeight here so aspect ratio does not distort speed
             const auto size = canvas.size();
-            panLeft(2 * deltaX * targetDistance / static_cast<float>(size.height()), *this->camera.matrix);
-            panUp(2 * deltaY * targetDistance / static_cast<float>(size.height()), *this->camera.matrix);
+            panLeft(2 * deltaX * targetDistance / static_cast<float>(size.height()), this->camera.matrix);
+            panUp(2 * deltaY * targetDistance / static_cast<float>(size.height()), this->camera.matrix);
         } else if (auto ortho = camera.as<OrthographicCamera>()) {
 
             const auto size = canvas.size();
@@ -239,10 +239,10 @@ struct OrbitControls::Impl {
             // orthographic
             panLeft(
                     deltaX * (ortho->right - ortho->left) / this->camera.zoom / static_cast<float>(size.width()),
-                    *this->camera.matrix);
+                    this->camera.matrix);
             panUp(
                     deltaY * (ortho->top - ortho->bottom) / this->camera.zoom / static_cast<float>(size.height()),
-                    *this->camera.matrix);
+                    this->camera.matrix);
 
         } else {
 
@@ -13,7 +13,7 @@ using namespace threepp;
 
 namespace {
 
-    std::unique_ptr<BufferAttribute> convertBufferAttribute(BufferAttribute& _attribute, const std::vector<unsigned int>& indices) {
+    std::unique_ptr<BufferAttribute> convertBufferAttribute(BufferAttribute& _attribute, const IndexBufferAttribute& indices) {
 
         if (_attribute.typed<float>()) {
 
@@ -23,13 +23,13 @@ namespace {
             const auto itemSize = attribute->itemSize();
             const auto normalized = attribute->normalized();
 
-            auto array2 = std::vector<float>(indices.size() * itemSize);
+            auto array2 = std::vector<float>(indices.count() * itemSize);
 
             unsigned index = 0, index2 = 0;
 
-            for (unsigned i = 0, l = indices.size(); i < l; i++) {
+            for (unsigned i = 0, l = indices.count(); i < l; i++) {
 
-                index = indices[i] * itemSize;
+                index = indices.getX(i) * itemSize;
 
                 for (auto j = 0; j < itemSize; j++) {
 
@@ -53,19 +53,24 @@ std::string BufferGeometry::type() const {
     return "BufferGeometry";
 }
 
+bool BufferGeometry::isInstanced() const {
+
+    return instanced_;
+}
+
 bool BufferGeometry::hasIndex() const {
 
     return index_ != nullptr;
 }
 
-IntBufferAttribute* BufferGeometry::getIndex() {
+IndexBufferAttribute* BufferGeometry::getIndex() {
 
     if (!index_) return nullptr;
 
     return this->index_.get();
 }
 
-const IntBufferAttribute* BufferGeometry::getIndex() const {
+const IndexBufferAttribute* BufferGeometry::getIndex() const {
 
     if (!index_) return nullptr;
 
@@ -104,6 +109,7 @@ const std::unordered_map<std::string, std::vector<std::shared_ptr<BufferAttribut
 void BufferGeometry::setAttribute(const std::string& name, std::shared_ptr<BufferAttribute> attribute) {
 
     attributes_[name] = std::move(attribute);
+    ++attributesVersion_;
 }
 
 void BufferGeometry::deleteAttribute(const std::string& name) {
@@ -111,6 +117,7 @@ void BufferGeometry::deleteAttribute(const std::string& name) {
     if (attributes_.count(name)) {
 
         attributes_.erase(name);
+        ++attributesVersion_;
     }
 }
 
@@ -119,6 +126,11 @@ bool BufferGeometry::hasAttribute(const std::string& name) const {
     return attributes_.contains(name);
 }
 
+unsigned int BufferGeometry::attributesVersion() const {
+
+    return attributesVersion_;
+}
+
 void BufferGeometry::addGroup(int start, int count, unsigned int materialIndex) {
 
     groups.emplace_back(GeometryGroup{start, count, materialIndex});
@@ -459,6 +471,7 @@ void BufferGeometry::copy(const BufferGeometry& source) {
 
     this->index_ = nullptr;
     this->attributes_.clear();
+    ++this->attributesVersion_;
     this->groups.clear();
     this->boundingBox = std::nullopt;
     this->boundingSphere = std::nullopt;
@@ -533,7 +546,7 @@ std::shared_ptr<BufferGeometry> BufferGeometry::toNonIndexed() const {
 
     auto geometry2 = BufferGeometry::create();
 
-    const auto& indices = this->index_->array();
+    const auto& indices = *this->index_;
     const auto& attributes = this->attributes_;
 
     // attributes
@@ -0,0 +1,59 @@
+
+#include "threepp/core/InstancedBufferGeometry.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace threepp;
+
+
+InstancedBufferGeometry::InstancedBufferGeometry() {
+
+    instanced_ = true;
+}
+
+std::string InstancedBufferGeometry::type() const {
+
+    return "InstancedBufferGeometry";
+}
+
+int InstancedBufferGeometry::maxInstanceCount() const {
+
+    if (countedVersion_ != attributesVersion()) {
+
+        countedVersion_ = attributesVersion();
+        attributeInstanceCount_.reset();
+
+        long long maxInstanceCount = std::numeric_limits<int>::max();
+
+        for (const auto& [name, attribute] : getAttributes()) {
+
+            if (attribute->meshPerAttribute() > 0) {
+
+                maxInstanceCount = std::min(maxInstanceCount, static_cast<long long>(attribute->meshPerAttribute()) * attribute->count());
+                attributeInstanceCount_ = static_cast<int>(maxInstanceCount);
+            }
+        }
+    }
+
+    return attributeInstanceCount_.value_or(instanceCount);
+}
+
+int InstancedBufferGeometry::drawInstanceCount() const {
+
+    const auto maxInstanceCount = this->maxInstanceCount();
+
+    return instanceCount > 0 ? std::min(instanceCount, maxInstanceCount) : maxInstanceCount;
+}
+
+void InstancedBufferGeometry::copy(const InstancedBufferGeometry& source) {
+
+    BufferGeometry::copy(source);
+
+    this->instanceCount = source.instanceCount;
+}
+
+std::shared_ptr<InstancedBufferGeometry> InstancedBufferGeometry::create() {
+
+    return std::make_shared<InstancedBufferGeometry>();
+}
@@ -14,17 +14,16 @@
 
 using namespace threepp;
 
-Object3D::Object3D()
-    : uuid(math::generateUUID()),
-      matrix(std::make_shared<Matrix4>()),
-      matrixWorld(std::make_shared<Matrix4>()) {
+Object3D::Object3D() {
 
-    rotation._onChange([this] {
-        quaternion.setFromEuler(rotation, false);
-    });
-    quaternion._onChange([this] {
-        rotation.setFromQuaternion(quaternion, std::nullopt, false);
-    });
+    rotation._onChange([](void* self) {
+        auto object = static_cast<Object3D*>(self);
+        object->quaternion.setFromEuler(object->rotation, false);
+    }, this);
+    quaternion._onChange([](void* self) {
+        auto object = static_cast<Object3D*>(self);
+        object->rotation.setFromQuaternion(object->quaternion, std::nullopt, false);
+    }, this);
 }
 
 std::string Object3D::type() const {
@@ -32,13 +31,20 @@ std::string Object3D::type() const {
     return "Object3D";
 }
 
+const std::string& Object3D::uuid() const {
+
+    if (uuid_.empty()) uuid_ = math::generateUUID();
+
+    return uuid_;
+}
+
 void Object3D::applyMatrix4(const Matrix4& m) {
 
     if (this->matrixAutoUpdate) this->updateMatrix();
 
-    this->matrix->premultiply(m);
+    this->matrix.premultiply(m);
 
-    this->matrix->decompose(this->position, this->quaternion, this->scale);
+    this->matrix.decompose(this->position, this->quaternion, this->scale);
 }
 
 Object3D& Object3D::applyQuaternion(const Quaternion& q) {
@@ -151,7 +157,7 @@ void Object3D::localToWorld(Vector3& vector) {
 
     this->updateWorldMatrix(true, false);// https://github.com/mrdoob/three.js/pull/25097
 
-    vector.applyMatrix4(*this->matrixWorld);
+    vector.applyMatrix4(this->matrixWorld);
 }
 
 void Object3D::worldToLocal(Vector3& vector) {
@@ -160,7 +166,7 @@ void Object3D::worldToLocal(Vector3& vector) {
 
     Matrix4 _m1{};
 
-    vector.applyMatrix4(_m1.copy(*this->matrixWorld).invert());
+    vector.applyMatrix4(_m1.copy(this->matrixWorld).invert());
 }
 
 void Object3D::lookAt(const Vector3& vector) {
@@ -181,7 +187,7 @@ void Object3D::lookAt(float x, float y, float z) {
 
     this->updateWorldMatrix(true, false);
 
-    _position.setFromMatrixPosition(*this->matrixWorld);
+    _position.setFromMatrixPosition(this->matrixWorld);
 
     if (this->is<Camera>() || this->is<Light>()) {
 
@@ -196,7 +202,7 @@ void Object3D::lookAt(float x, float y, float z) {
 
     if (parent) {
 
-        _m1.extractRotation(*parent->matrixWorld);
+        _m1.extractRotation(parent->matrixWorld);
         _q1.setFromRotationMatrix(_m1);
         this->quaternion.premultiply(_q1.invert());
     }
@@ -218,6 +224,8 @@ void Object3D::add(Object3D& object) {
     object.parent = this;
     this->children.emplace_back(&object);
 
+    if (object.hasStaticShadow()) ++staticShadowVersion_;
+
     object.dispatchEvent("added");
 }
 
@@ -232,6 +240,8 @@ void Object3D::remove(Object3D& object) {
         Object3D* child = *find;
         children.erase(find);
 
+        if (child->hasStaticShadow()) ++staticShadowVersion_;
+
         child->parent = nullptr;
         child->dispatchEvent("remove", child);
     }
@@ -258,6 +268,8 @@ void Object3D::clear() {
 
     for (auto& object : this->children) {
 
+        if (object->hasStaticShadow()) ++staticShadowVersion_;
+
         object->parent = nullptr;
 
         object->dispatchEvent("remove");
@@ -271,7 +283,7 @@ void Object3D::getWorldPosition(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    target.setFromMatrixPosition(*this->matrixWorld);
+    target.setFromMatrixPosition(this->matrixWorld);
 }
 
 void Object3D::getWorldQuaternion(Quaternion& target) {
@@ -281,7 +293,7 @@ void Object3D::getWorldQuaternion(Quaternion& target) {
 
     this->updateWorldMatrix(true, false);
 
-    this->matrixWorld->decompose(_position, target, _scale);
+    this->matrixWorld.decompose(_position, target, _scale);
 }
 
 void Object3D::getWorldScale(Vector3& target) {
@@ -291,14 +303,14 @@ void Object3D::getWorldScale(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    this->matrixWorld->decompose(_position, _quaternion, target);
+    this->matrixWorld.decompose(_position, _quaternion, target);
 }
 
 void Object3D::getWorldDirection(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    const auto& e = this->matrixWorld->elements;
+    const auto& e = this->matrixWorld.elements;
 
     target.set(e[8], e[9], e[10]).normalize();
 }
@@ -337,7 +349,7 @@ void Object3D::traverseAncestors(const std::function<void(Object3D&)>& callback)
 
 void Object3D::updateMatrix() {
 
-    this->matrix->compose(this->position, this->quaternion, this->scale);
+    this->matrix.compose(this->position, this->quaternion, this->scale);
 
     this->matrixWorldNeedsUpdate = true;
 }
@@ -346,15 +358,23 @@ void Object3D::updateMatrixWorld(bool force) {
 
     if (this->matrixAutoUpdate) this->updateMatrix();
 
+    const uint8_t shadowFlags = visible | castShadow << 1 | receiveShadow << 2 | staticShadow << 3;
+    if (shadowFlags != shadowFlags_) {
+
+        // leaves that never were static casters can't hide or show one
+        if (staticShadow || (shadowFlags_ & 8) || !children.empty()) ++staticShadowVersion_;
+        shadowFlags_ = shadowFlags;
+    }
+
     if (this->matrixWorldNeedsUpdate || force) {
 
         if (!this->parent) {
 
-            this->matrixWorld->copy(*this->matrix);
+            this->matrixWorld.copy(this->matrix);
 
         } else {
 
-            this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
+            this->matrixWorld.multiplyMatrices(this->parent->matrixWorld, this->matrix);
         }
 
         this->matrixWorldNeedsUpdate = false;
@@ -370,6 +390,18 @@ void Object3D::updateMatrixWorld(bool force) {
     }
 }
 
+unsigned int Object3D::staticShadowVersion() {
+
+    return staticShadowVersion_;
+}
+
+bool Object3D::hasStaticShadow() const {
+
+    if (staticShadow) return true;
+
+    return std::ranges::any_of(children, [](const auto& child) { return child->hasStaticShadow(); });
+}
+
 void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) {
 
     if (updateParents && updateParents.value() && parent) {
@@ -381,11 +413,11 @@ void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optiona
 
     if (!this->parent) {
 
-        this->matrixWorld->copy(*this->matrix);
+        this->matrixWorld.copy(this->matrix);
 
     } else {
 
-        this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
+        this->matrixWorld.multiplyMatrices(this->parent->matrixWorld, this->matrix);
     }
 
     // update children
@@ -410,8 +442,8 @@ void Object3D::copy(const Object3D& source, bool recursive) {
     this->quaternion.copy(source.quaternion);
     this->scale.copy(source.scale);
 
-    this->matrix->copy(*source.matrix);
-    this->matrixWorld->copy(*source.matrixWorld);
+    this->matrix.copy(source.matrix);
+    this->matrixWorld.copy(source.matrixWorld);
 
     this->matrixAutoUpdate = source.matrixAutoUpdate;
     this->matrixWorldNeedsUpdate = source.matrixWorldNeedsUpdate;
@@ -421,6 +453,7 @@ void Object3D::copy(const Object3D& source, bool recursive) {
 
     this->castShadow = source.castShadow;
     this->receiveShadow = source.receiveShadow;
+    this->staticShadow = source.staticShadow;
 
     this->frustumCulled = source.frustumCulled;
     this->renderOrder = source.renderOrder;
@@ -437,6 +470,9 @@ void Object3D::copy(const Object3D& source, bool recursive) {
 
 Object3D::Object3D(Object3D&& source) noexcept: Object3D() {
 
+    // implicit move constructors of subclasses don't run their addKind calls
+    this->kinds_ = source.kinds_;
+
     this->name = std::move(source.name);
 
     this->up = source.up;
@@ -448,11 +484,13 @@ Object3D::Object3D(Object3D&& source) noexcept: Object3D() {
     this->scale.copy(source.scale);
     this->position.copy(source.position);
 
-    this->rotation = std::move(source.rotation);
-    this->quaternion = std::move(source.quaternion);
+    this->rotation.order_ = source.rotation.order_;
+    this->quaternion.copy(source.quaternion);
 
-    this->matrix = std::move(source.matrix);
-    this->matrixWorld = std::move(source.matrixWorld);
+    this->matrix.copy(source.matrix);
+    this->matrixWorld.copy(source.matrixWorld);
+
+    this->userData = std::move(source.userData);
 
     this->matrixAutoUpdate = source.matrixAutoUpdate;
     this->matrixWorldNeedsUpdate = source.matrixWorldNeedsUpdate;
@@ -462,6 +500,7 @@ Object3D::Object3D(Object3D&& source) noexcept: Object3D() {
 
     this->castShadow = source.castShadow;
     this->receiveShadow = source.receiveShadow;
+    this->staticShadow = source.staticShadow;
 
     this->frustumCulled = source.frustumCulled;
     this->renderOrder = source.renderOrder;
@@ -469,13 +508,6 @@ Object3D::Object3D(Object3D&& source) noexcept: Object3D() {
     this->onAfterRender = std::move(source.onAfterRender);
     this->onBeforeRender = std::move(source.onBeforeRender);
 
-    this->rotation._onChange([this] {
-        quaternion.setFromEuler(rotation, false);
-    });
-    this->quaternion._onChange([this] {
-        rotation.setFromQuaternion(quaternion, std::nullopt, false);
-    });
-
     this->children = std::move(source.children);
     this->children_ = std::move(source.children_);
 
@@ -0,0 +1,286 @@
+
+#include "threepp/core/TransformHierarchy.hpp"
+
+#include "threepp/core/Object3D.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace threepp;
+
+namespace {
+
+    // persistent
+    constexpr uint8_t AUTO_UPDATE = 1 << 0;
+    constexpr uint8_t INITIALIZED = 1 << 1;
+    // reset every update
+    constexpr uint8_t LOCAL_DIRTY = 1 << 2;
+    constexpr uint8_t SELF_DIRTY = 1 << 3;
+    constexpr uint8_t WORLD_DIRTY = 1 << 4;
+
+    constexpr uint8_t PERSISTENT = AUTO_UPDATE | INITIALIZED;
+
+    constexpr size_t grainSize = 1024;
+
+}// namespace
+
+TransformHierarchy::TransformHierarchy(Object3D& root, ThreadPool* pool)
+    : root_(root), pool_(pool) {}
+
+void TransformHierarchy::invalidate() {
+
+    valid_ = false;
+}
+
+size_t TransformHierarchy::size() const {
+
+    return nodes_.size();
+}
+
+size_t TransformHierarchy::numUpdated() const {
+
+    return numUpdated_;
+}
+
+void TransformHierarchy::forEach(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+
+    if (!pool_ || count <= grain) {
+
+        fn(0, count);
+        return;
+    }
+
+    const auto numChunks = (count + grain - 1) / grain;
+    pool_->parallelFor(numChunks, [&](size_t chunk) {
+        fn(chunk * grain, std::min(count, (chunk + 1) * grain));
+    });
+}
+
+void TransformHierarchy::rebuild() {
+
+    nodes_.clear();
+    parents_.clear();
+    children_.clear();
+    childOffsets_.clear();
+    levels_.clear();
+    delegated_.clear();
+
+    std::vector<uint32_t> depths;
+    std::vector<std::pair<Object3D*, int>> stack{{&root_, -1}};
+
+    while (!stack.empty()) {
+
+        auto [object, parent] = stack.back();
+        stack.pop_back();
+
+        if (object->hasCustomMatrixWorldUpdate()) {
+
+            delegated_.emplace_back(object, parent);
+            continue;
+        }
+
+        const auto depth = parent < 0 ? 0 : depths[parent] + 1;
+
+        nodes_.emplace_back(object);
+        parents_.emplace_back(parent);
+        depths.emplace_back(depth);
+
+        childOffsets_.emplace_back(children_.size());
+        children_.insert(children_.end(), object->children.begin(), object->children.end());
+
+        const auto index = static_cast<int>(nodes_.size() - 1);
+        for (auto it = object->children.rbegin(); it != object->children.rend(); ++it) {
+
+            stack.emplace_back(*it, index);
+        }
+    }
+
+    childOffsets_.emplace_back(children_.size());
+
+    for (size_t i = 0; i < nodes_.size(); i++) {
+
+        if (depths[i] >= levels_.size()) levels_.resize(depths[i] + 1);
+        levels_[depths[i]].emplace_back(static_cast<uint32_t>(i));
+    }
+
+    const auto n = nodes_.size();
+    positions_.assign(n, Vector3());
+    quaternions_.assign(n, {0, 0, 0, 1});
+    scales_.assign(n, Vector3(1, 1, 1));
+    localMatrices_.assign(n, Matrix4());
+    worldMatrices_.assign(n, Matrix4());
+    flags_.assign(n, 0);
+
+    valid_ = true;
+}
+
+bool TransformHierarchy::structureChanged() const {
+
+    if (nodes_.empty()) {
+
+        return delegated_.empty() || delegated_.front().first != &root_;
+    }
+
+    // nodes are visited parent first, so a node is only dereferenced after its parent confirmed it is still a child
+
+    for (size_t i = 0; i < nodes_.size(); i++) {
+
+        const auto& children = nodes_[i]->children;
+        const auto begin = childOffsets_[i];
+
+        if (children.size() != childOffsets_[i + 1] - begin) return true;
+
+        for (size_t c = 0; c < children.size(); c++) {
+
+            if (children[c] != children_[begin + c]) return true;
+        }
+    }
+
+    return false;
+}
+
+void TransformHierarchy::update(bool force) {
+
+    if (!valid_ || structureChanged()) rebuild();
+
+    const auto n = nodes_.size();
+
+    // detect local changes
+
+    forEach(n, grainSize, [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) {
+
+            auto object = nodes_[i];
+            auto flags = static_cast<uint8_t>(flags_[i] & PERSISTENT);
+
+            const bool initialized = flags & INITIALIZED;
+            const bool wasAutoUpdate = flags & AUTO_UPDATE;
+
+            if (object->matrixAutoUpdate) {
+
+                const auto& p = object->position;
+                const auto& q = object->quaternion;
+                const auto& s = object->scale;
+
+                auto& cp = positions_[i];
+                auto& cq = quaternions_[i];
+                auto& cs = scales_[i];
+
+                if (!initialized || !wasAutoUpdate ||
+                    cp.x != p.x || cp.y != p.y || cp.z != p.z ||
+                    cq[0] != q.x || cq[1] != q.y || cq[2] != q.z || cq[3] != q.w ||
+                    cs.x != s.x || cs.y != s.y || cs.z != s.z) {
+
+                    cp.copy(p);
+                    cq = {q.x, q.y, q.z, q.w};
+                    cs.copy(s);
+
+                    flags |= LOCAL_DIRTY;
+                }
+
+                flags |= AUTO_UPDATE;
+
+            } else {
+
+                // the local matrix is managed by the user
+                localMatrices_[i].copy(object->matrix);
+
+                flags &= ~AUTO_UPDATE;
+            }
+
+            if (!initialized || force || (flags & LOCAL_DIRTY) || object->matrixWorldNeedsUpdate) {
+
+                flags |= SELF_DIRTY;
+            }
+
+            flags_[i] = static_cast<uint8_t>(flags | INITIALIZED);
+        }
+    });
+
+    bool rootParentChanged = false;
+    if (root_.parent && root_.parent->matrixWorld.elements != rootParentWorld_.elements) {
+
+        rootParentWorld_.copy(root_.parent->matrixWorld);
+        rootParentChanged = true;
+    }
+
+    // recompose and propagate, one level at a time so that parents are always done before their children
+
+    std::atomic<size_t> numUpdated = 0;
+
+    for (const auto& level : levels_) {
+
+        forEach(level.size(), grainSize, [&](size_t begin, size_t end) {
+            size_t count = 0;
+
+            for (auto k = begin; k < end; k++) {
+
+                const auto i = level[k];
+                const auto parent = parents_[i];
+                auto flags = flags_[i];
+
+                if (flags & LOCAL_DIRTY) {
+
+                    const auto& q = quaternions_[i];
+                    localMatrices_[i].compose(positions_[i], Quaternion(q[0], q[1], q[2], q[3]), scales_[i]);
+                }
+
+                const bool parentDirty = parent >= 0 ? (flags_[parent] & WORLD_DIRTY) != 0 : rootParentChanged;
+
+                if ((flags & SELF_DIRTY) || parentDirty) {
+
+                    if (parent >= 0) {
+
+                        worldMatrices_[i].multiplyMatrices(worldMatrices_[parent], localMatrices_[i]);
+
+                    } else if (root_.parent) {
+
+                        worldMatrices_[i].multiplyMatrices(rootParentWorld_, localMatrices_[i]);
+
+                    } else {
+
+                        worldMatrices_[i].copy(localMatrices_[i]);
+                    }
+
+                    flags_[i] = flags | WORLD_DIRTY;
+                    ++count;
+                }
+            }
+
+            numUpdated += count;
+        });
+    }
+
+    numUpdated_ = numUpdated;
+
+    // write back
+
+    forEach(n, grainSize, [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) {
+
+            const auto flags = flags_[i];
+            auto object = nodes_[i];
+
+            if (flags & LOCAL_DIRTY) {
+
+                object->matrix.copy(localMatrices_[i]);
+            }
+
+            if (flags & WORLD_DIRTY) {
+
+                object->matrixWorld.copy(worldMatrices_[i]);
+                object->matrixWorldNeedsUpdate = false;
+            }
+        }
+    });
+
+    // nodes with custom behaviour go through the regular path
+
+    for (const auto& [object, parent] : delegated_) {
+
+        const bool parentDirty = parent >= 0 && (flags_[parent] & WORLD_DIRTY);
+
+        object->updateMatrixWorld(force || parentDirty);
+    }
+}
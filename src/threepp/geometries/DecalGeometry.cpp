@@ -205,10 +205,10 @@ DecalGeometry::DecalGeometry(
     auto pushDecalVertex = [&](std::vector<DecalVertex>& decalVertices, Vector3& vertex, Vector3& normal) {
         // transform the vertex to world space, then to projector space
 
-        vertex.applyMatrix4(*mesh.matrixWorld);
+        vertex.applyMatrix4(mesh.matrixWorld);
         vertex.applyMatrix4(projectorMatrixInverse);
 
-        normal.transformDirection(*mesh.matrixWorld);
+        normal.transformDirection(mesh.matrixWorld);
 
         decalVertices.emplace_back(DecalVertex{vertex, normal});
     };
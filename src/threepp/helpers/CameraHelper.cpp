@@ -99,7 +99,7 @@ struct CameraHelper::Impl {
 
         camera.updateProjectionMatrix();
 
-        scope.matrix = camera.matrixWorld;
+        scope.matrix.copy(camera.matrixWorld);
         scope.matrixAutoUpdate = false;
 
         update();
@@ -187,4 +187,12 @@ void CameraHelper::update() {
     pimpl_->update();
 }
 
+void CameraHelper::updateMatrixWorld(bool force) {
+
+    // follows the camera
+    this->matrix.copy(pimpl_->camera.matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
+}
+
 CameraHelper::~CameraHelper() = default;
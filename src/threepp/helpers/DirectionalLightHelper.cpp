@@ -12,7 +12,7 @@ DirectionalLightHelper::DirectionalLightHelper(DirectionalLight& light, float si
 
     this->light.updateMatrixWorld();
 
-    this->matrix = this->light.matrixWorld;
+    this->matrix.copy(this->light.matrixWorld);
     this->matrixAutoUpdate = false;
 
     auto geometry = BufferGeometry::create();
@@ -47,8 +47,8 @@ void DirectionalLightHelper::update() {
     static Vector3 _v2;
     static Vector3 _v3;
 
-    _v1.setFromMatrixPosition(*this->light.matrixWorld);
-    _v2.setFromMatrixPosition(*this->light.target().matrixWorld);
+    _v1.setFromMatrixPosition(this->light.matrixWorld);
+    _v2.setFromMatrixPosition(this->light.target().matrixWorld);
     _v3.subVectors(_v2, _v1);
 
     this->lightPlane->lookAt(_v2);
@@ -68,6 +68,14 @@ void DirectionalLightHelper::update() {
     this->targetLine->scale.z = _v3.length();
 }
 
+void DirectionalLightHelper::updateMatrixWorld(bool force) {
+
+    // follows the light
+    this->matrix.copy(this->light.matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
+}
+
 std::shared_ptr<DirectionalLightHelper> DirectionalLightHelper::create(DirectionalLight& light, float size, std::optional<Color> color) {
 
     return std::shared_ptr<DirectionalLightHelper>(new DirectionalLightHelper(light, size, color));
@@ -28,7 +28,7 @@ struct HemisphereLightHelper::Impl {
         : light(light), scope(scope) {
 
         this->light.updateMatrixWorld();
-        this->scope.matrix = light.matrixWorld;
+        this->scope.matrix.copy(light.matrixWorld);
         this->scope.matrixAutoUpdate = false;
 
         auto geometry = OctahedronGeometry::create(size);
@@ -76,7 +76,7 @@ struct HemisphereLightHelper::Impl {
             colors->needsUpdate();
         }
 
-        mesh->lookAt(_vector.setFromMatrixPosition(*this->light.matrixWorld).negate());
+        mesh->lookAt(_vector.setFromMatrixPosition(this->light.matrixWorld).negate());
     }
 
     void dispose() {
@@ -100,6 +100,14 @@ void HemisphereLightHelper::update() {
     pimpl_->update();
 }
 
+void HemisphereLightHelper::updateMatrixWorld(bool force) {
+
+    // follows the light
+    this->matrix.copy(pimpl_->light.matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
+}
+
 void HemisphereLightHelper::dispose() {
 
     pimpl_->dispose();
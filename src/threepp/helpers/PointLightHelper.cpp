@@ -21,7 +21,7 @@ PointLightHelper::PointLightHelper(PointLight& light, float sphereSize, std::opt
 
     this->light->updateMatrixWorld();
 
-    this->matrix = this->light->matrixWorld;
+    this->matrix.copy(this->light->matrixWorld);
     this->matrixAutoUpdate = false;
 
     update();
@@ -43,3 +43,11 @@ void PointLightHelper::update() {
         this->material()->as<MaterialWithColor>()->color.copy(this->light->color);
     }
 }
+
+void PointLightHelper::updateMatrixWorld(bool force) {
+
+    // follows the light
+    this->matrix.copy(this->light->matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
+}
@@ -62,7 +62,7 @@ SkeletonHelper::SkeletonHelper(Object3D& object)
     m->toneMapped = false;
     m->transparent = true;
 
-    this->matrix = object.matrixWorld;
+    this->matrix.copy(object.matrixWorld);
     this->matrixAutoUpdate = false;
 }
 
@@ -75,18 +75,18 @@ void SkeletonHelper::updateMatrixWorld(bool force) {
 
     auto position = geometry_->getAttribute<float>("position");
 
-    _matrixWorldInv.copy(*this->root.matrixWorld).invert();
+    _matrixWorldInv.copy(this->root.matrixWorld).invert();
 
     int j = 0;
     for (auto& bone : bones) {
 
         if (bone->parent && bone->parent->is<Bone>()) {
 
-            _boneMatrix.multiplyMatrices(_matrixWorldInv, *bone->matrixWorld);
+            _boneMatrix.multiplyMatrices(_matrixWorldInv, bone->matrixWorld);
             _vector.setFromMatrixPosition(_boneMatrix);
             position->setXYZ(j, _vector.x, _vector.y, _vector.z);
 
-            _boneMatrix.multiplyMatrices(_matrixWorldInv, *bone->parent->matrixWorld);
+            _boneMatrix.multiplyMatrices(_matrixWorldInv, bone->parent->matrixWorld);
             _vector.setFromMatrixPosition(_boneMatrix);
             position->setXYZ(j + 1, _vector.x, _vector.y, _vector.z);
 
@@ -96,5 +96,8 @@ void SkeletonHelper::updateMatrixWorld(bool force) {
 
     geometry_->getAttribute("position")->needsUpdate();
 
-    Object3D::updateMatrixWorld(force);
+    // follows the root object
+    this->matrix.copy(this->root.matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
 }
@@ -15,7 +15,7 @@ SpotLightHelper::SpotLightHelper(SpotLight& light, std::optional<Color> color)
 
     this->light->updateMatrixWorld();
 
-    this->matrix = this->light->matrixWorld;
+    this->matrix.copy(this->light->matrixWorld);
     this->matrixAutoUpdate = false;
 
     auto geometry = BufferGeometry::create();
@@ -65,7 +65,7 @@ void SpotLightHelper::update() {
     this->cone->scale.set(coneWidth, coneWidth, coneLength);
 
     static Vector3 _vector;
-    _vector.setFromMatrixPosition(*this->light->target().matrixWorld);
+    _vector.setFromMatrixPosition(this->light->target().matrixWorld);
 
     this->cone->lookAt(_vector);
 
@@ -78,3 +78,11 @@ void SpotLightHelper::update() {
         this->cone->material()->as<MaterialWithColor>()->color.copy(this->light->color);
     }
 }
+
+void SpotLightHelper::updateMatrixWorld(bool force) {
+
+    // follows the light
+    this->matrix.copy(this->light->matrixWorld);
+
+    Object3D::updateMatrixWorld(true);
+}
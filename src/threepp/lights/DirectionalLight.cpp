@@ -10,6 +10,8 @@ using namespace threepp;
 DirectionalLight::DirectionalLight(const Color& color, std::optional<float> intensity)
     : Light(color, intensity), LightWithShadow(DirectionalLightShadow::create()) {
 
+    addKind(this);
+
     this->position.copy(Object3D::defaultUp);
     this->updateMatrix();
 }
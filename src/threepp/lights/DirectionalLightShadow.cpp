@@ -0,0 +1,138 @@
+
+#include "threepp/lights/DirectionalLightShadow.hpp"
+
+#include "threepp/renderers/GLRenderTarget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace threepp;
+
+namespace {
+
+    // Practical split scheme, blending uniform and logarithmic splits.
+    float splitDistance(float near, float far, float lambda, float fraction) {
+
+        const auto uniform = near + (far - near) * fraction;
+        if (near <= 0) return uniform;
+
+        const auto logarithmic = near * std::pow(far / near, fraction);
+
+        return lambda * logarithmic + (1 - lambda) * uniform;
+    }
+
+}// namespace
+
+void DirectionalLightShadow::setCascades(int cascades) {
+
+    if (cascades < 1 || cascades > maxCascades) {
+
+        throw std::runtime_error("[DirectionalLightShadow] cascades must be between 1 and " + std::to_string(maxCascades));
+    }
+
+    if (cascades == cascades_) return;
+
+    cascades_ = cascades;
+
+    _frameExtents.set(static_cast<float>(cascades), 1);
+
+    _viewports.clear();
+    for (int i = 0; i < cascades; i++) {
+
+        _viewports.emplace_back(static_cast<float>(i), 0.f, 1.f, 1.f);
+    }
+
+    // the shadow map gets allocated again with the new extents
+    dispose();
+    map.reset();
+    mapPass.reset();
+    staticMap.reset();
+
+    camera->updateProjectionMatrix();
+}
+
+int DirectionalLightShadow::cascades() const {
+
+    return cascades_;
+}
+
+void DirectionalLightShadow::updateCascade(Light& light, const Camera& viewCamera, size_t cascade) {
+
+    // orientation of the shadow camera, as for a single map
+    LightShadow::updateMatrices(light);
+
+    const auto near = viewCamera.near;
+    const auto far = cascadeFar > 0 ? std::min(cascadeFar, viewCamera.far) : viewCamera.far;
+
+    const auto n = static_cast<float>(cascades_);
+    const auto splitNear = splitDistance(near, far, cascadeSplitLambda, static_cast<float>(cascade) / n);
+    const auto splitFar = splitDistance(near, far, cascadeSplitLambda, static_cast<float>(cascade + 1) / n);
+
+    // corners of the slice, found along the edges of the view frustum and moved into light view space
+
+    Matrix4 viewToLight;
+    viewToLight.multiplyMatrices(camera->matrixWorldInverse, viewCamera.matrixWorld);
+
+    std::array<Vector3, 8> corners;
+    Vector3 center;
+
+    for (unsigned i = 0; i < 4; i++) {
+
+        const auto x = (i & 1) ? 1.f : -1.f;
+        const auto y = (i & 2) ? 1.f : -1.f;
+
+        Vector3 edgeNear(x, y, -1);
+        Vector3 edgeFar(x, y, 1);
+        edgeNear.applyMatrix4(viewCamera.projectionMatrixInverse);
+        edgeFar.applyMatrix4(viewCamera.projectionMatrixInverse);
+
+        const auto length = edgeNear.z - edgeFar.z;
+
+        for (unsigned j = 0; j < 2; j++) {
+
+            const auto t = ((j == 0 ? splitNear : splitFar) + edgeNear.z) / length;
+
+            auto& corner = corners[i * 2 + j];
+            corner.lerpVectors(edgeNear, edgeFar, t).applyMatrix4(viewToLight);
+            center.add(corner);
+        }
+    }
+
+    center.divideScalar(8);
+
+    // a bounding sphere keeps the cascade size fixed as the view rotates
+    float radius = 0;
+    for (const auto& corner : corners) {
+
+        radius = std::max(radius, center.distanceTo(corner));
+    }
+    radius = std::ceil(radius * 16) / 16;
+
+    // move in whole texels only, so that shadow edges do not shimmer as the view moves
+
+    const auto texelX = 2 * radius / mapSize.x;
+    const auto texelY = 2 * radius / mapSize.y;
+    center.x = std::floor(center.x / texelX) * texelX;
+    center.y = std::floor(center.y / texelY) * texelY;
+
+    const auto depth = -center.z;
+
+    camera->projectionMatrix.makeOrthographic(
+            center.x - radius, center.x + radius,
+            center.y + radius, center.y - radius,
+            depth - radius - cascadeMargin, depth + radius);
+    camera->projectionMatrixInverse.copy(camera->projectionMatrix).invert();
+
+    _projScreenMatrix.multiplyMatrices(camera->projectionMatrix, camera->matrixWorldInverse);
+    _frustum.setFromProjectionMatrix(_projScreenMatrix);
+
+    cascadeMatrices[cascade].set(
+            0.5f, 0.0f, 0.0f, 0.5f,
+            0.0f, 0.5f, 0.0f, 0.5f,
+            0.0f, 0.0f, 0.5f, 0.5f,
+            0.0f, 0.0f, 0.0f, 1.0f);
+    cascadeMatrices[cascade].multiply(camera->projectionMatrix);
+
+    matrix.copy(camera->matrixWorldInverse);
+}
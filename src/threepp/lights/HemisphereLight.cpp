@@ -8,6 +8,8 @@ HemisphereLight::HemisphereLight(const Color& skyColor, const Color& groundColor
     : Light(skyColor, intensity),
       groundColor(groundColor) {
 
+    addKind(this);
+
     position.copy(Object3D::defaultUp);
     updateMatrix();
 }
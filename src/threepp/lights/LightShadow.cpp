@@ -26,11 +26,11 @@ void LightShadow::updateMatrices(Light& light) {
     auto& shadowCamera = this->camera;
     auto& shadowMatrix = this->matrix;
 
-    _lightPositionWorld.setFromMatrixPosition(*light.matrixWorld);
+    _lightPositionWorld.setFromMatrixPosition(light.matrixWorld);
     shadowCamera->position.copy(_lightPositionWorld);
 
     auto lightWithTarget = dynamic_cast<LightWithTarget*>(&light);
-    _lookTarget.setFromMatrixPosition(*lightWithTarget->target().matrixWorld);
+    _lookTarget.setFromMatrixPosition(lightWithTarget->target().matrixWorld);
     shadowCamera->lookAt(_lookTarget);
     shadowCamera->updateMatrixWorld();
 
@@ -68,6 +68,11 @@ void LightShadow::dispose() {
 
         this->mapPass->dispose();
     }
+
+    if (this->staticMap) {
+
+        this->staticMap->dispose();
+    }
 }
 
 LightShadow::~LightShadow() {
@@ -57,7 +57,7 @@ void PointLightShadow::updateMatrices(PointLight& light, size_t viewportIndex) {
         camera->updateProjectionMatrix();
     }
 
-    _lightPositionWorld.setFromMatrixPosition(*light.matrixWorld);
+    _lightPositionWorld.setFromMatrixPosition(light.matrixWorld);
     camera->position.copy(_lightPositionWorld);
 
     _lookTarget.copy(camera->position);
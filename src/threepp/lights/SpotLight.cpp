@@ -9,6 +9,8 @@ using namespace threepp;
 SpotLight::SpotLight(const Color& color, std::optional<float> intensity, float distance, float angle, float penumbra, float decay)
     : Light(color, intensity), LightWithShadow(SpotLightShadow::create()), distance(distance), angle(angle), penumbra(penumbra), decay(decay) {
 
+    addKind(this);
+
     this->position.copy(Object3D::defaultUp);
     this->updateMatrix();
 }
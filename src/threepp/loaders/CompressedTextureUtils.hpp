@@ -0,0 +1,100 @@
+
+#ifndef THREEPP_COMPRESSEDTEXTUREUTILS_HPP
+#define THREEPP_COMPRESSEDTEXTUREUTILS_HPP
+
+#include "threepp/textures/CompressedTexture.hpp"
+
+#include "threepp/textures/CompressedTextureDecoder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace threepp::compressed {
+
+    using Buffer = std::shared_ptr<const std::vector<unsigned char>>;
+
+    inline std::vector<unsigned char> readFile(const std::filesystem::path& path) {
+
+        std::ifstream file(path, std::ios::binary);
+
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    // Little endian integer at offset, checked against the end of buffer.
+    template<class T>
+    T read(const std::vector<unsigned char>& buffer, size_t offset, const std::string& loader) {
+
+        if (offset + sizeof(T) > buffer.size()) {
+            throw std::runtime_error("[" + loader + "] Unexpected end of file");
+        }
+
+        T value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+
+        return value;
+    }
+
+    // Length of the full mip chain of a width x height texture, down to 1x1.
+    inline unsigned int maxLevels(unsigned int width, unsigned int height) {
+
+        unsigned int levels = 1;
+        while ((std::max(width, height) >> levels) > 0) levels++;
+
+        return levels;
+    }
+
+    struct Level {
+
+        size_t offset;
+        size_t byteLength;
+    };
+
+    // Levels point into buffer, which stays alive for as long as any of them does.
+    inline std::shared_ptr<CompressedTexture> createTexture(
+            const Buffer& buffer, const std::vector<Level>& levels,
+            unsigned int width, unsigned int height,
+            Format format, bool sRGB, bool flipY,
+            const std::string& loader) {
+
+        std::vector<Image> mipmaps;
+        mipmaps.reserve(levels.size());
+
+        for (unsigned i = 0; i < levels.size(); i++) {
+
+            const auto levelWidth = std::max(1u, width >> i);
+            const auto levelHeight = std::max(1u, height >> i);
+            const auto& level = levels[i];
+
+            if (level.offset > buffer->size() || level.byteLength > buffer->size() - level.offset ||
+                level.byteLength < compressedLevelBytes(format, levelWidth, levelHeight)) {
+                throw std::runtime_error("[" + loader + "] Truncated mip level " + std::to_string(i));
+            }
+
+            auto pixels = const_cast<unsigned char*>(buffer->data() + level.offset);
+            mipmaps.emplace_back(Image::adopt(pixels, level.byteLength, levelWidth, levelHeight, [buffer](unsigned char*) {}, false));
+        }
+
+        auto texture = CompressedTexture::create(std::move(mipmaps), width, height, format);
+
+        if (levels.size() == 1) texture->minFilter = Filter::Linear;
+        if (sRGB) texture->encoding = Encoding::sRGB;
+
+        if (flipY) {
+            // the blocks are stored top row first, and can't be flipped in place
+            texture->repeat.y = -1;
+            texture->offset.y = 1;
+        }
+
+        return texture;
+    }
+
+}// namespace threepp::compressed
+
+#endif//THREEPP_COMPRESSEDTEXTUREUTILS_HPP
@@ -0,0 +1,157 @@
+
+#include "threepp/loaders/DDSLoader.hpp"
+
+#include "CompressedTextureUtils.hpp"
+
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr uint32_t fourCC(const char (&code)[5]) {
+
+        return code[0] | (code[1] << 8) | (code[2] << 16) | (static_cast<uint32_t>(code[3]) << 24);
+    }
+
+    // header fields, in 32-bit words from the start of the file
+    constexpr size_t offFlags = 2;
+    constexpr size_t offHeight = 3;
+    constexpr size_t offWidth = 4;
+    constexpr size_t offMipmapCount = 7;
+    constexpr size_t offPfFlags = 20;
+    constexpr size_t offPfFourCC = 21;
+    constexpr size_t offCaps2 = 28;
+
+    // DX10 header fields, in 32-bit words from its start
+    constexpr size_t offDxgiFormat = 0;
+    constexpr size_t offResourceDimension = 1;
+    constexpr size_t offMiscFlag = 2;
+    constexpr size_t offArraySize = 3;
+
+    constexpr size_t headerLength = 128;
+    constexpr size_t dx10HeaderLength = 20;
+
+    constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+    constexpr uint32_t DDPF_FOURCC = 0x4;
+    constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+    constexpr uint32_t D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3;
+    constexpr uint32_t D3D10_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+    const std::string loaderName = "DDSLoader";
+
+    // DXGI_FORMAT of the DX10 header, and whether it is sRGB
+    std::pair<Format, bool> dxgiFormat(uint32_t format) {
+
+        switch (format) {
+            case 71: return {Format::RGBA_S3TC_DXT1, false};// BC1_UNORM
+            case 72: return {Format::RGBA_S3TC_DXT1, true}; // BC1_UNORM_SRGB
+            case 77: return {Format::RGBA_S3TC_DXT5, false};// BC3_UNORM
+            case 78: return {Format::RGBA_S3TC_DXT5, true}; // BC3_UNORM_SRGB
+            case 80: return {Format::RED_RGTC1, false};     // BC4_UNORM
+            case 83: return {Format::RED_GREEN_RGTC2, false};// BC5_UNORM
+            case 98: return {Format::RGBA_BPTC, false};     // BC7_UNORM
+            case 99: return {Format::RGBA_BPTC, true};      // BC7_UNORM_SRGB
+            default:
+                throw std::runtime_error("[DDSLoader] Unsupported DXGI format " + std::to_string(format));
+        }
+    }
+
+}// namespace
+
+
+std::shared_ptr<CompressedTexture> DDSLoader::load(const std::filesystem::path& path, bool flipY) const {
+
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "[DDSLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
+
+    auto texture = parse(compressed::readFile(path), flipY);
+    texture->name = path.stem().string();
+
+    return texture;
+}
+
+std::shared_ptr<CompressedTexture> DDSLoader::parse(std::vector<unsigned char> data, bool flipY) const {
+
+    const compressed::Buffer buffer = std::make_shared<const std::vector<unsigned char>>(std::move(data));
+
+    const auto word = [&](size_t index, size_t offset = 0) {
+        return compressed::read<uint32_t>(*buffer, offset + index * 4, loaderName);
+    };
+
+    if (word(0) != fourCC("DDS ")) {
+        throw std::runtime_error("[DDSLoader] Invalid magic number in DDS header");
+    }
+
+    if (!(word(offPfFlags) & DDPF_FOURCC)) {
+        throw std::runtime_error("[DDSLoader] Unsupported format, only block compressed DDS files are supported");
+    }
+
+    if (word(offCaps2) & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+        throw std::runtime_error("[DDSLoader] Cube maps and volume textures are not supported");
+    }
+
+    Format format;
+    bool sRGB = false;
+    size_t dataOffset = headerLength;
+
+    const auto code = word(offPfFourCC);
+
+    if (code == fourCC("DXT1")) {
+
+        format = (word(offPfFlags) & DDPF_ALPHAPIXELS) ? Format::RGBA_S3TC_DXT1 : Format::RGB_S3TC_DXT1;
+
+    } else if (code == fourCC("DXT5")) {
+
+        format = Format::RGBA_S3TC_DXT5;
+
+    } else if (code == fourCC("ATI1") || code == fourCC("BC4U")) {
+
+        format = Format::RED_RGTC1;
+
+    } else if (code == fourCC("ATI2") || code == fourCC("BC5U")) {
+
+        format = Format::RED_GREEN_RGTC2;
+
+    } else if (code == fourCC("DX10")) {
+
+        if (word(offResourceDimension, headerLength) != D3D10_RESOURCE_DIMENSION_TEXTURE2D ||
+            word(offArraySize, headerLength) > 1 ||
+            (word(offMiscFlag, headerLength) & D3D10_RESOURCE_MISC_TEXTURECUBE)) {
+            throw std::runtime_error("[DDSLoader] Only 2D textures are supported");
+        }
+
+        std::tie(format, sRGB) = dxgiFormat(word(offDxgiFormat, headerLength));
+        dataOffset += dx10HeaderLength;
+
+    } else {
+
+        const std::string name{static_cast<char>(code & 0xFF), static_cast<char>((code >> 8) & 0xFF), static_cast<char>((code >> 16) & 0xFF), static_cast<char>(code >> 24)};
+        throw std::runtime_error("[DDSLoader] Unsupported FourCC code " + name);
+    }
+
+    const auto width = word(offWidth);
+    const auto height = word(offHeight);
+
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("[DDSLoader] Invalid texture size");
+    }
+
+    // never more levels than down to 1x1
+    const auto mipmapCount = (word(offFlags) & DDSD_MIPMAPCOUNT) ? std::clamp(word(offMipmapCount), 1u, compressed::maxLevels(width, height)) : 1u;
+
+    std::vector<compressed::Level> levels;
+    for (unsigned i = 0; i < mipmapCount; i++) {
+
+        const auto byteLength = compressedLevelBytes(format, std::max(1u, width >> i), std::max(1u, height >> i));
+        levels.push_back({dataOffset, byteLength});
+        dataOffset += byteLength;
+    }
+
+    return compressed::createTexture(buffer, levels, width, height, format, sRGB, flipY, loaderName);
+}
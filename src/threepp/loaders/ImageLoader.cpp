@@ -22,31 +22,16 @@ using namespace threepp;
 
 namespace {
 
-    struct ImageStruct {
+    // Hands the stb buffer over to the image as is, to be freed by stbi_image_free.
+    std::optional<Image> adoptPixels(unsigned char* pixels, int width, int height, int channels, bool flipY) {
 
-        int width{};
-        int height{};
-        int channels;
-        unsigned char* pixels;
+        const auto count = static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
 
-        ImageStruct(const std::vector<unsigned char>& data, int channels, bool flipY): channels(channels) {
-            stbi_set_flip_vertically_on_load(flipY);
-            pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, nullptr, channels);
-        }
-
-        ImageStruct(const std::filesystem::path& imagePath, int channels, bool flipY): channels(channels) {
-            stbi_set_flip_vertically_on_load(flipY);
-            pixels = stbi_load(imagePath.string().c_str(), &width, &height, nullptr, channels);
-        }
-
-        [[nodiscard]] std::vector<unsigned char> get() const {
-            return {pixels, pixels + (channels * width * height)};
-        }
-
-        ~ImageStruct() {
-            stbi_image_free(pixels);
-        }
-    };
+        return Image::adopt(pixels, pixels ? count : 0,
+                            static_cast<unsigned int>(width),
+                            static_cast<unsigned int>(height),
+                            &stbi_image_free, flipY);
+    }
 
 }// namespace
 
@@ -56,22 +41,18 @@ std::optional<Image> ImageLoader::load(const std::filesystem::path& imagePath, i
         return std::nullopt;
     }
 
-    ImageStruct image{imagePath, channels, flipY};
+    int width{}, height{};
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    auto pixels = stbi_load(imagePath.string().c_str(), &width, &height, nullptr, channels);
 
-    return Image{
-            image.get(),
-            static_cast<unsigned int>(image.width),
-            static_cast<unsigned int>(image.height),
-            flipY};
+    return adoptPixels(pixels, width, height, channels, flipY);
 }
 
 std::optional<Image> ImageLoader::load(const std::vector<unsigned char>& data, int channels, bool flipY) {
 
-    ImageStruct image{data, channels, flipY};
+    int width{}, height{};
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    auto pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, nullptr, channels);
 
-    return Image{
-            image.get(),
-            static_cast<unsigned int>(image.width),
-            static_cast<unsigned int>(image.height),
-            flipY};
+    return adoptPixels(pixels, width, height, channels, flipY);
 }
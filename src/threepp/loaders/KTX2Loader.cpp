@@ -0,0 +1,110 @@
+
+#include "threepp/loaders/KTX2Loader.hpp"
+
+#include "CompressedTextureUtils.hpp"
+
+#include <iostream>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr unsigned char identifier[12]{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    // header fields, in bytes from the start of the file
+    constexpr size_t offVkFormat = 12;
+    constexpr size_t offPixelWidth = 20;
+    constexpr size_t offPixelHeight = 24;
+    constexpr size_t offPixelDepth = 28;
+    constexpr size_t offLayerCount = 32;
+    constexpr size_t offFaceCount = 36;
+    constexpr size_t offLevelCount = 40;
+    constexpr size_t offSupercompressionScheme = 44;
+    constexpr size_t offLevelIndex = 80;
+
+    // byteOffset, byteLength and uncompressedByteLength, all 64-bit
+    constexpr size_t levelIndexEntryLength = 24;
+
+    const std::string loaderName = "KTX2Loader";
+
+    // VkFormat of the header, and whether it is sRGB
+    std::pair<Format, bool> vkFormat(uint32_t format) {
+
+        switch (format) {
+            case 131: return {Format::RGB_S3TC_DXT1, false}; // BC1_RGB_UNORM_BLOCK
+            case 132: return {Format::RGB_S3TC_DXT1, true};  // BC1_RGB_SRGB_BLOCK
+            case 133: return {Format::RGBA_S3TC_DXT1, false};// BC1_RGBA_UNORM_BLOCK
+            case 134: return {Format::RGBA_S3TC_DXT1, true}; // BC1_RGBA_SRGB_BLOCK
+            case 137: return {Format::RGBA_S3TC_DXT5, false};// BC3_UNORM_BLOCK
+            case 138: return {Format::RGBA_S3TC_DXT5, true}; // BC3_SRGB_BLOCK
+            case 139: return {Format::RED_RGTC1, false};     // BC4_UNORM_BLOCK
+            case 141: return {Format::RED_GREEN_RGTC2, false};// BC5_UNORM_BLOCK
+            case 145: return {Format::RGBA_BPTC, false};     // BC7_UNORM_BLOCK
+            case 146: return {Format::RGBA_BPTC, true};      // BC7_SRGB_BLOCK
+            case 147: return {Format::RGB_ETC2, false};      // ETC2_R8G8B8_UNORM_BLOCK
+            case 148: return {Format::RGB_ETC2, true};       // ETC2_R8G8B8_SRGB_BLOCK
+            case 151: return {Format::RGBA_ETC2_EAC, false}; // ETC2_R8G8B8A8_UNORM_BLOCK
+            case 152: return {Format::RGBA_ETC2_EAC, true};  // ETC2_R8G8B8A8_SRGB_BLOCK
+            case 0:
+                throw std::runtime_error("[KTX2Loader] Basis Universal textures are not supported");
+            default:
+                throw std::runtime_error("[KTX2Loader] Unsupported vkFormat " + std::to_string(format));
+        }
+    }
+
+}// namespace
+
+
+std::shared_ptr<CompressedTexture> KTX2Loader::load(const std::filesystem::path& path, bool flipY) const {
+
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "[KTX2Loader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
+
+    auto texture = parse(compressed::readFile(path), flipY);
+    texture->name = path.stem().string();
+
+    return texture;
+}
+
+std::shared_ptr<CompressedTexture> KTX2Loader::parse(std::vector<unsigned char> data, bool flipY) const {
+
+    const compressed::Buffer buffer = std::make_shared<const std::vector<unsigned char>>(std::move(data));
+
+    const auto u32 = [&](size_t offset) { return compressed::read<uint32_t>(*buffer, offset, loaderName); };
+    const auto u64 = [&](size_t offset) { return compressed::read<uint64_t>(*buffer, offset, loaderName); };
+
+    if (buffer->size() < sizeof(identifier) || !std::equal(std::begin(identifier), std::end(identifier), buffer->begin())) {
+        throw std::runtime_error("[KTX2Loader] Missing KTX 2.0 identifier");
+    }
+
+    if (u32(offSupercompressionScheme) != 0) {
+        throw std::runtime_error("[KTX2Loader] Supercompressed textures are not supported");
+    }
+
+    if (u32(offPixelDepth) > 0 || u32(offLayerCount) > 0 || u32(offFaceCount) != 1) {
+        throw std::runtime_error("[KTX2Loader] Only 2D textures are supported");
+    }
+
+    const auto [format, sRGB] = vkFormat(u32(offVkFormat));
+
+    const auto width = u32(offPixelWidth);
+    const auto height = u32(offPixelHeight);
+
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("[KTX2Loader] Invalid texture size");
+    }
+
+    // zero levels asks for mipmaps to be generated, which compressed formats can't, and never more levels than down to 1x1
+    const auto levelCount = std::clamp(u32(offLevelCount), 1u, compressed::maxLevels(width, height));
+
+    std::vector<compressed::Level> levels;
+    for (unsigned i = 0; i < levelCount; i++) {
+
+        const auto entry = offLevelIndex + i * levelIndexEntryLength;
+        levels.push_back({static_cast<size_t>(u64(entry)), static_cast<size_t>(u64(entry + 8))});
+    }
+
+    return compressed::createTexture(buffer, levels, width, height, format, sRGB, flipY, loaderName);
+}
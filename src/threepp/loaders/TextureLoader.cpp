@@ -2,9 +2,13 @@
 #include "threepp/loaders/TextureLoader.hpp"
 
 #include "threepp/loaders/ImageLoader.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
+#include <algorithm>
+#include <future>
 #include <iostream>
 #include <regex>
+#include <thread>
 #include <vector>
 
 using namespace threepp;
@@ -18,6 +22,15 @@ namespace {
         return std::regex_match(path, reg);
     }
 
+    struct PendingLoad {
+
+        std::string name;
+        std::shared_ptr<Texture> texture;
+        std::future<std::optional<Image>> image;
+        std::vector<std::function<void(Texture&)>> onLoad;
+        std::vector<std::function<void(Texture&)>> onError;
+    };
+
 }// namespace
 
 struct TextureLoader::Impl {
@@ -26,8 +39,26 @@ struct TextureLoader::Impl {
     ImageLoader imageLoader_;
     std::unordered_map<std::string, std::weak_ptr<Texture>> cache_;
 
+    std::vector<PendingLoad> pending_;
+    std::unique_ptr<ThreadPool> pool_;
+
     explicit Impl(bool useCache): useCache_(useCache) {}
 
+    ThreadPool& pool() {
+
+        if (!pool_) {
+            // one worker per core, the calling thread does not take part in submitted tasks
+            pool_ = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()) + 1);
+        }
+
+        return *pool_;
+    }
+
+    std::vector<PendingLoad>::iterator findPending(const std::string& name) {
+
+        return std::find_if(pending_.begin(), pending_.end(), [&](const PendingLoad& load) { return load.name == name; });
+    }
+
     std::shared_ptr<Texture> checkCache(const std::string& name) {
 
         std::shared_ptr<Texture> tex;
@@ -48,6 +79,14 @@ struct TextureLoader::Impl {
 
         if (auto cachedTexture = checkCache(path.string())) {
 
+            // still decoding on behalf of loadAsync, wait for it
+            auto it = findPending(path.string());
+            if (it != pending_.end()) {
+                auto load = std::move(*it);
+                pending_.erase(it);
+                if (!apply(load)) return nullptr;
+            }
+
             return cachedTexture;
         }
 
@@ -60,7 +99,7 @@ struct TextureLoader::Impl {
 
         auto image = imageLoader_.load(path, isJPEG ? 3 : 4, flipY);
 
-        auto texture = Texture::create(*image);
+        auto texture = Texture::create(std::move(*image));
         texture->name = path.stem().string();
 
         texture->format = isJPEG ? Format::RGB : Format::RGBA;
@@ -82,7 +121,7 @@ struct TextureLoader::Impl {
 
         auto image = imageLoader_.load(data, isJPEG ? 3 : 4, flipY);
 
-        auto texture = Texture::create(*image);
+        auto texture = Texture::create(std::move(*image));
         texture->name = name;
 
         texture->format = isJPEG ? Format::RGB : Format::RGBA;
@@ -92,6 +131,119 @@ struct TextureLoader::Impl {
 
         return texture;
     }
+
+    std::shared_ptr<Texture> loadAsync(const std::filesystem::path& path, bool flipY,
+                                       const std::function<void(Texture&)>& onLoad, const std::function<void(Texture&)>& onError) {
+
+        const auto name = path.string();
+
+        if (auto cachedTexture = checkCache(name)) {
+
+            auto it = findPending(name);
+            if (it != pending_.end()) {
+                if (onLoad) it->onLoad.emplace_back(onLoad);
+                if (onError) it->onError.emplace_back(onError);
+            } else if (onLoad) {
+                onLoad(*cachedTexture);
+            }
+
+            return cachedTexture;
+        }
+
+        if (!std::filesystem::exists(path)) {
+            std::cerr << "[TextureLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+            return nullptr;
+        }
+
+        bool isJPEG = checkIsJPEG(name);
+        const int channels = isJPEG ? 3 : 4;
+
+        auto texture = Texture::create(Image(std::vector<unsigned char>(channels, 255), 1, 1, flipY));
+        texture->name = path.stem().string();
+
+        texture->format = isJPEG ? Format::RGB : Format::RGBA;
+        texture->needsUpdate();
+
+        if (useCache_) cache_[name] = texture;
+
+        // ImageLoader sets flipY per thread, so decodes may run side by side
+        auto decode = std::make_shared<std::packaged_task<std::optional<Image>()>>([path, channels, flipY] {
+            return ImageLoader().load(path, channels, flipY);
+        });
+
+        auto& load = pending_.emplace_back(PendingLoad{name, texture, decode->get_future(), {}, {}});
+        if (onLoad) load.onLoad.emplace_back(onLoad);
+        if (onError) load.onError.emplace_back(onError);
+
+        pool().submit([decode] { (*decode)(); });
+
+        return texture;
+    }
+
+    size_t update() {
+
+        std::vector<PendingLoad> ready;
+
+        for (auto it = pending_.begin(); it != pending_.end();) {
+
+            if (it->image.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                ready.emplace_back(std::move(*it));
+                it = pending_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // onLoad may start new loads, so pending_ is left alone from here
+        for (auto& load : ready) {
+            apply(load);
+        }
+
+        return pending_.size();
+    }
+
+    void waitAll() {
+
+        while (!pending_.empty()) {
+
+            for (const auto& load : pending_) {
+                load.image.wait();
+            }
+
+            update();
+        }
+    }
+
+    // Returns false when the image could not be decoded.
+    bool apply(PendingLoad& load) {
+
+        auto image = load.image.get();
+
+        if (!image || image->width == 0) {
+            std::cerr << "[TextureLoader] Unable to decode '" << load.name << "'!" << std::endl;
+
+            // so that the next request tries the file again instead of getting the placeholder
+            auto cached = cache_.find(load.name);
+            if (cached != cache_.end() && cached->second.lock() == load.texture) {
+                cache_.erase(cached);
+            }
+
+            for (const auto& onError : load.onError) {
+                onError(*load.texture);
+            }
+
+            return false;
+        }
+
+        load.texture->image() = std::move(*image);
+        load.texture->needsUpdate();
+
+        for (const auto& onLoad : load.onLoad) {
+            onLoad(*load.texture);
+        }
+
+        return true;
+    }
 };
 
 TextureLoader::TextureLoader(bool useCache)
@@ -107,6 +259,22 @@ std::shared_ptr<Texture> TextureLoader::loadFromMemory(const std::string& name,
     return pimpl_->loadFromMemory(name, data, flipY);
 }
 
+std::shared_ptr<Texture> TextureLoader::loadAsync(const std::filesystem::path& path, bool flipY,
+                                                 const std::function<void(Texture&)>& onLoad, const std::function<void(Texture&)>& onError) {
+
+    return pimpl_->loadAsync(path, flipY, onLoad, onError);
+}
+
+size_t TextureLoader::update() {
+
+    return pimpl_->update();
+}
+
+void TextureLoader::waitAll() {
+
+    pimpl_->waitAll();
+}
+
 void TextureLoader::clearCache() {
 
     pimpl_->cache_.clear();
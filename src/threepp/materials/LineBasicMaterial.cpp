@@ -5,7 +5,10 @@ using namespace threepp;
 
 LineBasicMaterial::LineBasicMaterial()
     : MaterialWithColor(0xffffff),
-      MaterialWithLineWidth(1) {}
+      MaterialWithLineWidth(1) {
+
+    addKind(this);
+}
 
 
 std::string LineBasicMaterial::type() const {
@@ -9,7 +9,10 @@ MeshBasicMaterial::MeshBasicMaterial()
       MaterialWithLightMap(1),
       MaterialWithCombine(CombineOperation::Multiply),
       MaterialWithReflectivity(1, 0.98f),
-      MaterialWithWireframe(false, 1) {}
+      MaterialWithWireframe(false, 1) {
+
+    addKind(this);
+}
 
 
 std::string MeshBasicMaterial::type() const {
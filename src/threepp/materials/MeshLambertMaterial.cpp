@@ -10,7 +10,10 @@ MeshLambertMaterial::MeshLambertMaterial()
       MaterialWithLightMap(1),
       MaterialWithEmissive(0x000000, 1),
       MaterialWithAoMap(1),
-      MaterialWithCombine(CombineOperation::Multiply) {}
+      MaterialWithCombine(CombineOperation::Multiply) {
+
+    addKind(this);
+}
 
 
 std::string MeshLambertMaterial::type() const {
@@ -10,6 +10,8 @@ MeshNormalMaterial::MeshNormalMaterial()
       MaterialWithNormalMap(NormalMapType::TangentSpace, {1, 1}),
       MaterialWithBumpMap(1) {
 
+    addKind(this);
+
     this->fog = false;
 }
 
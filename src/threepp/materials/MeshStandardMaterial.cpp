@@ -20,6 +20,8 @@ MeshStandardMaterial::MeshStandardMaterial()
       MaterialWithVertexTangents(false),
       MaterialWithFlatShading(false) {
 
+    addKind(this);
+
     defines["STANDARD"] = "";
 }
 
@@ -4,7 +4,10 @@
 using namespace threepp;
 
 
-RawShaderMaterial::RawShaderMaterial() = default;
+RawShaderMaterial::RawShaderMaterial() {
+
+    addKind(this);
+}
 
 
 std::string RawShaderMaterial::type() const {
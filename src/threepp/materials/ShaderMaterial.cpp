@@ -13,6 +13,8 @@ ShaderMaterial::ShaderMaterial()
       vertexShader(shaders::ShaderChunk::instance().default_vertex()),
       fragmentShader(shaders::ShaderChunk::instance().default_fragment()) {
 
+    addKind(this);
+
     this->fog = false;
     this->lights = false;
     this->clipping = false;
@@ -6,6 +6,8 @@ using namespace threepp;
 SpriteMaterial::SpriteMaterial()
     : MaterialWithColor(0xffffff),
       MaterialWithSize(0, true) {
+
+    addKind(this);
     transparent = true;
 }
 
@@ -208,7 +208,7 @@ Box3& Box3::expandByObject(Object3D& object, bool presice) {
 
         _box.copy(*instancedMesh->boundingBox);
 
-        _box.applyMatrix4(*object.matrixWorld);
+        _box.applyMatrix4(object.matrixWorld);
 
         this->union_(_box);
 
@@ -224,7 +224,7 @@ Box3& Box3::expandByObject(Object3D& object, bool presice) {
                 for (unsigned i = 0, l = position->count(); i < l; i++) {
 
                     position->setFromBufferAttribute(_vector, i);
-                    _vector.applyMatrix4(*object.matrixWorld);
+                    _vector.applyMatrix4(object.matrixWorld);
 
                     this->expandByPoint(_vector);
                 }
@@ -239,7 +239,7 @@ Box3& Box3::expandByObject(Object3D& object, bool presice) {
                 Box3 _box{};
 
                 _box.copy(geometry->boundingBox.value());
-                _box.applyMatrix4(*object.matrixWorld);
+                _box.applyMatrix4(object.matrixWorld);
 
                 this->union_(_box);
             }
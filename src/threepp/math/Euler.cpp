@@ -12,7 +12,28 @@
 using namespace threepp;
 
 Euler::Euler(float x, float y, float z, RotationOrders order)
-    : x(x), y(y), z(z), order_(order) {}
+    : x(x), y(y), z(z), order_(order) {
+
+    bindComponents();
+}
+
+Euler::Euler(const Euler& e)
+    : x(e.x), y(e.y), z(e.z), order_(e.order_) {
+
+    bindComponents();
+}
+
+Euler& Euler::operator=(const Euler& e) {
+
+    return copy(e);
+}
+
+void Euler::bindComponents() {
+
+    x.listener_ = &onChangeCallback_;
+    y.listener_ = &onChangeCallback_;
+    z.listener_ = &onChangeCallback_;
+}
 
 
 Euler::RotationOrders Euler::getOrder() const {
@@ -182,12 +203,9 @@ Euler& Euler::setFromVector3(const Vector3& v, std::optional<RotationOrders> ord
     return this->set(v.x, v.y, v.z, order);
 }
 
-Euler& Euler::_onChange(std::function<void()> callback) {
+Euler& Euler::_onChange(void (*callback)(void*), void* context) {
 
-    this->onChangeCallback_ = std::move(callback);
-    this->x.setCallback(this->onChangeCallback_);
-    this->y.setCallback(this->onChangeCallback_);
-    this->z.setCallback(this->onChangeCallback_);
+    this->onChangeCallback_ = {callback, context};
 
     return *this;
 }
@@ -2,13 +2,13 @@
 #include "threepp/math/Frustum.hpp"
 
 #include "threepp/core/BufferGeometry.hpp"
+#include "threepp/objects/BatchedMesh.hpp"
 #include "threepp/objects/InstancedMesh.hpp"
 #include "threepp/objects/Sprite.hpp"
 
 using namespace threepp;
 
 namespace {
-    Sphere _sphere{};
     Vector3 _vector{};
 }// namespace
 
@@ -57,11 +57,19 @@ Frustum& Frustum::setFromProjectionMatrix(const Matrix4& m) {
 
 bool Frustum::intersectsObject(Object3D& object) const {
 
+    Sphere _sphere;
+
     if (auto instancedMesh = object.as<InstancedMesh>()) {
 
         if (!instancedMesh->boundingSphere) instancedMesh->computeBoundingSphere();
 
-        _sphere.copy(instancedMesh->boundingSphere.value()).applyMatrix4(*object.matrixWorld);
+        _sphere.copy(instancedMesh->boundingSphere.value()).applyMatrix4(object.matrixWorld);
+
+    } else if (auto batchedMesh = object.as<BatchedMesh>()) {
+
+        if (!batchedMesh->boundingSphere) batchedMesh->computeBoundingSphere();
+
+        _sphere.copy(batchedMesh->boundingSphere.value()).applyMatrix4(object.matrixWorld);
 
     } else {
 
@@ -69,16 +77,15 @@ bool Frustum::intersectsObject(Object3D& object) const {
 
         if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
-        _sphere.copy(geometry->boundingSphere.value()).applyMatrix4(*object.matrixWorld);
+        _sphere.copy(geometry->boundingSphere.value()).applyMatrix4(object.matrixWorld);
     }
 
     return this->intersectsSphere(_sphere);
 }
 
 bool Frustum::intersectsSprite(const Sprite& sprite) const {
-    _sphere.center.set(0, 0, 0);
-    _sphere.radius = 0.7071067811865476f;
-    _sphere.applyMatrix4(*sprite.matrixWorld);
+    Sphere _sphere(Vector3(0, 0, 0), 0.7071067811865476f);
+    _sphere.applyMatrix4(sprite.matrixWorld);
 
     return this->intersectsSphere(_sphere);
 }
@@ -13,7 +13,29 @@ using namespace threepp;
 
 
 Quaternion::Quaternion(float x, float y, float z, float w)
-    : x(x), y(y), z(z), w(w) {}
+    : x(x), y(y), z(z), w(w) {
+
+    bindComponents();
+}
+
+Quaternion::Quaternion(const Quaternion& q)
+    : x(q.x), y(q.y), z(q.z), w(q.w) {
+
+    bindComponents();
+}
+
+Quaternion& Quaternion::operator=(const Quaternion& q) {
+
+    return copy(q);
+}
+
+void Quaternion::bindComponents() {
+
+    x.listener_ = &onChangeCallback_;
+    y.listener_ = &onChangeCallback_;
+    z.listener_ = &onChangeCallback_;
+    w.listener_ = &onChangeCallback_;
+}
 
 float Quaternion::operator[](unsigned int index) const {
     switch (index) {
@@ -429,13 +451,9 @@ bool Quaternion::equals(const Quaternion& v) const {
     return ((v.x == this->x) && (v.y == this->y) && (v.z == this->z) && (v.w == this->w));
 }
 
-Quaternion& Quaternion::_onChange(std::function<void()> callback) {
+Quaternion& Quaternion::_onChange(void (*callback)(void*), void* context) {
 
-    this->onChangeCallback_ = std::move(callback);
-    this->x.setCallback(this->onChangeCallback_);
-    this->y.setCallback(this->onChangeCallback_);
-    this->z.setCallback(this->onChangeCallback_);
-    this->w.setCallback(this->onChangeCallback_);
+    this->onChangeCallback_ = {callback, context};
 
     return *this;
 }
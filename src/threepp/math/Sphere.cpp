@@ -161,6 +161,21 @@ Sphere& Sphere::expandByPoint(const Vector3& point) {
 
 Sphere& Sphere::union_(const Sphere& sphere) {
 
+    if (this->isEmpty()) {
+
+        this->copy(sphere);
+
+        return *this;
+    }
+
+    // the direction to the farthest point is undefined for concentric spheres
+    if (this->center.equals(sphere.center)) {
+
+        this->radius = std::max(this->radius, sphere.radius);
+
+        return *this;
+    }
+
     // from https://github.com/juj/MathGeoLib/blob/2940b99b99cfe575dd45103ef20f4019dee15b54/src/Geometry/Sphere.cpp#L759-L769
 
     // To enclose another sphere into this sphere, we only need to enclose two points:
@@ -0,0 +1,452 @@
+
+#include "threepp/objects/BatchedMesh.hpp"
+
+#include "threepp/cameras/Camera.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/MathUtils.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace threepp;
+
+namespace {
+
+    Matrix4 _matrix;
+    Matrix4 _projScreenMatrix;
+    Frustum _frustum;
+    Sphere _sphere;
+    Box3 _box;
+
+    // creates an attribute like source, with room for count vertices
+    template<class T>
+    bool tryReserve(const BufferAttribute& source, int count, std::shared_ptr<BufferAttribute>& attribute) {
+
+        if (!dynamic_cast<const TypedBufferAttribute<T>*>(&source)) return false;
+
+        attribute = TypedBufferAttribute<T>::create(std::vector<T>(count * source.itemSize()), source.itemSize(), source.normalized());
+
+        return true;
+    }
+
+    template<class T>
+    bool tryCopy(const BufferAttribute& source, BufferAttribute& target, int vertexStart) {
+
+        const auto src = dynamic_cast<const TypedBufferAttribute<T>*>(&source);
+        const auto dst = dynamic_cast<TypedBufferAttribute<T>*>(&target);
+        if (!src || !dst) return false;
+
+        const auto itemSize = source.itemSize();
+        const auto offset = vertexStart * itemSize;
+
+        for (int i = 0; i < src->count(); i++) {
+
+            // through the getters, as an InterleavedBufferAttribute (a FloatBufferAttribute) reads its items from a shared, strided buffer
+            for (int c = 0; c < itemSize; c++) {
+
+                dst->array()[offset + i * itemSize + c] = c == 0   ? src->getX(i)
+                                                          : c == 1 ? src->getY(i)
+                                                          : c == 2 ? src->getZ(i)
+                                                                   : src->getW(i);
+            }
+        }
+
+        target.addUpdateRange(offset, src->count() * itemSize);
+        target.needsUpdate();
+
+        return true;
+    }
+
+    template<class... T>
+    std::shared_ptr<BufferAttribute> reserveAttribute(const BufferAttribute& source, int count) {
+
+        std::shared_ptr<BufferAttribute> attribute;
+        (tryReserve<T>(source, count, attribute) || ...);
+
+        return attribute;
+    }
+
+    template<class... T>
+    bool copyAttribute(const BufferAttribute& source, BufferAttribute& target, int vertexStart) {
+
+        return (tryCopy<T>(source, target, vertexStart) || ...);
+    }
+
+}// namespace
+
+
+BatchedMesh::BatchedMesh(size_t maxGeometryCount, size_t maxVertexCount, size_t maxIndexCount, std::shared_ptr<Material> material)
+    : Mesh(BufferGeometry::create(), std::move(material)),
+      maxGeometryCount_(maxGeometryCount), maxVertexCount_(maxVertexCount), maxIndexCount_(maxIndexCount) {
+
+    addKind(this);
+
+    // layout as Skeleton::computeBoneTexture, 4 RGBA pixels per matrix
+    auto size = std::sqrt(static_cast<float>(maxGeometryCount * 4));
+    matricesTextureSize_ = std::max(math::ceilPowerOfTwo(size), 4);
+
+    std::vector<float> matrices(matricesTextureSize_ * matricesTextureSize_ * 4);
+
+    Matrix4 identity;
+    for (unsigned i = 0; i < maxGeometryCount; i++) {
+
+        identity.toArray(matrices, i * 16);
+    }
+
+    matricesTexture_ = DataTexture::create(matrices, matricesTextureSize_, matricesTextureSize_);
+    matricesTexture_->format = Format::RGBA;
+    matricesTexture_->type = Type::Float;
+}
+
+std::string BatchedMesh::type() const {
+
+    return "BatchedMesh";
+}
+
+size_t BatchedMesh::maxGeometryCount() const {
+
+    return maxGeometryCount_;
+}
+
+size_t BatchedMesh::geometryCount() const {
+
+    return items_.size();
+}
+
+size_t BatchedMesh::addGeometry(const BufferGeometry& geometry) {
+
+    const auto position = geometry.getAttributes().find("position");
+    if (position == geometry.getAttributes().end()) {
+
+        throw std::runtime_error("[BatchedMesh] Geometry has no position attribute.");
+    }
+
+    if (items_.empty()) reserve(geometry);
+
+    const auto index = geometry.getIndex();
+    if ((index != nullptr) != geometry_->hasIndex()) {
+
+        throw std::runtime_error("[BatchedMesh] All geometries must be indexed, or none of them.");
+    }
+
+    const auto vertexCount = position->second->count();
+    const auto indexCount = index ? index->count() : 0;
+
+    if (items_.size() >= maxGeometryCount_ ||
+        vertexCount_ + vertexCount > static_cast<int>(maxVertexCount_) ||
+        indexCount_ + indexCount > static_cast<int>(maxIndexCount_ * (index != nullptr))) {
+
+        throw std::runtime_error("[BatchedMesh] Reserved space exhausted.");
+    }
+
+    for (const auto& [name, target] : geometry_->getAttributes()) {
+
+        if (name == "batchId") continue;
+
+        const auto source = geometry.getAttributes().find(name);
+        if (source == geometry.getAttributes().end() || source->second->itemSize() != target->itemSize() || source->second->count() != vertexCount ||
+            !copyAttribute<float, unsigned int, uint16_t, HalfFloat, int16_t, uint8_t, int8_t>(*source->second, *target, vertexCount_)) {
+
+            throw std::runtime_error("[BatchedMesh] Attribute '" + name + "' does not match the first geometry.");
+        }
+    }
+
+    const auto id = items_.size();
+
+    auto batchId = geometry_->getAttribute<float>("batchId");
+    for (int i = 0; i < vertexCount; i++) {
+
+        batchId->setX(vertexCount_ + i, static_cast<float>(id));
+    }
+    batchId->addUpdateRange(vertexCount_, vertexCount);
+    batchId->needsUpdate();
+
+    if (index) {
+
+        auto batchIndex = geometry_->getIndex();
+        for (int i = 0; i < indexCount; i++) {
+
+            batchIndex->setX(indexCount_ + i, index->getX(i) + vertexCount_);
+        }
+        batchIndex->addUpdateRange(indexCount_, indexCount);
+        batchIndex->needsUpdate();
+    }
+
+    auto& item = items_.emplace_back();
+    item.vertexStart = vertexCount_;
+    item.vertexCount = vertexCount;
+    item.indexStart = indexCount_;
+    item.indexCount = indexCount;
+
+    item.box.makeEmpty();
+    item.sphere.makeEmpty();
+
+    if (const auto positions = dynamic_cast<const FloatBufferAttribute*>(position->second.get())) {
+
+        positions->setFromBufferAttribute(item.box);
+        item.box.getCenter(item.sphere.center);
+
+        float maxRadiusSq = 0;
+        Vector3 v;
+        for (int i = 0; i < vertexCount; i++) {
+
+            positions->setFromBufferAttribute(v, i);
+            maxRadiusSq = std::max(maxRadiusSq, item.sphere.center.distanceToSquared(v));
+        }
+        item.sphere.radius = std::sqrt(maxRadiusSq);
+    }
+
+    vertexCount_ += vertexCount;
+    indexCount_ += indexCount;
+
+    boundingBox.reset();
+    boundingSphere.reset();
+
+    return id;
+}
+
+void BatchedMesh::deleteGeometry(size_t id) {
+
+    checkId(id);
+
+    items_[id].active = false;
+
+    boundingBox.reset();
+    boundingSphere.reset();
+}
+
+void BatchedMesh::setMatrixAt(size_t id, const Matrix4& matrix) {
+
+    checkId(id);
+
+    matrix.toArray(matricesTexture_->image().data<float>(), id * 16);
+    matricesTexture_->needsUpdate();
+
+    boundingBox.reset();
+    boundingSphere.reset();
+}
+
+void BatchedMesh::getMatrixAt(size_t id, Matrix4& matrix) const {
+
+    checkId(id);
+
+    matrix.fromArray(matricesTexture_->image().data<float>(), id * 16);
+}
+
+void BatchedMesh::setVisibleAt(size_t id, bool visible) {
+
+    checkId(id);
+
+    items_[id].visible = visible;
+}
+
+bool BatchedMesh::getVisibleAt(size_t id) const {
+
+    checkId(id);
+
+    return items_[id].visible;
+}
+
+const Box3& BatchedMesh::getBoundingBoxAt(size_t id) const {
+
+    checkId(id);
+
+    return items_[id].box;
+}
+
+const Sphere& BatchedMesh::getBoundingSphereAt(size_t id) const {
+
+    checkId(id);
+
+    return items_[id].sphere;
+}
+
+void BatchedMesh::computeBoundingBox() {
+
+    if (!boundingBox) boundingBox = Box3();
+
+    boundingBox->makeEmpty();
+
+    for (size_t id = 0; id < items_.size(); id++) {
+
+        if (!items_[id].active || items_[id].box.isEmpty()) continue;
+
+        getMatrixAt(id, _matrix);
+        _box.copy(items_[id].box).applyMatrix4(_matrix);
+
+        boundingBox->union_(_box);
+    }
+}
+
+void BatchedMesh::computeBoundingSphere() {
+
+    if (!boundingSphere) boundingSphere = Sphere();
+
+    boundingSphere->makeEmpty();
+
+    for (size_t id = 0; id < items_.size(); id++) {
+
+        if (!items_[id].active || items_[id].sphere.isEmpty()) continue;
+
+        getMatrixAt(id, _matrix);
+        _sphere.copy(items_[id].sphere).applyMatrix4(_matrix);
+
+        if (boundingSphere->isEmpty()) {
+
+            boundingSphere->copy(_sphere);
+
+        } else {
+
+            boundingSphere->union_(_sphere);
+        }
+    }
+}
+
+DataTexture* BatchedMesh::matricesTexture() const {
+
+    return matricesTexture_.get();
+}
+
+int BatchedMesh::matricesTextureSize() const {
+
+    return matricesTextureSize_;
+}
+
+void BatchedMesh::getDrawRanges(const Camera& camera, std::vector<int>& starts, std::vector<int>& counts) const {
+
+    starts.clear();
+    counts.clear();
+
+    const bool indexed = geometry_->hasIndex();
+    const bool cull = perObjectFrustumCulled;
+
+    if (cull) {
+
+        _projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+        _frustum.setFromProjectionMatrix(_projScreenMatrix);
+    }
+
+    for (size_t id = 0; id < items_.size(); id++) {
+
+        const auto& item = items_[id];
+
+        if (!item.active || !item.visible) continue;
+
+        if (cull && !item.sphere.isEmpty()) {
+
+            getMatrixAt(id, _matrix);
+            _matrix.premultiply(matrixWorld);
+            _sphere.copy(item.sphere).applyMatrix4(_matrix);
+
+            if (!_frustum.intersectsSphere(_sphere)) continue;
+        }
+
+        const auto start = indexed ? item.indexStart : item.vertexStart;
+        const auto count = indexed ? item.indexCount : item.vertexCount;
+
+        if (count == 0) continue;
+
+        // geometries are stored back to back, so neighbours merge into a single range
+        if (!starts.empty() && starts.back() + counts.back() == start) {
+
+            counts.back() += count;
+
+        } else {
+
+            starts.emplace_back(start);
+            counts.emplace_back(count);
+        }
+    }
+}
+
+void BatchedMesh::raycast(const Raycaster& raycaster, std::vector<Intersection>& intersects) {
+
+    if (!material()) return;
+
+    if (!_mesh) _mesh = std::make_unique<Mesh>();
+
+    _mesh->setGeometry(geometry_);
+    _mesh->setMaterials(materials_);
+
+    const auto drawRange = geometry_->drawRange;
+    const auto geometryBox = geometry_->boundingBox;
+    const auto geometrySphere = geometry_->boundingSphere;
+
+    const bool indexed = geometry_->hasIndex();
+
+    for (size_t id = 0; id < items_.size(); id++) {
+
+        const auto& item = items_[id];
+
+        if (!item.active || !item.visible || item.sphere.isEmpty()) continue;
+
+        getMatrixAt(id, _matrix);
+        _mesh->matrixWorld.multiplyMatrices(matrixWorld, _matrix);
+
+        // the mesh represents this single geometry, bounded by its own volumes
+        geometry_->boundingBox = item.box;
+        geometry_->boundingSphere = item.sphere;
+        geometry_->setDrawRange(indexed ? item.indexStart : item.vertexStart, indexed ? item.indexCount : item.vertexCount);
+
+        _mesh->raycast(raycaster, _itemIntersects);
+
+        for (auto& intersect : _itemIntersects) {
+
+            intersect.batchId = static_cast<int>(id);
+            intersect.object = this;
+            intersects.emplace_back(intersect);
+        }
+
+        _itemIntersects.clear();
+    }
+
+    geometry_->drawRange = drawRange;
+    geometry_->boundingBox = geometryBox;
+    geometry_->boundingSphere = geometrySphere;
+}
+
+std::shared_ptr<BatchedMesh> BatchedMesh::create(size_t maxGeometryCount, size_t maxVertexCount, size_t maxIndexCount, std::shared_ptr<Material> material) {
+
+    return std::make_shared<BatchedMesh>(maxGeometryCount, maxVertexCount, maxIndexCount, std::move(material));
+}
+
+BatchedMesh::~BatchedMesh() {
+
+    matricesTexture_->dispose();
+}
+
+void BatchedMesh::reserve(const BufferGeometry& geometry) {
+
+    const auto vertexCount = static_cast<int>(maxVertexCount_);
+
+    for (const auto& [name, source] : geometry.getAttributes()) {
+
+        auto attribute = reserveAttribute<float, unsigned int, uint16_t, HalfFloat, int16_t, uint8_t, int8_t>(*source, vertexCount);
+        if (!attribute) {
+
+            throw std::runtime_error("[BatchedMesh] Unsupported type of attribute '" + name + "'.");
+        }
+
+        attribute->setUsage(DrawUsage::Dynamic);
+        geometry_->setAttribute(name, attribute);
+    }
+
+    std::shared_ptr<BufferAttribute> batchId = FloatBufferAttribute::create(std::vector<float>(vertexCount), 1);
+    batchId->setUsage(DrawUsage::Dynamic);
+    geometry_->setAttribute("batchId", batchId);
+
+    if (geometry.hasIndex()) {
+
+        geometry_->setIndex(std::vector<unsigned int>(maxIndexCount_));
+        geometry_->getIndex()->setUsage(DrawUsage::Dynamic);
+    }
+}
+
+void BatchedMesh::checkId(size_t id) const {
+
+    if (id >= items_.size()) {
+
+        throw std::runtime_error("[BatchedMesh] Invalid geometry id " + std::to_string(id) + ".");
+    }
+}
@@ -5,6 +5,11 @@
 
 using namespace threepp;
 
+Group::Group() {
+
+    addKind(this);
+}
+
 std::string Group::type() const {
 
     return "Group";
@@ -1,10 +1,38 @@
 
 #include "threepp/objects/InstancedMesh.hpp"
 
+#include "threepp/cameras/Camera.hpp"
 #include "threepp/core/Raycaster.hpp"
+#include "threepp/math/Frustum.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
 
 using namespace threepp;
 
+namespace {
+
+    // instances per culling task, and per block of the vectorised plane tests
+    constexpr size_t cullGrain = 8192;
+    constexpr size_t cullBlock = 256;
+
+    // cameras whose visible instances are kept, the least recently used one is recomputed for a new camera
+    constexpr size_t maxVisibilities = 8;
+
+    float maxScaleOnAxis(const float* e) {
+
+        const auto scaleXSq = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+        const auto scaleYSq = e[4] * e[4] + e[5] * e[5] + e[6] * e[6];
+        const auto scaleZSq = e[8] * e[8] + e[9] * e[9] + e[10] * e[10];
+
+        return std::sqrt(std::max(scaleXSq, std::max(scaleYSq, scaleZSq)));
+    }
+
+}// namespace
+
 
 InstancedMesh::InstancedMesh(
         std::shared_ptr<BufferGeometry> geometry,
@@ -13,6 +41,8 @@ InstancedMesh::InstancedMesh(
     : Mesh(std::move(geometry), std::move(material)),
       count_(count), maxCount_(count), instanceMatrix_(FloatBufferAttribute::create(std::vector<float>(count * 16), 16)) {
 
+    addKind(this);
+
     Matrix4 identity;
     for (unsigned i = 0; i < count; i++) {
 
@@ -64,11 +94,315 @@ void InstancedMesh::setColorAt(size_t index, const Color& color) {
     }
 
     color.toArray(this->instanceColor_->array(), index * 3);
+
+    invalidateVisibility();
 }
 
-void InstancedMesh::setMatrixAt(size_t index, const Matrix4& matrix) const {
+void InstancedMesh::setMatrixAt(size_t index, const Matrix4& matrix) {
 
     matrix.toArray(this->instanceMatrix_->array(), index * 16);
+
+    // the bounds of the mesh depend on every instance
+    boundingBox.reset();
+    boundingSphere.reset();
+    invalidateVisibility();
+}
+
+void InstancedMesh::addLevel(std::shared_ptr<BufferGeometry> geometry, float distance) {
+
+    if (levels_.size() >= 126) {
+
+        throw std::runtime_error("[InstancedMesh] Too many levels.");
+    }
+
+    levels_.emplace_back(Level{std::move(geometry), distance});
+    std::ranges::stable_sort(levels_, {}, &Level::distance);
+
+    // the bounds of the mesh cover every level
+    boundingBox.reset();
+    boundingSphere.reset();
+    invalidateVisibility();
+}
+
+const std::vector<InstancedMesh::Level>& InstancedMesh::levels() const {
+
+    return levels_;
+}
+
+bool InstancedMesh::hasVisibilityPipeline() const {
+
+    return perInstanceFrustumCulled || !levels_.empty();
+}
+
+FloatBufferAttribute* InstancedMesh::visibleInstanceMatrix() const {
+
+    return currentVisibility_ ? currentVisibility_->matrix.get() : nullptr;
+}
+
+FloatBufferAttribute* InstancedMesh::visibleInstanceColor() const {
+
+    return instanceColor_ && currentVisibility_ ? currentVisibility_->color.get() : nullptr;
+}
+
+std::vector<FloatBufferAttribute*> InstancedMesh::visibleInstanceBuffers() const {
+
+    std::vector<FloatBufferAttribute*> buffers;
+    for (const auto& visibility : visibilities_) {
+
+        if (visibility.matrix) buffers.emplace_back(visibility.matrix.get());
+        if (visibility.color) buffers.emplace_back(visibility.color.get());
+    }
+
+    return buffers;
+}
+
+InstancedMesh::Visibility& InstancedMesh::visibilityFor(const Camera& camera) {
+
+    // never reallocated, so that currentVisibility_ stays valid
+    visibilities_.reserve(maxVisibilities);
+
+    auto visibility = std::ranges::find(visibilities_, camera.id, &Visibility::cameraId);
+
+    if (visibility == visibilities_.end()) {
+
+        if (visibilities_.size() < maxVisibilities) {
+
+            visibility = visibilities_.emplace(visibilities_.end());
+
+        } else {
+
+            visibility = std::ranges::min_element(visibilities_, {}, &Visibility::lastUse);
+            visibility->key.reset();
+        }
+
+        visibility->cameraId = camera.id;
+    }
+
+    visibility->lastUse = ++visibilityUses_;
+
+    return *visibility;
+}
+
+void InstancedMesh::invalidateVisibility() {
+
+    for (auto& visibility : visibilities_) visibility.key.reset();
+}
+
+const std::vector<InstancedMesh::InstanceRange>& InstancedMesh::updateVisibleInstances(const Camera& camera, ThreadPool* pool) {
+
+    Matrix4 projScreenMatrix;
+    projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+
+    VisibilityKey key{projScreenMatrix, matrixWorld,
+                      instanceMatrix_->version, instanceColor_ ? instanceColor_->version : 0,
+                      count_, levels_.size()};
+
+    auto& visibility = visibilityFor(camera);
+    currentVisibility_ = &visibility;
+
+    if (visibility.key == key) return visibility.ranges;
+    visibility.key = key;
+
+    const auto count = count_;
+    const auto numLevels = levels_.size() + 1;
+
+    if (!visibility.matrix) {
+
+        visibility.matrix = FloatBufferAttribute::create(std::vector<float>(maxCount_ * 16), 16);
+        visibility.matrix->setUsage(DrawUsage::Dynamic);
+    }
+
+    if (instanceColor_ && !visibility.color) {
+
+        visibility.color = FloatBufferAttribute::create(std::vector<float>(maxCount_ * 3), 3);
+        visibility.color->setUsage(DrawUsage::Dynamic);
+    }
+
+    instanceLevels_.resize(count);
+
+    // bounding spheres of the levels, tested once moved by the instance and mesh matrices (radius scaled conservatively)
+    std::vector<Sphere> spheres(numLevels);
+    for (size_t level = 0; level < numLevels; level++) {
+
+        auto& geometry = level == 0 ? geometry_ : levels_[level - 1].geometry;
+        if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+
+        spheres[level] = *geometry->boundingSphere;
+    }
+
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projScreenMatrix);
+
+    const bool cull = perInstanceFrustumCulled;
+    const auto& planes = frustum.planes();
+    const auto& w = matrixWorld.elements;
+    const auto worldScale = maxScaleOnAxis(w.data());
+
+    Vector3 cameraPosition;
+    cameraPosition.setFromMatrixPosition(camera.matrixWorld);
+
+    std::vector<float> levelDistancesSq(numLevels, 0);
+    for (size_t level = 1; level < numLevels; level++) {
+
+        levelDistancesSq[level] = levels_[level - 1].distance * levels_[level - 1].distance;
+    }
+
+    const auto& matrices = instanceMatrix_->array();
+
+    const auto numChunks = (count + cullGrain - 1) / cullGrain;
+    std::vector<int> chunkCounts(numChunks * numLevels);
+
+    // pass 1: classify each instance, counting the visible ones per chunk and level
+    auto classify = [&](size_t chunk) {
+        const auto begin = chunk * cullGrain;
+        const auto end = std::min(count, begin + cullGrain);
+
+        // structure of arrays, and no branches, so that the loops below vectorise
+        float cx[cullBlock], cy[cullBlock], cz[cullBlock], r[cullBlock], d[cullBlock];
+        int level[cullBlock], inside[cullBlock];
+
+        // per level, shifted by one so that culled instances land in slot 0
+        std::vector<int> counts(numLevels + 1);
+
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += cullBlock) {
+
+            const auto n = std::min(cullBlock, end - blockBegin);
+
+            // level from the distance of the instance origin, in world space
+            for (size_t j = 0; j < n; j++) {
+
+                const auto e = &matrices[(blockBegin + j) * 16];
+
+                const auto x = w[0] * e[12] + w[4] * e[13] + w[8] * e[14] + w[12] - cameraPosition.x;
+                const auto y = w[1] * e[12] + w[5] * e[13] + w[9] * e[14] + w[13] - cameraPosition.y;
+                const auto z = w[2] * e[12] + w[6] * e[13] + w[10] * e[14] + w[14] - cameraPosition.z;
+                d[j] = x * x + y * y + z * z;
+                level[j] = 0;
+                inside[j] = 1;
+            }
+
+            for (size_t k = 1; k < numLevels; k++) {
+
+                const auto distanceSq = levelDistancesSq[k];
+                for (size_t j = 0; j < n; j++) {
+
+                    level[j] += d[j] >= distanceSq;
+                }
+            }
+
+            // sphere of that level moved by the instance, then by the mesh
+            for (size_t j = 0; j < n; j++) {
+
+                const auto e = &matrices[(blockBegin + j) * 16];
+                const auto& sphere = spheres[level[j]];
+                const auto& c = sphere.center;
+
+                const auto lx = e[0] * c.x + e[4] * c.y + e[8] * c.z + e[12];
+                const auto ly = e[1] * c.x + e[5] * c.y + e[9] * c.z + e[13];
+                const auto lz = e[2] * c.x + e[6] * c.y + e[10] * c.z + e[14];
+
+                cx[j] = w[0] * lx + w[4] * ly + w[8] * lz + w[12];
+                cy[j] = w[1] * lx + w[5] * ly + w[9] * lz + w[13];
+                cz[j] = w[2] * lx + w[6] * ly + w[10] * lz + w[14];
+                r[j] = sphere.radius * maxScaleOnAxis(e) * worldScale;
+            }
+
+            if (cull) {
+
+                for (const auto& plane : planes) {
+
+                    const auto nx = plane.normal.x, ny = plane.normal.y, nz = plane.normal.z, pc = plane.constant;
+
+                    for (size_t j = 0; j < n; j++) {
+
+                        inside[j] &= nx * cx[j] + ny * cy[j] + nz * cz[j] + pc >= -r[j];
+                    }
+                }
+            }
+
+            for (size_t j = 0; j < n; j++) {
+
+                const auto l = inside[j] * (level[j] + 1) - 1;
+                instanceLevels_[blockBegin + j] = static_cast<int8_t>(l);
+                ++counts[l + 1];
+            }
+        }
+
+        std::copy(counts.begin() + 1, counts.end(), &chunkCounts[chunk * numLevels]);
+    };
+
+    if (pool && numChunks > 1) {
+
+        pool->parallelFor(numChunks, classify);
+
+    } else {
+
+        for (size_t chunk = 0; chunk < numChunks; chunk++) classify(chunk);
+    }
+
+    // where each chunk writes its instances of each level, levels laid out one after the other
+    auto& ranges = visibility.ranges;
+    ranges.clear();
+
+    int offset = 0;
+    for (size_t level = 0; level < numLevels; level++) {
+
+        auto& range = ranges.emplace_back(InstanceRange{level == 0 ? nullptr : levels_[level - 1].geometry.get(), offset, 0});
+
+        for (size_t chunk = 0; chunk < numChunks; chunk++) {
+
+            const auto chunkCount = std::exchange(chunkCounts[chunk * numLevels + level], offset);
+            offset += chunkCount;
+            range.count += chunkCount;
+        }
+    }
+
+    // pass 2: compact
+    auto& visibleMatrices = visibility.matrix->array();
+    const auto colors = instanceColor_ ? &instanceColor_->array() : nullptr;
+    const auto visibleColors = instanceColor_ ? &visibility.color->array() : nullptr;
+
+    auto compact = [&](size_t chunk) {
+        const auto begin = chunk * cullGrain;
+        const auto end = std::min(count, begin + cullGrain);
+
+        const auto offsets = &chunkCounts[chunk * numLevels];
+
+        for (size_t i = begin; i < end; i++) {
+
+            const auto level = instanceLevels_[i];
+            if (level < 0) continue;
+
+            const auto target = offsets[level]++;
+
+            std::copy_n(&matrices[i * 16], 16, &visibleMatrices[target * 16]);
+            if (colors) std::copy_n(&(*colors)[i * 3], 3, &(*visibleColors)[target * 3]);
+        }
+    };
+
+    if (pool && numChunks > 1) {
+
+        pool->parallelFor(numChunks, compact);
+
+    } else {
+
+        for (size_t chunk = 0; chunk < numChunks; chunk++) compact(chunk);
+    }
+
+    // only the visible part is uploaded
+    if (offset > 0) {
+
+        visibility.matrix->addUpdateRange(0, offset * 16);
+        visibility.matrix->needsUpdate();
+
+        if (visibleColors) {
+
+            visibility.color->addUpdateRange(0, offset * 3);
+            visibility.color->needsUpdate();
+        }
+    }
+
+    return ranges;
 }
 
 void InstancedMesh::dispose() {
@@ -95,11 +429,11 @@ void InstancedMesh::raycast(const Raycaster& raycaster, std::vector<Intersection
 
         this->getMatrixAt(instanceId, _instanceLocalMatrix);
 
-        _instanceWorldMatrix.multiplyMatrices(*matrixWorld, _instanceLocalMatrix);
+        _instanceWorldMatrix.multiplyMatrices(matrixWorld, _instanceLocalMatrix);
 
         // the mesh represents this single instance
 
-        _mesh.matrixWorld->copy(_instanceWorldMatrix);
+        _mesh.matrixWorld.copy(_instanceWorldMatrix);
 
         _mesh.raycast(raycaster, _instanceIntersects);
 
@@ -130,7 +464,6 @@ std::shared_ptr<InstancedMesh> InstancedMesh::create(
 
 void InstancedMesh::computeBoundingBox() {
 
-    const auto geometry = this->geometry();
     const auto count = this->count_;
 
     if (!this->boundingBox) {
@@ -138,9 +471,14 @@ void InstancedMesh::computeBoundingBox() {
         this->boundingBox = Box3();
     }
 
-    if (!geometry->boundingBox) {
+    // bounds of the geometry of every level, any of which an instance may be drawn with
+    Box3 levelsBox;
+    for (size_t level = 0; level <= levels_.size(); level++) {
 
-        geometry->computeBoundingBox();
+        auto& geometry = level == 0 ? geometry_ : levels_[level - 1].geometry;
+        if (!geometry->boundingBox) geometry->computeBoundingBox();
+
+        levelsBox.union_(*geometry->boundingBox);
     }
 
     this->boundingBox->makeEmpty();
@@ -149,7 +487,7 @@ void InstancedMesh::computeBoundingBox() {
 
         this->getMatrixAt(i, _instanceLocalMatrix);
 
-        _box3.copy(*geometry->boundingBox).applyMatrix4(_instanceLocalMatrix);
+        _box3.copy(levelsBox).applyMatrix4(_instanceLocalMatrix);
 
         this->boundingBox->union_(_box3);
     }
@@ -157,7 +495,6 @@ void InstancedMesh::computeBoundingBox() {
 
 void InstancedMesh::computeBoundingSphere() {
 
-    const auto geometry = this->geometry();
     const auto count = this->count_;
 
     if (!this->boundingSphere) {
@@ -165,9 +502,13 @@ void InstancedMesh::computeBoundingSphere() {
         this->boundingSphere = Sphere();
     }
 
-    if (!geometry->boundingSphere) {
+    Sphere levelsSphere;
+    for (size_t level = 0; level <= levels_.size(); level++) {
+
+        auto& geometry = level == 0 ? geometry_ : levels_[level - 1].geometry;
+        if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
-        geometry->computeBoundingSphere();
+        levelsSphere.union_(*geometry->boundingSphere);
     }
 
     this->boundingSphere->makeEmpty();
@@ -176,7 +517,7 @@ void InstancedMesh::computeBoundingSphere() {
 
         this->getMatrixAt(i, _instanceLocalMatrix);
 
-        _sphere.copy(*geometry->boundingSphere).applyMatrix4(_instanceLocalMatrix);
+        _sphere.copy(levelsSphere).applyMatrix4(_instanceLocalMatrix);
 
         this->boundingSphere->union_(_sphere);
     }
@@ -7,6 +7,11 @@
 
 using namespace threepp;
 
+LOD::LOD() {
+
+    addKind(this);
+}
+
 std::string LOD::type() const {
 
     return "LOD";
@@ -66,13 +71,13 @@ size_t LOD::getCurrentLevel() const {
 
 void LOD::update(Camera& camera) {
 
-    static Vector3 _v1;
-    static Vector3 _v2;
+    Vector3 _v1;
+    Vector3 _v2;
 
     if (levels.size() > 1) {
 
-        _v1.setFromMatrixPosition(*camera.matrixWorld);
-        _v2.setFromMatrixPosition(*this->matrixWorld);
+        _v1.setFromMatrixPosition(camera.matrixWorld);
+        _v2.setFromMatrixPosition(this->matrixWorld);
 
         float distance = _v1.distanceTo(_v2) / camera.zoom;
 
@@ -1,6 +1,7 @@
 
 #include "threepp/objects/Line.hpp"
 #include "threepp/materials/LineBasicMaterial.hpp"
+#include "threepp/objects/LineSegments.hpp"
 
 #include "threepp/core/Raycaster.hpp"
 
@@ -20,7 +21,10 @@ namespace {
 
 Line::Line(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material)
     : geometry_(geometry ? std::move(geometry) : BufferGeometry::create()),
-      ObjectWithMaterials({material ? std::move(material) : LineBasicMaterial::create()}) {}
+      ObjectWithMaterials({material ? std::move(material) : LineBasicMaterial::create()}) {
+
+    addKind(this);
+}
 
 std::string Line::type() const {
 
@@ -82,14 +86,14 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
     _sphere.copy(*geometry->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
+    _sphere.applyMatrix4(matrixWorld);
     _sphere.radius += threshold;
 
     if (!raycaster.ray.intersectsSphere(_sphere)) return;
 
     //
 
-    _inverseMatrix.copy(*matrixWorld).invert();
+    _inverseMatrix.copy(matrixWorld).invert();
     _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
 
     const auto localThreshold = threshold / ((this->scale.x + this->scale.y + this->scale.z) / 3);
@@ -99,7 +103,7 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
     Vector3 vEnd;
     Vector3 interSegment;
     Vector3 interRay;
-    const auto step = type() == "LineSegments" ? 2 : 1;
+    const auto step = is<LineSegments>() ? 2 : 1;
 
     auto index = geometry->getIndex();
     auto positionAttribute = geometry->getAttribute<float>("position");
@@ -121,7 +125,7 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
 
             if (distSq > localThresholdSq) continue;
 
-            interRay.applyMatrix4(*this->matrixWorld);//Move back to world space for distance calculation
+            interRay.applyMatrix4(this->matrixWorld);//Move back to world space for distance calculation
 
             const auto distance = raycaster.ray.origin.distanceTo(interRay);
 
@@ -129,7 +133,7 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
 
             Intersection intersection;
             intersection.distance = distance;
-            intersection.point = interSegment.clone().applyMatrix4(*this->matrixWorld);
+            intersection.point = interSegment.clone().applyMatrix4(this->matrixWorld);
             intersection.index = i;
             intersection.object = this;
 
@@ -150,7 +154,7 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
 
             if (distSq > localThresholdSq) continue;
 
-            interRay.applyMatrix4(*this->matrixWorld);//Move back to world space for distance calculation
+            interRay.applyMatrix4(this->matrixWorld);//Move back to world space for distance calculation
 
             const auto distance = raycaster.ray.origin.distanceTo(interRay);
 
@@ -158,7 +162,7 @@ void Line::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
 
             Intersection intersection;
             intersection.distance = distance;
-            intersection.point = interSegment.clone().applyMatrix4(*this->matrixWorld);
+            intersection.point = interSegment.clone().applyMatrix4(this->matrixWorld);
             intersection.index = i;
             intersection.object = this;
 
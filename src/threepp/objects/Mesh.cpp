@@ -36,7 +36,7 @@ namespace {
         if (point.isNan()) return std::nullopt;
 
         _intersectionPointWorld.copy(point);
-        _intersectionPointWorld.applyMatrix4(*object.matrixWorld);
+        _intersectionPointWorld.applyMatrix4(object.matrixWorld);
 
         const auto distance = raycaster.ray.origin.distanceTo(_intersectionPointWorld);
 
@@ -174,10 +174,16 @@ namespace {
 
 Mesh::Mesh(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material)
     : geometry_(geometry ? std::move(geometry) : BufferGeometry::create()),
-      ObjectWithMaterials({material ? std::move(material) : MeshBasicMaterial::create()}) {}
+      ObjectWithMaterials({material ? std::move(material) : MeshBasicMaterial::create()}) {
+
+    addKind(this);
+}
 
 Mesh::Mesh(std::shared_ptr<BufferGeometry> geometry, std::vector<std::shared_ptr<Material>> materials)
-    : geometry_(std::move(geometry)), ObjectWithMaterials{std::move(materials)} {}
+    : geometry_(std::move(geometry)), ObjectWithMaterials{std::move(materials)} {
+
+    addKind(this);
+}
 
 void Mesh::raycast(const Raycaster& raycaster, std::vector<Intersection>& intersects) {
 
@@ -190,7 +196,7 @@ void Mesh::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
     if (!geometry_->boundingSphere) geometry_->computeBoundingSphere();
 
     _sphere.copy(*geometry_->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
+    _sphere.applyMatrix4(matrixWorld);
 
     if (!raycaster.ray.intersectsSphere(_sphere)) return;
 
@@ -199,7 +205,7 @@ void Mesh::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
     static Ray _ray{};
     static Matrix4 _inverseMatrix{};
 
-    _inverseMatrix.copy(*matrixWorld).invert();
+    _inverseMatrix.copy(matrixWorld).invert();
     _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
 
     // Check boundingBox before continuing
@@ -220,7 +226,8 @@ void Mesh::raycast(const Raycaster& raycaster, std::vector<Intersection>& inters
     const auto groups = geometry_->groups;
     const auto drawRange = geometry_->drawRange;
 
-    if (index != nullptr) {
+    // only float positions can be raycast, compact (quantized) positions are skipped
+    if (index != nullptr && position != nullptr) {
 
         // indexed buffer geometry
 
@@ -7,7 +7,10 @@ using namespace threepp;
 
 
 ObjectWithMaterials::ObjectWithMaterials(std::vector<std::shared_ptr<Material>> materials)
-    : materials_(std::move(materials)) {}
+    : materials_(std::move(materials)) {
+
+    addKind(this);
+}
 
 
 std::shared_ptr<Material> ObjectWithMaterials::material() const {
@@ -266,6 +266,12 @@ struct ParticleSystem::Impl {
         particleGeometry->setAttribute("customColor", FloatBufferAttribute::create(std::vector<float>(particleCount * 3), 3));
         particleGeometry->setAttribute("customOpacity", FloatBufferAttribute::create(std::vector<float>(particleCount), 1));
 
+        // rewritten every frame
+        for (const auto& [name, attribute] : particleGeometry->getAttributes()) {
+
+            attribute->setUsage(DrawUsage::Dynamic);
+        }
+
         if (settings.texture) {
             particleMaterial->uniforms["tex"].setValue(settings.texture.get());
             particleMaterial->depthWrite = false;
@@ -49,7 +49,10 @@ namespace {
 }// namespace
 
 Points::Points(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material)
-    : geometry_(std::move(geometry)), ObjectWithMaterials({std::move(material)}) {}
+    : geometry_(std::move(geometry)), ObjectWithMaterials({std::move(material)}) {
+
+    addKind(this);
+}
 
 std::string Points::type() const {
 
@@ -82,14 +85,14 @@ void Points::raycast(const Raycaster& raycaster, std::vector<Intersection>& inte
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
     _sphere.copy(*geometry->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
+    _sphere.applyMatrix4(matrixWorld);
     _sphere.radius += threshold;
 
     if (!raycaster.ray.intersectsSphere(_sphere)) return;
 
     //
 
-    _inverseMatrix.copy(*matrixWorld).invert();
+    _inverseMatrix.copy(matrixWorld).invert();
     _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
 
     const auto localThreshold = threshold / ((this->scale.x + this->scale.y + this->scale.z) / 3);
@@ -109,7 +112,7 @@ void Points::raycast(const Raycaster& raycaster, std::vector<Intersection>& inte
 
             positionAttribute->setFromBufferAttribute(_position, a);
 
-            testPoint(_position, a, localThresholdSq, *matrixWorld, raycaster, intersects, this);
+            testPoint(_position, a, localThresholdSq, matrixWorld, raycaster, intersects, this);
         }
 
     } else {
@@ -121,7 +124,7 @@ void Points::raycast(const Raycaster& raycaster, std::vector<Intersection>& inte
 
             positionAttribute->setFromBufferAttribute(_position, i);
 
-            testPoint(_position, i, localThresholdSq, *matrixWorld, raycaster, intersects, this);
+            testPoint(_position, i, localThresholdSq, matrixWorld, raycaster, intersects, this);
         }
     }
 }
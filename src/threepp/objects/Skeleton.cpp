@@ -61,7 +61,7 @@ void Skeleton::calculateInverses() {
 
         if (bone) {
 
-            inverse.copy(*bone->matrixWorld).invert();
+            inverse.copy(bone->matrixWorld).invert();
         }
 
         this->boneInverses.emplace_back(inverse);
@@ -78,7 +78,7 @@ void Skeleton::pose() {
 
         if (bone) {
 
-            bone->matrixWorld->copy(this->boneInverses[i]).invert();
+            bone->matrixWorld.copy(this->boneInverses[i]).invert();
         }
     }
 
@@ -90,15 +90,15 @@ void Skeleton::pose() {
 
             if (bone->parent && bone->parent->is<Bone>()) {
 
-                bone->matrix->copy(*bone->parent->matrixWorld).invert();
-                bone->matrix->multiply(*bone->matrixWorld);
+                bone->matrix.copy(bone->parent->matrixWorld).invert();
+                bone->matrix.multiply(bone->matrixWorld);
 
             } else {
 
-                bone->matrix->copy(*bone->matrixWorld);
+                bone->matrix.copy(bone->matrixWorld);
             }
 
-            bone->matrix->decompose(bone->position, bone->quaternion, bone->scale);
+            bone->matrix.decompose(bone->position, bone->quaternion, bone->scale);
         }
     }
 }
@@ -111,7 +111,7 @@ void Skeleton::update() {
 
         // compute the offset between the current and the original transform
 
-        const auto& matrix = bones[i] ? *bones[i]->matrixWorld : _identityMatrix;
+        const auto& matrix = bones[i] ? bones[i]->matrixWorld : _identityMatrix;
 
         _offsetMatrix.multiplyMatrices(matrix, boneInverses[i]);
         _offsetMatrix.toArray(boneMatrices, i * 16);
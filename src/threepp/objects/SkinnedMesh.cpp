@@ -17,7 +17,10 @@ namespace {
 
 
 SkinnedMesh::SkinnedMesh(const std::shared_ptr<BufferGeometry>& geometry, const std::shared_ptr<Material>& material)
-    : Mesh(geometry, material) {}
+    : Mesh(geometry, material) {
+
+    addKind(this);
+}
 
 
 std::string SkinnedMesh::type() const {
@@ -35,7 +38,7 @@ void SkinnedMesh::bind(const std::shared_ptr<Skeleton>& skeleton, std::optional<
 
         this->skeleton->calculateInverses();
 
-        bindMatrix = *this->matrixWorld;
+        bindMatrix = this->matrixWorld;
     }
 
     this->bindMatrix.copy(*bindMatrix);
@@ -79,7 +82,7 @@ void SkinnedMesh::updateMatrixWorld(bool force) {
     Object3D::updateMatrixWorld(force);
 
     if (this->bindMode == BindMode::Attached) {
-        this->bindMatrixInverse.copy(*this->matrixWorld).invert();
+        this->bindMatrixInverse.copy(this->matrixWorld).invert();
     } else {
         this->bindMatrixInverse.copy(this->bindMatrix).invert();
     }
@@ -103,7 +106,7 @@ void SkinnedMesh::boneTransform(size_t index, Vector3& target) {
 
             auto boneIndex = static_cast<int>(_skinIndex[i]);
 
-            _matrix.multiplyMatrices(*skeleton->bones[boneIndex]->matrixWorld, skeleton->boneInverses[boneIndex]);
+            _matrix.multiplyMatrices(skeleton->bones[boneIndex]->matrixWorld, skeleton->boneInverses[boneIndex]);
 
             target.addScaledVector(_vector.copy(_basePosition).applyMatrix4(_matrix), weight);
         }
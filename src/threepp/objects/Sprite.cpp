@@ -66,6 +66,8 @@ Sprite::Sprite(const std::shared_ptr<SpriteMaterial>& material)
     : _material(material ? material : SpriteMaterial::create()),
       _geometry(BufferGeometry::create()) {
 
+    addKind(this);
+
     std::vector<float> float32Array{
             -0.5f, -0.5f, 0.f, 0.f, 0.f,
             0.5f, -0.5f, 0.f, 1.f, 0.f,
@@ -110,10 +112,10 @@ void Sprite::raycast(const Raycaster& raycaster, std::vector<Intersection>& inte
         throw std::runtime_error("THREE.Sprite: 'Raycaster.camera' needs to be set in order to raycast against sprites.");
     }
 
-    _worldScale.setFromMatrixScale(*this->matrixWorld);
+    _worldScale.setFromMatrixScale(this->matrixWorld);
 
-    _viewWorldMatrix.copy(*raycaster.camera->matrixWorld);
-    this->modelViewMatrix.multiplyMatrices(raycaster.camera->matrixWorldInverse, *this->matrixWorld);
+    _viewWorldMatrix.copy(raycaster.camera->matrixWorld);
+    this->modelViewMatrix.multiplyMatrices(raycaster.camera->matrixWorldInverse, this->matrixWorld);
 
     _mvPosition.setFromMatrixPosition(this->modelViewMatrix);
 
@@ -7,6 +7,7 @@
 #include "threepp/renderers/gl/GLBackground.hpp"
 #include "threepp/renderers/gl/GLBindingStates.hpp"
 #include "threepp/renderers/gl/GLBufferRenderer.hpp"
+#include "threepp/renderers/gl/GLClusteredLights.hpp"
 #include "threepp/renderers/gl/GLCubeMaps.hpp"
 #include "threepp/renderers/gl/GLGeometries.hpp"
 #include "threepp/renderers/gl/GLMaterials.hpp"
@@ -16,11 +17,15 @@
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 #include "threepp/renderers/gl/GLRenderStates.hpp"
 #include "threepp/renderers/gl/GLTextures.hpp"
+#include "threepp/renderers/gl/GLUniformBlocks.hpp"
 #include "threepp/renderers/gl/GLUtils.hpp"
 
 #include "threepp/cameras/OrthographicCamera.hpp"
+#include "threepp/core/InstancedBufferGeometry.hpp"
+#include "threepp/materials/MeshToonMaterial.hpp"
 #include "threepp/materials/RawShaderMaterial.hpp"
 
+#include "threepp/objects/BatchedMesh.hpp"
 #include "threepp/objects/Group.hpp"
 #include "threepp/objects/InstancedMesh.hpp"
 #include "threepp/objects/LOD.hpp"
@@ -31,6 +36,8 @@
 #include "threepp/objects/SkinnedMesh.hpp"
 #include "threepp/objects/Sprite.hpp"
 
+#include "threepp/utils/ThreadPool.hpp"
+
 #ifndef EMSCRIPTEN
 #include "threepp/utils/LoadGlad.hpp"
 #else
@@ -38,6 +45,7 @@
 #endif
 
 #include <cmath>
+#include <unordered_set>
 
 
 using namespace threepp;
@@ -99,6 +107,13 @@ struct GLRenderer::Impl {
 
     std::vector<unsigned int> _currentDrawBuffers;
 
+    // batched draw ranges
+    std::vector<int> _multiDrawStarts;
+    std::vector<int> _multiDrawCounts;
+
+    // instances being drawn by renderVisibleInstances
+    const InstancedMesh::InstanceRange* currentInstanceRange = nullptr;
+
     // frustum
 
     Frustum _frustum;
@@ -130,6 +145,10 @@ struct GLRenderer::Impl {
     gl::GLObjects objects;
     gl::GLMorphTargets morphTargets;
     gl::GLPrograms programCache;
+    gl::GLUniformBlocks uniformBlocks;
+    gl::GLClusteredLights clusteredLights;
+    // reused between getProgram calls to avoid reallocating the key data
+    std::string programCacheKeyData;
     gl::GLCubeMaps cubemaps;
     gl::GLBackground background;
 
@@ -149,10 +168,10 @@ struct GLRenderer::Impl {
           textures(state, properties, _info),
           objects(geometries, attributes, _info),
           renderLists(properties),
-          shadowMap(objects),
+          shadowMap(objects, properties),
           materials(properties),
           background(scope, cubemaps, state, objects, parameters.premultipliedAlpha),
-          programCache(bindingStates, clipping),
+          programCache(bindingStates, clipping, _info),
           _currentDrawBuffers(GL_BACK),
           _emptyScene(std::make_unique<Scene>()),
           onMaterialDispose(this) {
@@ -186,8 +205,100 @@ struct GLRenderer::Impl {
         }
     }
 
+    struct PendingCompile {
+
+        std::vector<int> programIds;
+        std::function<void()> onReady;
+    };
+
+    std::vector<PendingCompile> pendingCompiles;
+
+    void compile(Object3D* scene, Camera* camera, bool async, const std::function<void()>& onReady) {
+
+        currentRenderState = renderStates.get(scene, renderStateStack.size());
+        currentRenderState->init();
+
+        renderStateStack.emplace_back(currentRenderState);
+
+        scene->traverseVisible([&](Object3D& object) {
+            if (auto light = object.as<Light>()) {
+
+                if (object.layers.test(camera->layers)) pushLight(light);
+            }
+        });
+
+        currentRenderState->setupLights(scope.clusteredLighting);
+
+        programCache.asyncLinking = async;
+
+        PendingCompile pendingCompile{{}, onReady};
+        std::unordered_set<Material*> compiled;
+
+        scene->traverse([&](Object3D& object) {
+            auto objectWithMaterials = object.as<ObjectWithMaterials>();
+            if (!objectWithMaterials) return;
+
+            for (const auto& material : objectWithMaterials->materials()) {
+
+                if (!material || !compiled.insert(material.get()).second) continue;
+
+                auto program = getProgram(material.get(), scene, &object);
+
+                if (programCache.isPending(program->id)) {
+
+                    pendingCompile.programIds.emplace_back(program->id);
+                }
+            }
+        });
+
+        programCache.asyncLinking = false;
+
+        renderStateStack.pop_back();
+        currentRenderState = renderStateStack.empty() ? nullptr : renderStateStack.back();
+
+        if (!onReady) return;
+
+        if (pendingCompile.programIds.empty()) {
+
+            onReady();
+
+        } else {
+
+            pendingCompiles.emplace_back(std::move(pendingCompile));
+        }
+    }
+
+    void pollPendingCompiles() {
+
+        programCache.pollPending();
+
+        // callbacks may start new compilations, so collect the finished ones first
+        std::vector<std::function<void()>> ready;
+
+        std::erase_if(pendingCompiles, [&](PendingCompile& pendingCompile) {
+            for (auto id : pendingCompile.programIds) {
+
+                if (programCache.isPending(id)) return false;
+            }
+
+            ready.emplace_back(std::move(pendingCompile.onReady));
+            return true;
+        });
+
+        for (const auto& onReady : ready) {
+
+            onReady();
+        }
+    }
+
     void render(Object3D* scene, Camera* camera) {
 
+        pollPendingCompiles();
+
+        uniformBlocks.invalidate();
+        attributes.streaming = scope.streamingUploads;
+        attributes.packStaticBuffers = scope.packStaticBuffers;
+
         // update scene graph
 
         if (auto _scene = scene->as<Scene>()) {
@@ -217,7 +328,14 @@ struct GLRenderer::Impl {
 
         renderListStack.emplace_back(currentRenderList);
 
-        projectObject(scene, camera, 0, scope.sortObjects);
+        if (scope.parallelProjection) {
+
+            projectObjectParallel(scene, camera, scope.sortObjects);
+
+        } else {
+
+            projectObject(scene, camera, 0, scope.sortObjects);
+        }
 
         currentRenderList->finish();
 
@@ -234,9 +352,24 @@ struct GLRenderer::Impl {
 
         shadowMap.render(scope, shadowsArray, scene, camera);
 
-        currentRenderState->setupLights();
+        currentRenderState->setupLights(scope.clusteredLighting);
         currentRenderState->setupLightsView(camera);
 
+        if (scope.clusteredLighting) {
+
+            constexpr size_t parallelClusteredLights = 64;
+
+            const auto& clustered = currentRenderState->getLights().state.clusteredLights;
+            const bool parallel = scope.parallelProjection && clustered.size() >= parallelClusteredLights;
+
+            if (parallel && !projectionPool) projectionPool = std::make_unique<ThreadPool>();
+
+            clusteredLights.update(clustered, *camera, parallel ? projectionPool.get() : nullptr);
+        }
+
+        // the shadow pass may have uploaded its own cameras, and the light state has just been refreshed
+        uniformBlocks.invalidate();
+
         if (_clippingEnabled) clipping.endShadows();
 
         //
@@ -252,8 +385,8 @@ struct GLRenderer::Impl {
         auto& opaqueObjects = currentRenderList->opaque;
         auto& transparentObjects = currentRenderList->transparent;
         //
-        if (!opaqueObjects.empty()) renderObjects(opaqueObjects, scene, camera);
-        if (!transparentObjects.empty()) renderObjects(transparentObjects, scene, camera);
+        if (!opaqueObjects.empty()) renderObjects(*currentRenderList, opaqueObjects, scene, camera);
+        if (!transparentObjects.empty()) renderObjects(*currentRenderList, transparentObjects, scene, camera);
 
         //
 
@@ -281,6 +414,8 @@ struct GLRenderer::Impl {
         _currentMaterialId = std::nullopt;
         _currentCamera = nullptr;
 
+        uniformBlocks.invalidate();
+
         renderStateStack.pop_back();
 
         if (!renderStateStack.empty()) {
@@ -312,17 +447,25 @@ struct GLRenderer::Impl {
             scene = _emptyScene.get();
         }
 
+        if (auto im = object->as<InstancedMesh>(); im && im->hasVisibilityPipeline() && !currentInstanceRange) {
+
+            renderVisibleInstances(camera, _scene, geometry, material, im, group);
+            return;
+        }
+
         bool isMesh = object->is<Mesh>();
-        const auto frontFaceCW = (isMesh && object->matrixWorld->determinant() < 0);
+        const auto frontFaceCW = (isMesh && object->matrixWorld.determinant() < 0);
 
         auto program = setProgram(camera, scene, material, object);
 
+        if (!program) return;
+
         state.setMaterial(material, frontFaceCW);
 
         //
 
         auto index = geometry->getIndex();
-        const auto& position = geometry->getAttribute<float>("position");
+        const auto position = geometry->getAttribute("position");
 
         //
 
@@ -339,7 +482,7 @@ struct GLRenderer::Impl {
 
         int rangeFactor = 1;
 
-        auto wireframeMaterial = dynamic_cast<MaterialWithWireframe*>(material);
+        auto wireframeMaterial = material->as<MaterialWithWireframe>();
         bool isWireframeMaterial = wireframeMaterial != nullptr;
 
         if (isWireframeMaterial && wireframeMaterial->wireframe) {
@@ -354,7 +497,7 @@ struct GLRenderer::Impl {
             }
         }
 
-        bindingStates.setup(object, material, program, geometry, index);
+        bindingStates.setup(object, material, program, geometry, index, currentInstanceRange ? currentInstanceRange->start : 0);
 
         gl::BufferRenderer* renderer = bufferRenderer.get();
 
@@ -430,21 +573,74 @@ struct GLRenderer::Impl {
 
         if (auto im = object->as<InstancedMesh>()) {
 
-            renderer->renderInstances(drawStart, drawCount, im->count());
+            renderer->renderInstances(drawStart, drawCount, currentInstanceRange ? currentInstanceRange->count : static_cast<int>(im->count()));
 
-        } /*else if (auto g = dynamic_cast<InstancedBufferGeometry*>(geometry)) {
+        } else if (auto bm = object->as<BatchedMesh>()) {
 
-            const auto instanceCount = std::min(g->instanceCount, g->_maxInstanceCount);
+            bm->getDrawRanges(*camera, _multiDrawStarts, _multiDrawCounts);
 
-            renderer->renderInstances(drawStart, drawCount, instanceCount);
+            // scaled for wireframe indices, and clipped to the draw range
+            size_t n = 0;
+            for (size_t i = 0; i < _multiDrawStarts.size(); i++) {
 
-        } */
-        else {
+                const auto start = std::max(_multiDrawStarts[i] * rangeFactor, drawStart);
+                const auto end = std::min((_multiDrawStarts[i] + _multiDrawCounts[i]) * rangeFactor, drawEnd + 1);
+
+                if (end <= start) continue;
+
+                _multiDrawStarts[n] = start;
+                _multiDrawCounts[n] = end - start;
+                ++n;
+            }
+
+            _multiDrawStarts.resize(n);
+            _multiDrawCounts.resize(n);
+
+            renderer->renderMultiDraw(_multiDrawStarts, _multiDrawCounts);
+
+        } else if (geometry->isInstanced()) {
+
+            const auto instanceCount = static_cast<InstancedBufferGeometry*>(geometry)->drawInstanceCount();
+
+            if (instanceCount > 0) renderer->renderInstances(drawStart, drawCount, instanceCount);
+
+        } else {
 
             renderer->render(drawStart, drawCount);
         }
     }
 
+    // Draws the instances that survive per instance culling, one draw per level of detail.
+    void renderVisibleInstances(Camera* camera, Object3D* scene, BufferGeometry* geometry, Material* material, InstancedMesh* object, std::optional<GeometryGroup> group) {
+
+        // spread large meshes over the projection threads, when those are enabled
+        constexpr size_t parallelInstances = 16384;
+        const bool parallel = scope.parallelProjection && object->count() >= parallelInstances;
+        if (parallel && !projectionPool) projectionPool = std::make_unique<ThreadPool>();
+
+        const auto& ranges = object->updateVisibleInstances(*camera, parallel ? projectionPool.get() : nullptr);
+
+        attributes.update(object->visibleInstanceMatrix(), GL_ARRAY_BUFFER);
+
+        if (object->visibleInstanceColor()) {
+
+            attributes.update(object->visibleInstanceColor(), GL_ARRAY_BUFFER);
+        }
+
+        for (const auto& range : ranges) {
+
+            if (range.count == 0) continue;
+
+            // levels have groups of their own, so they are drawn once, with the first material
+            if (range.geometry && group && group->materialIndex != 0) continue;
+
+            currentInstanceRange = &range;
+            renderBufferDirect(camera, scene, range.geometry ? range.geometry : geometry, material, object, range.geometry ? std::nullopt : group);
+        }
+
+        currentInstanceRange = nullptr;
+    }
+
     void projectObject(Object3D* object, Camera* camera, unsigned int groupOrder, bool sortObjects) {
         if (!object->visible) return;
 
@@ -462,12 +658,7 @@ struct GLRenderer::Impl {
 
             } else if (auto light = object->as<Light>()) {
 
-                currentRenderState->pushLight(light);
-
-                if (light->castShadow) {
-
-                    currentRenderState->pushShadow(light);
-                }
+                pushLight(light);
 
             } else if (auto sprite = object->as<Sprite>()) {
 
@@ -475,84 +666,299 @@ struct GLRenderer::Impl {
 
                     if (sortObjects) {
 
-                        _vector3.setFromMatrixPosition(*sprite->matrixWorld)
+                        _vector3.setFromMatrixPosition(sprite->matrixWorld)
                                 .applyMatrix4(_projScreenMatrix);
                     }
 
-                    const auto geometry = objects.update(object);
-                    const auto material = sprite->material().get();
-
-                    if (material->visible) {
-
-                        currentRenderList->push(object, geometry, material, groupOrder, _vector3.z, std::nullopt);
-                    }
+                    pushRenderItems(object, groupOrder, _vector3.z);
                 }
 
             } else if (object->is<Mesh>() || object->is<Line>() || object->is<Points>()) {
 
                 if (auto skinned = object->as<SkinnedMesh>()) {
 
-                    // update skeleton only once in a frame
-
-                    if (skinned->skeleton->frame != static_cast<int>(_info.render.frame)) {
-
-                        skinned->skeleton->update();
-                        skinned->skeleton->frame = _info.render.frame;
-                    }
+                    updateSkeleton(skinned);
                 }
 
                 if (!object->frustumCulled || _frustum.intersectsObject(*object)) {
 
                     if (sortObjects) {
 
-                        _vector3.setFromMatrixPosition(*object->matrixWorld)
+                        _vector3.setFromMatrixPosition(object->matrixWorld)
                                 .applyMatrix4(_projScreenMatrix);
                     }
 
-                    const auto geometry = objects.update(object);
-                    const auto& materials = object->as<ObjectWithMaterials>()->materials();
+                    pushRenderItems(object, groupOrder, _vector3.z);
+                }
+            }
+        }
 
-                    if (materials.size() > 1) {
+        for (const auto& child : object->children) {
 
-                        const auto& groups = geometry->groups;
+            projectObject(child, camera, groupOrder, sortObjects);
+        }
+    }
 
-                        for (const auto& group : groups) {
+    void pushLight(Light* light) {
 
-                            const auto groupMaterial = materials.at(group.materialIndex).get();
+        currentRenderState->pushLight(light);
 
-                            if (groupMaterial && groupMaterial->visible) {
+        if (light->castShadow) {
 
-                                currentRenderList->push(object, geometry, groupMaterial, groupOrder, _vector3.z, group);
-                            }
-                        }
+            currentRenderState->pushShadow(light);
+        }
+    }
 
-                    } else if (materials.front()->visible) {
+    void updateSkeleton(SkinnedMesh* skinned) {
 
-                        currentRenderList->push(object, geometry, materials.front().get(), groupOrder, _vector3.z, std::nullopt);
-                    }
+        // update skeleton only once in a frame
+
+        if (skinned->skeleton->frame != static_cast<int>(_info.render.frame)) {
+
+            skinned->skeleton->update();
+            skinned->skeleton->frame = _info.render.frame;
+        }
+    }
+
+    // expects object to be a Sprite, Mesh, Line or Points that passed culling
+    void pushRenderItems(Object3D* object, unsigned int groupOrder, float z) {
+
+        const auto geometry = objects.update(object);
+
+        if (auto sprite = object->as<Sprite>()) {
+
+            const auto material = sprite->material().get();
+
+            if (material->visible) {
+
+                currentRenderList->push(object, geometry, material, groupOrder, z, std::nullopt);
+            }
+
+            return;
+        }
+
+        const auto& materials = object->as<ObjectWithMaterials>()->materials();
+
+        if (materials.size() > 1) {
+
+            const auto& groups = geometry->groups;
+
+            for (const auto& group : groups) {
+
+                const auto groupMaterial = materials.at(group.materialIndex).get();
+
+                if (groupMaterial && groupMaterial->visible) {
+
+                    currentRenderList->push(object, geometry, groupMaterial, groupOrder, z, group);
                 }
             }
+
+        } else if (materials.front()->visible) {
+
+            currentRenderList->push(object, geometry, materials.front().get(), groupOrder, z, std::nullopt);
         }
+    }
+
+    // parallel projection
+
+    struct ProjectedObject {
+
+        Object3D* object;
+        unsigned int groupOrder;
+        float z;
+        // the bounding sphere was missing, so the frustum test is left to the main thread
+        bool needsCullTest;
+    };
+
+    // A contiguous piece of the depth-first traversal: either a single node or a whole subtree.
+    // Segments are culled independently and merged in order, which reproduces the serial traversal.
+    struct ProjectionSegment {
+
+        Object3D* root;
+        unsigned int groupOrder;
+        bool recursive;
+
+        std::vector<Light*> lights;
+        std::vector<SkinnedMesh*> skinnedMeshes;
+        std::vector<ProjectedObject> objects;
+    };
+
+    std::unique_ptr<ThreadPool> projectionPool;
+    std::vector<ProjectionSegment> projectionSegments;
+
+    static bool hasBoundingSphere(Object3D* object) {
+
+        if (auto instancedMesh = object->as<InstancedMesh>()) {
+
+            return instancedMesh->boundingSphere.has_value();
+        }
+
+        if (auto batchedMesh = object->as<BatchedMesh>()) {
+
+            return batchedMesh->boundingSphere.has_value();
+        }
+
+        return object->geometry()->boundingSphere.has_value();
+    }
+
+    // Thread-safe counterpart of projectObject. Anything that touches GL or shared state is recorded in segment.
+    // Returns the group order that applies to the children of object.
+    unsigned int cullObject(Object3D* object, Camera* camera, unsigned int groupOrder, bool sortObjects, ProjectionSegment& segment) const {
+
+        if (!object->layers.test(camera->layers)) return groupOrder;
+
+        Vector3 v;
+
+        if (object->is<Group>()) {
+
+            groupOrder = object->renderOrder;
+
+        } else if (auto lod = object->as<LOD>()) {
+
+            if (lod->autoUpdate) lod->update(*camera);
+
+        } else if (auto light = object->as<Light>()) {
+
+            segment.lights.emplace_back(light);
+
+        } else if (auto sprite = object->as<Sprite>()) {
+
+            if (!object->frustumCulled || _frustum.intersectsSprite(*sprite)) {
+
+                if (sortObjects) {
+
+                    v.setFromMatrixPosition(sprite->matrixWorld).applyMatrix4(_projScreenMatrix);
+                }
+
+                segment.objects.emplace_back(ProjectedObject{object, groupOrder, v.z, false});
+            }
+
+        } else if (object->is<Mesh>() || object->is<Line>() || object->is<Points>()) {
+
+            if (auto skinned = object->as<SkinnedMesh>()) {
+
+                segment.skinnedMeshes.emplace_back(skinned);
+            }
+
+            // computing a missing bounding sphere mutates the (possibly shared) geometry, so leave that to the main thread
+            const bool needsCullTest = object->frustumCulled && !hasBoundingSphere(object);
+
+            if (!object->frustumCulled || needsCullTest || _frustum.intersectsObject(*object)) {
+
+                if (sortObjects) {
+
+                    v.setFromMatrixPosition(object->matrixWorld).applyMatrix4(_projScreenMatrix);
+                }
+
+                segment.objects.emplace_back(ProjectedObject{object, groupOrder, v.z, needsCullTest});
+            }
+        }
+
+        return groupOrder;
+    }
+
+    void cullSubtree(Object3D* object, Camera* camera, unsigned int groupOrder, bool sortObjects, ProjectionSegment& segment) const {
+
+        if (!object->visible) return;
+
+        groupOrder = cullObject(object, camera, groupOrder, sortObjects, segment);
 
         for (const auto& child : object->children) {
 
-            projectObject(child, camera, groupOrder, sortObjects);
+            cullSubtree(child, camera, groupOrder, sortObjects, segment);
         }
     }
 
-    void renderObjects(const std::vector<gl::RenderItem*>& renderList, Object3D* scene, Camera* camera) {
+    void projectObjectParallel(Object3D* scene, Camera* camera, bool sortObjects) {
+
+        if (!projectionPool) projectionPool = std::make_unique<ThreadPool>();
+
+        // split the top of the graph into enough subtrees to keep every thread busy.
+        // Nodes above the split are handled here, so that LOD switching and group order are resolved before their children are culled.
+
+        const auto targetSegments = projectionPool->size() * 4;
+
+        projectionSegments.clear();
+        projectionSegments.emplace_back(ProjectionSegment{scene, 0, true});
+
+        for (int depth = 0; depth < 8; depth++) {
+
+            size_t numSubtrees = 0;
+            for (const auto& segment : projectionSegments) {
+                if (segment.recursive) ++numSubtrees;
+            }
+            if (numSubtrees == 0 || numSubtrees >= targetSegments) break;
+
+            std::vector<ProjectionSegment> expanded;
+            expanded.reserve(projectionSegments.size() * 2);
+
+            for (auto& segment : projectionSegments) {
+
+                if (!segment.recursive || segment.root->children.empty()) {
+
+                    expanded.emplace_back(std::move(segment));
+                    continue;
+                }
+
+                if (!segment.root->visible) continue;
+
+                auto& self = expanded.emplace_back(ProjectionSegment{segment.root, segment.groupOrder, false});
+                const auto childGroupOrder = cullObject(segment.root, camera, segment.groupOrder, sortObjects, self);
+
+                for (const auto& child : segment.root->children) {
+
+                    expanded.emplace_back(ProjectionSegment{child, childGroupOrder, true});
+                }
+            }
+
+            projectionSegments = std::move(expanded);
+        }
+
+        projectionPool->parallelFor(projectionSegments.size(), [&](size_t i) {
+            auto& segment = projectionSegments[i];
+            if (segment.recursive) {
+                cullSubtree(segment.root, camera, segment.groupOrder, sortObjects, segment);
+            }
+        });
+
+        // merge in traversal order
+
+        for (const auto& segment : projectionSegments) {
+
+            for (auto light : segment.lights) {
+
+                pushLight(light);
+            }
+
+            for (auto skinned : segment.skinnedMeshes) {
+
+                updateSkeleton(skinned);
+            }
+
+            for (const auto& projected : segment.objects) {
+
+                if (projected.needsCullTest && !_frustum.intersectsObject(*projected.object)) continue;
+
+                pushRenderItems(projected.object, projected.groupOrder, projected.z);
+            }
+        }
+    }
+
+    void renderObjects(const gl::GLRenderList& renderList, const std::vector<unsigned int>& queue, Object3D* scene, Camera* camera) {
 
         Material* overrideMaterial = nullptr;
         if (auto _scene = scene->as<Scene>()) {
             if (_scene->overrideMaterial) overrideMaterial = _scene->overrideMaterial.get();
         }
 
-        for (const auto& renderItem : renderList) {
+        for (auto index : queue) {
+
+            const auto& renderItem = renderList.get(index);
 
-            auto object = renderItem->object;
-            auto geometry = renderItem->geometry;
-            auto material = overrideMaterial == nullptr ? renderItem->material : overrideMaterial;
-            auto group = renderItem->group;
+            auto object = renderItem.object;
+            auto geometry = renderItem.geometry;
+            auto material = overrideMaterial == nullptr ? renderItem.material : overrideMaterial;
+            auto group = renderItem.group;
 
             renderObject(object, scene, camera, geometry, material, group);
         }
@@ -565,7 +971,7 @@ struct GLRenderer::Impl {
             object->onBeforeRender.value()(&scope, scene, camera, geometry, material, group);
         }
 
-        object->modelViewMatrix.multiplyMatrices(camera->matrixWorldInverse, *object->matrixWorld);
+        object->modelViewMatrix.multiplyMatrices(camera->matrixWorldInverse, object->matrixWorld);
         object->normalMatrix.getNormalMatrix(object->modelViewMatrix);
 
         renderBufferDirect(camera, scene, geometry, material, object, group);
@@ -589,7 +995,7 @@ struct GLRenderer::Impl {
         auto lightsStateVersion = lights.state.version;
 
         auto parameters = gl::GLPrograms::getParameters(scope, clipping, material, lights.state, shadowsArray.size(), scene, object);
-        auto programCacheKey = gl::GLPrograms::getProgramCacheKey(scope, parameters);
+        auto programCacheKey = gl::GLPrograms::getProgramCacheKey(scope, parameters, programCacheKeyData);
 
         auto& programs = materialProperties->programs;
 
@@ -615,9 +1021,19 @@ struct GLRenderer::Impl {
 
         gl::GLProgram* program = nullptr;
 
-        if (programs.contains(programCacheKey)) {
+        auto it = programs.find(programCacheKey);
 
-            program = programs.at(programCacheKey);
+        if (it != programs.end() && it->second->cacheKey != programCacheKeyData) {
+
+            // hash collision, let the new program take the slot
+            programCache.releaseProgram(it->second);
+            programs.erase(it);
+            it = programs.end();
+        }
+
+        if (it != programs.end()) {
+
+            program = it->second;
 
             if (materialProperties->currentProgram == program && materialProperties->lightsStateVersion == lightsStateVersion) {
 
@@ -634,7 +1050,7 @@ struct GLRenderer::Impl {
 
             // material.onBeforeCompile( parameters, this );
 
-            program = programCache.acquireProgram(scope, parameters, programCacheKey);
+            program = programCache.acquireProgram(scope, parameters, programCacheKey, programCacheKeyData);
             programs[programCacheKey] = program;
 
             materialProperties->uniforms = parameters.uniforms;
@@ -642,6 +1058,12 @@ struct GLRenderer::Impl {
 
         auto& uniforms = *materialProperties->uniforms;
 
+        if (materialProperties->materialUniforms.map() != &uniforms) {
+
+            // ShaderMaterial uniforms belong to the user and may be replaced at any time, so they are not cached
+            materialProperties->materialUniforms = gl::MaterialUniforms(uniforms, !material->is<ShaderMaterial>());
+        }
+
         if (!material->is<ShaderMaterial>() && !material->is<RawShaderMaterial>() || material->clipping) {
 
             uniforms["clippingPlanes"] = clipping.uniform;
@@ -670,31 +1092,45 @@ struct GLRenderer::Impl {
 
             uniforms.at("directionalShadowMap").setValue(lights.state.directionalShadowMap);
             uniforms.at("directionalShadowMatrix").setValue(lights.state.directionalShadowMatrix);
+            uniforms.at("directionalShadowCascadeMatrix").setValue(lights.state.directionalShadowCascadeMatrix);
             uniforms.at("spotShadowMap").setValue(lights.state.spotShadowMap);
             uniforms.at("spotShadowMatrix").setValue(lights.state.spotShadowMatrix);
             uniforms.at("pointShadowMap").setValue(lights.state.pointShadowMap);
             uniforms.at("pointShadowMatrix").setValue(lights.state.pointShadowMatrix);
         }
 
-        auto progUniforms = program->getUniforms();
-        auto uniformsList = gl::GLUniforms::seqWithValue(progUniforms->seq, *materialProperties->uniforms);
-
         materialProperties->currentProgram = program;
-        materialProperties->uniformsList = uniformsList;
+        materialProperties->uniformsListNeedsUpdate = true;
+
+        if (!programCache.isPending(program->id)) {
+
+            updateUniformsList(materialProperties, program);
+        }
 
         return materialProperties->currentProgram;
     }
 
+    void updateUniformsList(gl::MaterialProperties* materialProperties, gl::GLProgram* program) {
+
+        auto progUniforms = program->getUniforms();
+
+        materialProperties->uniformsList = gl::GLUniforms::seqWithValue(progUniforms->seq, *materialProperties->uniforms);
+        materialProperties->uniformsListNeedsUpdate = false;
+    }
+
     void updateCommonMaterialProperties(Material* material, gl::ProgramParameters& parameters) {
 
         auto materialProperties = properties.materialProperties.get(material);
 
         materialProperties->outputEncoding = parameters.outputEncoding;
         materialProperties->instancing = parameters.instancing;
+        materialProperties->batching = parameters.batching;
+        materialProperties->clusteredLights = parameters.clusteredLights;
         materialProperties->skinning = parameters.skinning;
         materialProperties->numClippingPlanes = parameters.numClippingPlanes;
         materialProperties->numIntersection = parameters.numClipIntersection;
         materialProperties->vertexAlphas = parameters.vertexAlphas;
+        materialProperties->octahedralNormals = parameters.octahedralNormals;
     }
 
     gl::GLProgram* setProgram(Camera* camera, Object3D* _scene, Material* material, Object3D* object) {
@@ -702,12 +1138,12 @@ struct GLRenderer::Impl {
         auto* scene = _scene->as<Scene>();
         if (!scene) scene = _emptyScene.get();// scene could be a Mesh, Line, Points, ...
 
-        bool isMeshBasicMaterial = material->type() == "MeshBasicMaterial";
-        bool isMeshLambertMaterial = material->type() == "MeshLambertMaterial";
-        bool isMeshToonMaterial = material->type() == "MeshToonMaterial";
-        bool isMeshPhongMaterial = material->type() == "MeshPhongMaterial";
-        bool isMeshStandardMaterial = material->type() == "MeshStandardMaterial";
-        bool isShadowMaterial = material->type() == "ShadowMaterial";
+        bool isMeshBasicMaterial = material->is<MeshBasicMaterial>();
+        bool isMeshLambertMaterial = material->is<MeshLambertMaterial>();
+        bool isMeshToonMaterial = material->is<MeshToonMaterial>();
+        bool isMeshPhongMaterial = material->is<MeshPhongMaterial>();
+        bool isMeshStandardMaterial = material->is<MeshStandardMaterial>();
+        bool isShadowMaterial = material->is<ShadowMaterial>();
         bool isShaderMaterial = material->is<ShaderMaterial>();
         bool isEnvMap = material->is<MaterialWithEnvMap>() && material->as<MaterialWithEnvMap>()->envMap;
 
@@ -729,7 +1165,10 @@ struct GLRenderer::Impl {
         bool vertexAlphas = material->vertexColors &&
                             object->geometry() &&
                             object->geometry()->hasAttribute("color") &&
-                            object->geometry()->getAttribute<float>("color")->itemSize() == 4;
+                            object->geometry()->getAttribute("color")->itemSize() == 4;
+        bool octahedralNormals = object->geometry() &&
+                                 object->geometry()->hasAttribute("normal") &&
+                                 object->geometry()->getAttribute("normal")->itemSize() == 2;
 
         auto materialProperties = properties.materialProperties.get(material);
         auto& lights = currentRenderState->getLights();
@@ -750,8 +1189,9 @@ struct GLRenderer::Impl {
         //
 
         bool needsProgramChange = false;
-        bool isInstancedMesh = object->type() == "InstancedMesh";
-        bool isSkinnedMesh = object->type() == "SkinnedMesh";
+        bool isInstancedMesh = object->is<InstancedMesh>();
+        bool isBatchedMesh = object->is<BatchedMesh>();
+        bool isSkinnedMesh = object->is<SkinnedMesh>();
 
         if (material->version() == materialProperties->version) {
 
@@ -771,6 +1211,10 @@ struct GLRenderer::Impl {
 
                 needsProgramChange = true;
 
+            } else if (isBatchedMesh != materialProperties->batching) {
+
+                needsProgramChange = true;
+
             } else if (isSkinnedMesh && !materialProperties->skinning) {
 
                 needsProgramChange = true;
@@ -796,6 +1240,10 @@ struct GLRenderer::Impl {
             } else if (materialProperties->vertexAlphas != vertexAlphas) {
 
                 needsProgramChange = true;
+
+            } else if (materialProperties->octahedralNormals != octahedralNormals) {
+
+                needsProgramChange = true;
             }
 
         } else {
@@ -813,6 +1261,17 @@ struct GLRenderer::Impl {
             program = getProgram(material, scene, object);
         }
 
+        if (programCache.isPending(program->id)) {
+
+            // still linking in the background (see compileAsync), skip the object until it is ready
+            return nullptr;
+        }
+
+        if (materialProperties->uniformsListNeedsUpdate) {
+
+            updateUniformsList(materialProperties, program);
+        }
+
         bool refreshProgram = false;
         bool refreshMaterial = false;
         bool refreshLights = false;
@@ -834,6 +1293,15 @@ struct GLRenderer::Impl {
             refreshMaterial = true;
         }
 
+        if (scope.uniformBlocks) {
+
+            // no-ops unless the camera, light state or frame changed since the last upload
+            uniformBlocks.updateCamera(*camera);
+
+            if (materialProperties->needsLights) uniformBlocks.updateLights(lights.state, materialProperties->clusteredLights);
+            if (fog && material->fog) uniformBlocks.updateFog(*fog);
+        }
+
         if (refreshProgram || _currentCamera != camera) {
 
             p_uniforms->setValue("projectionMatrix", camera->projectionMatrix);
@@ -867,7 +1335,7 @@ struct GLRenderer::Impl {
                 if (p_uniforms->map.contains("cameraPosition")) {
 
                     auto& uCamPos = p_uniforms->map.at("cameraPosition");
-                    _vector3.setFromMatrixPosition(*camera->matrixWorld);
+                    _vector3.setFromMatrixPosition(camera->matrixWorld);
                     uCamPos->setValue(_vector3);
                 }
             }
@@ -928,6 +1396,17 @@ struct GLRenderer::Impl {
             }
         }
 
+        if (auto batched = object->as<BatchedMesh>()) {
+
+            p_uniforms->setValue("batchingTexture", batched->matricesTexture(), &textures);
+            p_uniforms->setValue("batchingTextureSize", batched->matricesTextureSize());
+        }
+
+        if (materialProperties->clusteredLights) {
+
+            clusteredLights.setUniforms(*p_uniforms, textures);
+        }
+
         if (refreshMaterial || materialProperties->receiveShadow != object->receiveShadow) {
 
             materialProperties->receiveShadow = object->receiveShadow;
@@ -954,27 +1433,31 @@ struct GLRenderer::Impl {
                 // use the current material's .needsUpdate flags to set
                 // the GL state when required
 
-                markUniformsLightsNeedsUpdate(m_uniforms, refreshLights);
+                markUniformsLightsNeedsUpdate(materialProperties->materialUniforms, refreshLights);
             }
 
             // refresh uniforms common to several materials
 
             if (fog && material->fog) {
 
-                materials.refreshFogUniforms(m_uniforms, *fog);
+                materials.refreshFogUniforms(materialProperties->materialUniforms, *fog);
             }
 
-            materials.refreshMaterialUniforms(m_uniforms, material, _pixelRatio, _size.height());
+            materials.refreshMaterialUniforms(materialProperties->materialUniforms, material, _pixelRatio, _size.height());
+
+            // the slots of user owned uniforms may have been invalidated since the last upload
+            if (isShaderMaterial) updateUniformsList(materialProperties, program);
 
-            gl::GLUniforms::upload(materialProperties->uniformsList, m_uniforms, &textures);
+            gl::GLUniforms::upload(materialProperties->uniformsList, &textures);
         }
 
         if (isShaderMaterial) {
 
-            auto m = dynamic_cast<ShaderMaterial*>(material);
+            auto m = material->as<ShaderMaterial>();
             if (m->uniformsNeedUpdate) {
 
-                gl::GLUniforms::upload(materialProperties->uniformsList, m_uniforms, &textures);
+                updateUniformsList(materialProperties, program);
+                gl::GLUniforms::upload(materialProperties->uniformsList, &textures);
                 m->uniformsNeedUpdate = false;
             }
         }
@@ -988,30 +1471,32 @@ struct GLRenderer::Impl {
 
         p_uniforms->setValue("modelViewMatrix", object->modelViewMatrix);
         p_uniforms->setValue("normalMatrix", object->normalMatrix);
-        p_uniforms->setValue("modelMatrix", *object->matrixWorld);
+        p_uniforms->setValue("modelMatrix", object->matrixWorld);
 
         return program;
     }
 
-    void markUniformsLightsNeedsUpdate(UniformMap& uniforms, bool value) {
-        uniforms.at("ambientLightColor").needsUpdate = value;
-        uniforms.at("lightProbe").needsUpdate = value;
-
-        uniforms.at("directionalLights").needsUpdate = value;
-        uniforms.at("directionalLightShadows").needsUpdate = value;
-        uniforms.at("pointLights").needsUpdate = value;
-        uniforms.at("pointLightShadows").needsUpdate = value;
-        uniforms.at("spotLights").needsUpdate = value;
-        uniforms.at("spotLightShadows").needsUpdate = value;
-        uniforms.at("hemisphereLights").needsUpdate = value;
+    void markUniformsLightsNeedsUpdate(gl::MaterialUniforms& uniforms, bool value) {
+        using gl::MaterialUniform;
+
+        uniforms.at(MaterialUniform::AmbientLightColor).needsUpdate = value;
+        uniforms.at(MaterialUniform::LightProbe).needsUpdate = value;
+
+        uniforms.at(MaterialUniform::DirectionalLights).needsUpdate = value;
+        uniforms.at(MaterialUniform::DirectionalLightShadows).needsUpdate = value;
+        uniforms.at(MaterialUniform::PointLights).needsUpdate = value;
+        uniforms.at(MaterialUniform::PointLightShadows).needsUpdate = value;
+        uniforms.at(MaterialUniform::SpotLights).needsUpdate = value;
+        uniforms.at(MaterialUniform::SpotLightShadows).needsUpdate = value;
+        uniforms.at(MaterialUniform::HemisphereLights).needsUpdate = value;
     }
 
     bool materialNeedsLights(Material* material) {
-        bool isMeshLambertMaterial = material->type() == "MeshLambertMaterial";
-        bool isMeshToonMaterial = material->type() == "MeshToonMaterial";
-        bool isMeshPhongMaterial = material->type() == "MeshPhongMaterial";
-        bool isMeshStandardMaterial = material->type() == "MeshStandardMaterial";
-        bool isShadowMaterial = material->type() == "ShadowMaterial";
+        bool isMeshLambertMaterial = material->is<MeshLambertMaterial>();
+        bool isMeshToonMaterial = material->is<MeshToonMaterial>();
+        bool isMeshPhongMaterial = material->is<MeshPhongMaterial>();
+        bool isMeshStandardMaterial = material->is<MeshStandardMaterial>();
+        bool isShadowMaterial = material->is<ShadowMaterial>();
         bool isShaderMaterial = material->is<ShaderMaterial>();
         bool lights = false;
 
@@ -1115,6 +1600,7 @@ struct GLRenderer::Impl {
         textures.setTexture2D(texture, 0);
 
         auto& image = texture.image();
+        if (image.adopted()) image.setData(std::vector<unsigned char>());
         auto& data = image.data();
         auto newSize = image.width * image.height * (texture.format == Format::RGB ? 3 : 4);
         data.resize(newSize);
@@ -1146,6 +1632,9 @@ struct GLRenderer::Impl {
         cubemaps.dispose();
         objects.dispose();
         bindingStates.dispose();
+        attributes.dispose();
+        uniformBlocks.dispose();
+        clusteredLights.dispose();
     }
 
     void reset() {
@@ -1318,6 +1807,16 @@ void GLRenderer::dispose() {
     pimpl_->dispose();
 }
 
+void GLRenderer::compile(Object3D& scene, Camera& camera) {
+
+    pimpl_->compile(&scene, &camera, false, nullptr);
+}
+
+void GLRenderer::compileAsync(Object3D& scene, Camera& camera, const std::function<void()>& onReady) {
+
+    pimpl_->compile(&scene, &camera, true, onReady);
+}
+
 void GLRenderer::render(Object3D& scene, Camera& camera) {
 
     pimpl_->render(&scene, &camera);
@@ -9,6 +9,12 @@ namespace threepp::gl {
         int type{};
         int bytesPerElement{};
         unsigned int version{};
+        long long size{};// in bytes
+
+        // set for buffers suballocated from GLBufferArena, where the data starts offset bytes into a shared buffer
+        bool shared{};
+        long long offset{};
+        unsigned int target{};
     };
 
 }// namespace threepp::gl
@@ -1,7 +1,13 @@
 
 #include "threepp/renderers/gl/GLAttributes.hpp"
+#include "threepp/core/IndexBufferAttribute.hpp"
 #include "threepp/core/InterleavedBufferAttribute.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
 #ifndef EMSCRIPTEN
 #include <glad/glad.h>
 #else
@@ -11,92 +17,276 @@
 using namespace threepp;
 using namespace threepp::gl;
 
-Buffer GLAttributes::createBuffer(BufferAttribute* attribute, GLenum bufferType) {
+namespace {
 
-    const auto usage = attribute->getUsage();
+    template<class T>
+    struct GLTypeOf;
 
-    GLuint buffer;
-    glGenBuffers(1, &buffer);
-    glBindBuffer(bufferType, buffer);
+    template<>
+    struct GLTypeOf<float> {
+        static constexpr GLenum value = GL_FLOAT;
+    };
 
-    GLint type;
-    GLsizei bytesPerElement;
-    if (attribute->typed<unsigned int>()) {
-        type = GL_UNSIGNED_INT;
-        bytesPerElement = sizeof(unsigned int);
-        auto attr = attribute->typed<unsigned int>();
-        const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), as_integer(usage));
+    template<>
+    struct GLTypeOf<HalfFloat> {
+        static constexpr GLenum value = GL_HALF_FLOAT;
+    };
+
+    template<>
+    struct GLTypeOf<unsigned int> {
+        static constexpr GLenum value = GL_UNSIGNED_INT;
+    };
+
+    template<>
+    struct GLTypeOf<int> {
+        static constexpr GLenum value = GL_INT;
+    };
+
+    template<>
+    struct GLTypeOf<uint16_t> {
+        static constexpr GLenum value = GL_UNSIGNED_SHORT;
+    };
+
+    template<>
+    struct GLTypeOf<int16_t> {
+        static constexpr GLenum value = GL_SHORT;
+    };
+
+    template<>
+    struct GLTypeOf<uint8_t> {
+        static constexpr GLenum value = GL_UNSIGNED_BYTE;
+    };
+
+    template<>
+    struct GLTypeOf<int8_t> {
+        static constexpr GLenum value = GL_BYTE;
+    };
+
+    // The raw storage of a typed attribute, as seen by glBufferData.
+    struct ArrayView {
+
+        const void* data = nullptr;
+        size_t size = 0;// in elements
+        GLenum type = 0;
+        GLsizei bytesPerElement = 0;
+    };
+
+    template<class T>
+    bool tryView(BufferAttribute* attribute, ArrayView& view) {
+
+        const auto attr = attribute->typed<T>();
+        if (!attr) return false;
 
-    } else if (attribute->typed<float>()) {
-        type = GL_FLOAT;
-        bytesPerElement = sizeof(float);
-        auto attr = attribute->typed<float>();
         const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), as_integer(usage));
-    } else {
+        view = {array.data(), array.size(), GLTypeOf<T>::value, sizeof(T)};
+
+        return true;
+    }
+
+    ArrayView viewOf(BufferAttribute* attribute) {
+
+        if (const auto index = dynamic_cast<IndexBufferAttribute*>(attribute)) {
+
+            return {index->data(), static_cast<size_t>(index->count()),
+                    static_cast<GLenum>(index->is16Bit() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT),
+                    index->bytesPerElement()};
+        }
+
+        ArrayView view;
+        if (tryView<float>(attribute, view) ||
+            tryView<unsigned int>(attribute, view) ||
+            tryView<uint16_t>(attribute, view) ||
+            tryView<HalfFloat>(attribute, view) ||
+            tryView<uint8_t>(attribute, view) ||
+            tryView<int16_t>(attribute, view) ||
+            tryView<int8_t>(attribute, view) ||
+            tryView<int>(attribute, view)) {
+
+            return view;
+        }
 
-        throw std::runtime_error("TODO");
+        throw std::runtime_error("Unsupported BufferAttribute type");
     }
 
-    return {buffer, type, bytesPerElement, attribute->version};// attribute->version + 1 (?)
+    // Replaces the storage of the buffer bound to target, so that the driver does not wait for pending draws reading it.
+    void orphanAndUpload(GLenum target, const void* data, long long size, GLenum usage) {
+
+#ifndef EMSCRIPTEN
+        if (size > 0) {
+
+            if (auto dst = glMapBufferRange(target, 0, (GLsizeiptr) size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT)) {
+
+                std::memcpy(dst, data, size);
+
+                // false means the contents were lost while mapped, fall back to respecifying them
+                if (glUnmapBuffer(target) == GL_TRUE) return;
+            }
+        }
+#endif
+
+        glBufferData(target, (GLsizeiptr) size, data, usage);
+    }
+
+}// namespace
+
+Buffer GLAttributes::createBuffer(BufferAttribute* attribute, GLenum bufferType) {
+
+    const auto view = viewOf(attribute);
+    const auto size = static_cast<long long>(view.size) * view.bytesPerElement;
+
+    Buffer result{0, static_cast<GLint>(view.type), view.bytesPerElement, attribute->version, size};
+    result.target = bufferType;
+
+    // large buffers gain nothing from sharing, and would leave big holes in the pages when freed
+    if (packStaticBuffers && attribute->getUsage() == DrawUsage::Static &&
+        (bufferType == GL_ARRAY_BUFFER || bufferType == GL_ELEMENT_ARRAY_BUFFER) &&
+        size > 0 && size <= arena_.pageSize() / 4) {
+
+        const auto allocation = arena_.allocate(bufferType, size);
+        GLBufferArena::upload(allocation, 0, size, view.data);
+
+        result.buffer = allocation.buffer;
+        result.shared = true;
+        result.offset = allocation.offset;
+
+        return result;
+    }
+
+    glGenBuffers(1, &result.buffer);
+    glBindBuffer(bufferType, result.buffer);
+
+    glBufferData(bufferType, (GLsizeiptr) size, view.data, as_integer(attribute->getUsage()));
+
+    return result;
 }
 
-void GLAttributes::updateBuffer(GLuint buffer, BufferAttribute* attribute, GLenum bufferType, int bytesPerElement) {
+void GLAttributes::deleteBuffer(const Buffer& buffer) {
+
+    if (buffer.shared) {
+
+        arena_.free(buffer.target, {buffer.buffer, buffer.offset, buffer.size});
+
+    } else {
+
+        glDeleteBuffers(1, &buffer.buffer);
+    }
+}
+
+void GLAttributes::updateBuffer(Buffer& buffer, BufferAttribute* attribute, GLenum bufferType) {
+
+    const auto view = viewOf(attribute);
+    const auto bytes = static_cast<const unsigned char*>(view.data);
+    const auto size = static_cast<long long>(view.size) * buffer.bytesPerElement;
+
+    ranges_.clear();
+    if (attribute->updateRange.count != -1) ranges_.emplace_back(attribute->updateRange);
+    ranges_.insert(ranges_.end(), attribute->updateRanges.begin(), attribute->updateRanges.end());
+
+    attribute->updateRange.count = -1;
+    attribute->clearUpdateRanges();
+
+    if (buffer.shared) {
+
+        if (size != buffer.size) {
+
+            // moves to a new range of the arena
+            deleteBuffer(buffer);
+            buffer = createBuffer(attribute, bufferType);
+            ++layoutVersion_;
+            return;
+        }
+
+        // shared buffers hold static data, which is written in place
+        const GLBufferArena::Allocation allocation{buffer.buffer, buffer.offset, buffer.size};
+        if (ranges_.empty()) {
+
+            GLBufferArena::upload(allocation, 0, size, bytes);
+        }
+
+        for (const auto& range : ranges_) {
+
+            const auto offset = std::clamp<long long>(range.offset, 0, view.size) * buffer.bytesPerElement;
+            const auto end = std::clamp<long long>(static_cast<long long>(range.offset) + range.count, 0, view.size) * buffer.bytesPerElement;
+            if (end > offset) GLBufferArena::upload(allocation, offset, end - offset, bytes + offset);
+        }
+
+        return;
+    }
 
-    auto& updateRange = attribute->updateRange;
+    glBindBuffer(bufferType, buffer.buffer);
+
+    if (size != buffer.size) {
+
+        // the array was resized, which needs new storage
+        glBufferData(bufferType, (GLsizeiptr) size, bytes, as_integer(attribute->getUsage()));
+        buffer.size = size;
+        return;
+    }
 
-    glBindBuffer(bufferType, buffer);
+    const auto elements = static_cast<int>(view.size);
 
-    if (updateRange.count == -1) {
+    // clip, sort and merge overlapping or adjacent ranges
+    std::erase_if(ranges_, [&](UpdateRange& r) {
+        const auto end = std::min(r.offset + r.count, elements);
+        r.offset = std::max(r.offset, 0);
+        r.count = end - r.offset;
+        return r.count <= 0;
+    });
+    std::ranges::sort(ranges_, {}, &UpdateRange::offset);
 
-        if (attribute->typed<unsigned int>()) {
+    int covered = 0;
+    size_t merged = 0;
+    for (const auto& range : ranges_) {
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
+        if (merged > 0 && range.offset <= ranges_[merged - 1].offset + ranges_[merged - 1].count) {
 
-        } else if (attribute->typed<float>()) {
+            auto& last = ranges_[merged - 1];
+            const auto end = std::max(last.offset + last.count, range.offset + range.count);
+            covered += end - (last.offset + last.count);
+            last.count = end - last.offset;
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
         } else {
 
-            throw std::runtime_error("TODO");
+            ranges_[merged++] = range;
+            covered += range.count;
         }
+    }
+    ranges_.resize(merged);
 
-    } else {
+    const bool orphan = streaming && attribute->getUsage() != DrawUsage::Static;
 
-        if (attribute->typed<unsigned int>()) {
+    // when most of a streamed buffer changes, replacing all of it is cheaper than synchronizing on the old contents
+    if (ranges_.empty() || (orphan && covered * 2 >= elements)) {
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            std::vector<unsigned int> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
+        if (orphan) {
 
-        } else if (attribute->typed<float>()) {
+            orphanAndUpload(bufferType, bytes, size, as_integer(attribute->getUsage()));
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            std::vector<float> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
         } else {
 
-            throw std::runtime_error("TODO");
+            glBufferSubData(bufferType, 0, (GLsizeiptr) size, bytes);
         }
 
-        updateRange.count = -1;
+        return;
+    }
+
+    for (const auto& range : ranges_) {
+
+        const auto offset = static_cast<GLintptr>(range.offset) * buffer.bytesPerElement;
+        glBufferSubData(bufferType, offset, (GLsizeiptr) range.count * buffer.bytesPerElement, bytes + offset);
     }
 }
 
-Buffer GLAttributes::get(BufferAttribute* attribute) {
+const Buffer& GLAttributes::get(BufferAttribute* attribute) {
 
     if (auto attr = dynamic_cast<InterleavedBufferAttribute*>(attribute)) {
         attribute = attr->data.get();
     }
 
-    return buffers_.at(attribute);
+    const auto buffer = buffers_.find(attribute);
+    if (!buffer) throw std::out_of_range("BufferAttribute has not been uploaded");
+
+    return *buffer;
 }
 
 void GLAttributes::remove(BufferAttribute* attribute) {
@@ -105,13 +295,11 @@ void GLAttributes::remove(BufferAttribute* attribute) {
         attribute = attr->data.get();
     }
 
-    if (buffers_.contains(attribute)) {
-
-        auto& data = buffers_.at(attribute);
+    if (const auto buffer = buffers_.find(attribute)) {
 
-        glDeleteBuffers(1, &data.buffer);
+        deleteBuffer(*buffer);
 
-        buffers_.erase(attribute);
+        buffers_.remove(attribute);
     }
 }
 
@@ -123,17 +311,42 @@ void GLAttributes::update(BufferAttribute* attribute, GLenum bufferType) {
         attribute = attr->data.get();
     }
 
-    if (!buffers_.contains(attribute)) {
+    const auto buffer = buffers_.find(attribute);
+
+    if (!buffer) {
 
-        buffers_[attribute] = createBuffer(attribute, bufferType);
+        const auto data = createBuffer(attribute, bufferType);
+        buffers_.get(attribute) = data;
 
     } else {
 
-        auto& data = buffers_.at(attribute);
+        auto& data = *buffer;
 
         if (data.version < attribute->version) {
-            updateBuffer(data.buffer, attribute, bufferType, data.bytesPerElement);
-            ++data.version;
+
+            if (data.type != static_cast<GLint>(viewOf(attribute).type)) {
+
+                // the element type changed (an index widened to 32 bits), which needs a new buffer
+                deleteBuffer(data);
+                data = createBuffer(attribute, bufferType);
+                ++layoutVersion_;
+                attribute->updateRange.count = -1;
+                attribute->clearUpdateRanges();
+                return;
+            }
+
+            updateBuffer(data, attribute, bufferType);
+            data.version = attribute->version;
         }
     }
 }
+
+void GLAttributes::dispose() {
+
+    buffers_.forEach([](BufferAttribute*, const Buffer& buffer) {
+        if (!buffer.shared) glDeleteBuffers(1, &buffer.buffer);
+    });
+
+    buffers_.clear();
+    arena_.dispose();
+}
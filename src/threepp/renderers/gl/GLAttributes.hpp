@@ -6,26 +6,55 @@
 #include "threepp/core/BufferAttribute.hpp"
 
 #include "threepp/renderers/gl/Buffer.hpp"
+#include "threepp/renderers/gl/GLBufferArena.hpp"
+#include "threepp/renderers/gl/GLSlotMap.hpp"
 
-#include <unordered_map>
+#include <vector>
 
 namespace threepp::gl {
 
     class GLAttributes {
 
     public:
+        // Re-specify the storage of Dynamic/Stream attributes on full updates (buffer orphaning),
+        // so that uploads do not wait for draws still reading last frame's data.
+        bool streaming = false;
+
+        // Suballocate Static vertex and index buffers from shared GL buffers, see GLBufferArena.
+        bool packStaticBuffers = false;
+
         Buffer createBuffer(BufferAttribute* attribute, unsigned int bufferType);
 
-        void updateBuffer(unsigned int buffer, BufferAttribute* attribute, unsigned int bufferType, int bytesPerElement);
+        void deleteBuffer(const Buffer& buffer);
 
-        Buffer get(BufferAttribute* attribute);
+        // Uploads the attribute's update ranges, or the whole array when none are set.
+        void updateBuffer(Buffer& buffer, BufferAttribute* attribute, unsigned int bufferType);
+
+        const Buffer& get(BufferAttribute* attribute);
 
         void remove(BufferAttribute* attribute);
 
         void update(BufferAttribute* attribute, unsigned int bufferType);
 
+        // Incremented whenever the GL buffer or offset backing an attribute changes,
+        // which invalidates attribute pointers recorded in vertex array objects.
+        [[nodiscard]] unsigned int layoutVersion() const {
+
+            return layoutVersion_;
+        }
+
+        [[nodiscard]] const GLBufferArena& arena() const {
+
+            return arena_;
+        }
+
+        void dispose();
+
     private:
-        std::unordered_map<BufferAttribute*, Buffer> buffers_;
+        GLSlotMap<BufferAttribute, Buffer> buffers_;
+        GLBufferArena arena_;
+        unsigned int layoutVersion_ = 0;
+        std::vector<UpdateRange> ranges_;// scratch list, reused between updates
     };
 
 }// namespace threepp::gl
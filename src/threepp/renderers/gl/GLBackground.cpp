@@ -66,7 +66,7 @@ void GLBackground::render(GLRenderList& renderList, Object3D* scene) {
                 boxMesh = std::make_unique<Mesh>(geometry, shaderMaterial);
 
                 boxMesh->onBeforeRender = [&](void*, Object3D*, Camera* camera, BufferGeometry*, Material*, std::optional<GeometryGroup>) {
-                    boxMesh->matrixWorld->copyPosition(*camera->matrixWorld);
+                    boxMesh->matrixWorld.copyPosition(camera->matrixWorld);
                 };
 
                 objects.update(boxMesh.get());
@@ -1,6 +1,7 @@
 
 #include "threepp/renderers/gl/GLBindingStates.hpp"
 
+#include "threepp/renderers/gl/GLSlotMap.hpp"
 #include "threepp/renderers/gl/GLUtils.hpp"
 
 #include "threepp/core/InterleavedBufferAttribute.hpp"
@@ -14,8 +15,17 @@
 using namespace threepp;
 using namespace threepp::gl;
 
-typedef std::unordered_map<bool, std::shared_ptr<GLBindingState>> StateMap;
-typedef std::unordered_map<int, StateMap> ProgramMap;
+namespace {
+
+    // a geometry is usually drawn with only a handful of programs, so its states are searched linearly
+    struct StateEntry {
+
+        int program;
+        bool wireframe;
+        std::shared_ptr<GLBindingState> state;
+    };
+
+}// namespace
 
 struct GLBindingStates::Impl {
 
@@ -25,7 +35,7 @@ struct GLBindingStates::Impl {
     const std::shared_ptr<GLBindingState> defaultState_;
     std::shared_ptr<GLBindingState> currentState_;
 
-    std::unordered_map<unsigned int, ProgramMap> bindingStates;
+    GLSlotMap<BufferGeometry, std::vector<StateEntry>> bindingStates;
 
     explicit Impl(GLAttributes& attributes)
         : maxVertexAttributes_(glGetParameteri(GL_MAX_VERTEX_ATTRIBS)),
@@ -34,7 +44,7 @@ struct GLBindingStates::Impl {
           currentState_(defaultState_) {}
 
 
-    void setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index) {
+    void setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index, int firstInstance) {
 
         auto state = getBindingState(geometry, program, material);
 
@@ -44,6 +54,12 @@ struct GLBindingStates::Impl {
             bindVertexArrayObject(*currentState_->object);
         }
 
+        // updated first, as recreating its buffer changes the layout checked below
+        if (index) {
+
+            attributes_.update(index, GL_ELEMENT_ARRAY_BUFFER);
+        }
+
         bool updateBuffers = needsUpdate(geometry, index);
 
         if (updateBuffers) {
@@ -55,14 +71,9 @@ struct GLBindingStates::Impl {
             updateBuffers = true;
         }
 
-        if (index) {
-
-            attributes_.update(index, GL_ELEMENT_ARRAY_BUFFER);
-        }
-
         if (updateBuffers) {
 
-            setupVertexAttributes(object, material, program, geometry);
+            setupVertexAttributes(object, material, program, geometry, firstInstance);
 
             if (index) {
 
@@ -97,16 +108,14 @@ struct GLBindingStates::Impl {
             wireframe = wm->wireframe;
         }
 
-        auto& programMap = bindingStates[geometry->id];
+        auto& states = bindingStates.get(geometry);
 
-        auto& stateMap = programMap[program->id];
+        for (const auto& entry : states) {
 
-        if (!stateMap.contains(wireframe)) {
-
-            stateMap[wireframe] = createBindingState(createVertexArrayObject());
+            if (entry.program == program->id && entry.wireframe == wireframe) return entry.state;
         }
 
-        return stateMap.at(wireframe);
+        return states.emplace_back(StateEntry{program->id, wireframe, createBindingState(createVertexArrayObject())}).state;
     }
 
     [[nodiscard]] std::shared_ptr<GLBindingState> createBindingState(std::optional<GLuint> vao) const {
@@ -147,6 +156,8 @@ struct GLBindingStates::Impl {
 
         if (currentState_->index != index) return true;
 
+        if (currentState_->layoutVersion != attributes_.layoutVersion()) return true;
+
         return false;
     }
 
@@ -167,6 +178,7 @@ struct GLBindingStates::Impl {
         currentState_->attributesNum = attributesNum;
 
         currentState_->index = index;
+        currentState_->layoutVersion = attributes_.layoutVersion();
     }
 
     void initAttributes() const {
@@ -222,7 +234,9 @@ struct GLBindingStates::Impl {
 
     void vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, size_t offset) {
 
-        if (type == GL_INT || type == GL_UNSIGNED_INT) {
+        // 32 bit integers feed integer attributes, every other type is converted to float,
+        // mapped to [0, 1] or [-1, 1] when normalized (compact positions, normals, colors and uvs)
+        if ((type == GL_INT || type == GL_UNSIGNED_INT) && !normalized) {
 
             glVertexAttribIPointer(index, size, type, stride, (GLvoid*) offset);
 
@@ -232,7 +246,7 @@ struct GLBindingStates::Impl {
         }
     }
 
-    void setupVertexAttributes(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry) {
+    void setupVertexAttributes(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, int firstInstance) {
 
         initAttributes();
 
@@ -282,13 +296,13 @@ struct GLBindingStates::Impl {
                         }
 
                         glBindBuffer(GL_ARRAY_BUFFER, buffer);
-                        vertexAttribPointer(programAttribute, size, type, normalized, stride * bytesPerElement, offset * bytesPerElement);
+                        vertexAttribPointer(programAttribute, size, type, normalized, stride * bytesPerElement, attribute.offset + offset * bytesPerElement);
 
                     } else {
 
-                        if (false /*geometryAttribute.isInstancedBufferAttribute*/) {
+                        if (const auto meshPerAttribute = geometryAttribute->meshPerAttribute(); meshPerAttribute > 0) {
 
-                            // TODO
+                            enableAttributeAndDivisor(programAttribute, meshPerAttribute);
 
                         } else {
 
@@ -296,15 +310,17 @@ struct GLBindingStates::Impl {
                         }
 
                         glBindBuffer(GL_ARRAY_BUFFER, buffer);
-                        vertexAttribPointer(programAttribute, size, type, normalized, 0, 0);
+                        vertexAttribPointer(programAttribute, size, type, normalized, 0, attribute.offset);
                     }
 
                 } else if (name == "instanceMatrix") {
 
-                    auto attribute = attributes_.get(object->as<InstancedMesh>()->instanceMatrix());
+                    auto instancedMesh = object->as<InstancedMesh>();
+                    auto attribute = attributes_.get(instancedMesh->hasVisibilityPipeline() ? instancedMesh->visibleInstanceMatrix() : instancedMesh->instanceMatrix());
 
                     auto buffer = attribute.buffer;
                     auto type = attribute.type;
+                    auto offset = attribute.offset + firstInstance * 64;
 
                     enableAttributeAndDivisor(programAttribute + 0, 1);
                     enableAttributeAndDivisor(programAttribute + 1, 1);
@@ -313,14 +329,15 @@ struct GLBindingStates::Impl {
 
                     glBindBuffer(GL_ARRAY_BUFFER, buffer);
 
-                    glVertexAttribPointer(programAttribute + 0, 4, type, false, 64, (void*) 0);
-                    glVertexAttribPointer(programAttribute + 1, 4, type, false, 64, (void*) 16);
-                    glVertexAttribPointer(programAttribute + 2, 4, type, false, 64, (void*) 32);
-                    glVertexAttribPointer(programAttribute + 3, 4, type, false, 64, (void*) 48);
+                    glVertexAttribPointer(programAttribute + 0, 4, type, false, 64, (void*) (offset + 0));
+                    glVertexAttribPointer(programAttribute + 1, 4, type, false, 64, (void*) (offset + 16));
+                    glVertexAttribPointer(programAttribute + 2, 4, type, false, 64, (void*) (offset + 32));
+                    glVertexAttribPointer(programAttribute + 3, 4, type, false, 64, (void*) (offset + 48));
 
                 } else if (name == "instanceColor") {
 
-                    auto attribute = attributes_.get(object->as<InstancedMesh>()->instanceColor());
+                    auto instancedMesh = object->as<InstancedMesh>();
+                    auto attribute = attributes_.get(instancedMesh->hasVisibilityPipeline() ? instancedMesh->visibleInstanceColor() : instancedMesh->instanceColor());
 
                     auto buffer = attribute.buffer;
                     auto type = attribute.type;
@@ -329,7 +346,7 @@ struct GLBindingStates::Impl {
 
                     glBindBuffer(GL_ARRAY_BUFFER, buffer);
 
-                    glVertexAttribPointer(programAttribute, 3, type, false, 12, 0);
+                    glVertexAttribPointer(programAttribute, 3, type, false, 12, (void*) (attribute.offset + firstInstance * 12));
 
                 } else if (!materialDefaultAttributeValues.empty()) {
 
@@ -350,69 +367,39 @@ struct GLBindingStates::Impl {
 
         reset();
 
-        for (auto geoIt = bindingStates.begin(); geoIt != bindingStates.end();) {
-            auto& programMap = geoIt->second;
-
-            for (auto progIt = programMap.begin(); progIt != programMap.end();) {
-                auto& stateMap = progIt->second;
-
-                for (auto it = stateMap.begin(); it != stateMap.end();) {
-                    // const auto& wireframe = *it;
+        bindingStates.forEach([this](BufferGeometry*, std::vector<StateEntry>& states) {
+            for (const auto& entry : states) {
 
-                    deleteVertexArrayObject(*it->second->object);
-
-                    it = stateMap.erase(it);
-                }
-
-                progIt = programMap.erase(progIt);
+                deleteVertexArrayObject(*entry.state->object);
             }
+        });
 
-            geoIt = bindingStates.erase(geoIt);
-        }
+        bindingStates.clear();
     }
 
     void releaseStatesOfGeometry(BufferGeometry* geometry) {
 
-        if (!bindingStates.contains(geometry->id)) return;
-
-        ProgramMap& programMap = bindingStates[geometry->id];
+        auto states = bindingStates.find(geometry);
+        if (!states) return;
 
-        for (const auto& programId : programMap) {
-
-            StateMap& stateMap = programMap.at(programId.first);
-
-            for (const auto& wireframe : stateMap) {
-
-                deleteVertexArrayObject(*stateMap.at(wireframe.first)->object);
-            }
+        for (const auto& entry : *states) {
 
-            stateMap.clear();
+            deleteVertexArrayObject(*entry.state->object);
         }
 
-        programMap.clear();
-
-        bindingStates.erase(geometry->id);
+        bindingStates.remove(geometry);
     }
 
     void releaseStatesOfProgram(GLProgram& program) {
 
-        for (const auto& geometryId : bindingStates) {
-
-            auto& programMap = bindingStates[geometryId.first];
-
-            if (!programMap.contains(program.id)) continue;
-
-            auto& stateMap = programMap.at(program.id);
+        bindingStates.forEach([&](BufferGeometry*, std::vector<StateEntry>& states) {
+            std::erase_if(states, [&](const StateEntry& entry) {
+                if (entry.program != program.id) return false;
 
-            for (const auto& wireframe : stateMap) {
-
-                auto& value = stateMap.at(wireframe.first);
-                deleteVertexArrayObject(*value->object);
-            }
-            stateMap.clear();
-
-            programMap.erase(program.id);
-        }
+                deleteVertexArrayObject(*entry.state->object);
+                return true;
+            });
+        });
     }
 
     void reset() {
@@ -428,9 +415,9 @@ GLBindingStates::GLBindingStates(GLAttributes& attributes)
     : pimpl_(std::make_unique<Impl>(attributes)) {
 }
 
-void GLBindingStates::setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index) {
+void GLBindingStates::setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index, int firstInstance) {
 
-    pimpl_->setup(object, material, program, geometry, index);
+    pimpl_->setup(object, material, program, geometry, index, firstInstance);
 }
 
 void GLBindingStates::initAttributes() {
@@ -24,6 +24,7 @@ namespace threepp::gl {
         std::optional<unsigned int> object;
         std::unordered_map<std::string, BufferAttribute*> attributes;
         BufferAttribute* index = nullptr;
+        unsigned int layoutVersion = 0;// GLAttributes::layoutVersion() when the attribute pointers were recorded
 
         int attributesNum = 0;
 
@@ -43,7 +44,8 @@ namespace threepp::gl {
     public:
         explicit GLBindingStates(GLAttributes& attributes);
 
-        void setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index);
+        // firstInstance offsets the per instance attributes of an InstancedMesh, which GL 3.3 cannot do in the draw call.
+        void setup(Object3D* object, Material* material, GLProgram* program, BufferGeometry* geometry, BufferAttribute* index, int firstInstance = 0);
 
         void initAttributes();
 
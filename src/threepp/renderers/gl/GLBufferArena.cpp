@@ -0,0 +1,134 @@
+
+#include "threepp/renderers/gl/GLBufferArena.hpp"
+
+#include <algorithm>
+
+#ifndef EMSCRIPTEN
+#include <glad/glad.h>
+#else
+#include <GLES3/gl3.h>
+#endif
+
+using namespace threepp::gl;
+
+namespace {
+
+    long long align(long long size) {
+
+        return (size + GLBufferArena::alignment - 1) / GLBufferArena::alignment * GLBufferArena::alignment;
+    }
+
+}// namespace
+
+GLBufferArena::GLBufferArena(long long pageSize)
+    : pageSize_(align(pageSize)) {}
+
+GLBufferArena::Allocation GLBufferArena::allocate(unsigned int target, long long size) {
+
+    size = align(std::max(size, 1LL));
+
+    auto& list = pages(target);
+
+    // first fit
+    for (auto& page : list) {
+
+        for (auto it = page.free.begin(); it != page.free.end(); ++it) {
+
+            if (it->size < size) continue;
+
+            Allocation allocation{page.buffer, it->offset, size};
+
+            it->offset += size;
+            it->size -= size;
+            if (it->size == 0) page.free.erase(it);
+
+            return allocation;
+        }
+    }
+
+    // new page, oversized requests get one of their own
+    const auto pageSize = std::max(pageSize_, size);
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+
+    // the first binding decides the buffer's type in WebGL. For index pages, the element binding of the current
+    // vertex array object is restored afterwards
+    GLint previous = 0;
+    if (target == GL_ELEMENT_ARRAY_BUFFER) glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &previous);
+
+    glBindBuffer(target, buffer);
+    glBufferData(target, (GLsizeiptr) pageSize, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(target, previous);
+
+    auto& page = list.emplace_back(Page{buffer, pageSize, {}});
+    if (size < pageSize) page.free.emplace_back(Range{size, pageSize - size});
+
+    return {buffer, 0, size};
+}
+
+void GLBufferArena::free(unsigned int target, const Allocation& allocation) {
+
+    auto& list = pages(target);
+
+    const auto pageIt = std::ranges::find(list, allocation.buffer, &Page::buffer);
+    if (pageIt == list.end()) return;
+
+    auto& free = pageIt->free;
+
+    // the allocated size, which callers may only know unaligned
+    const auto size = align(std::max(allocation.size, 1LL));
+
+    auto next = std::ranges::lower_bound(free, allocation.offset, {}, &Range::offset);
+    next = free.insert(next, Range{allocation.offset, size});
+
+    // coalesce with the following, then the preceding range
+    if (auto after = next + 1; after != free.end() && next->offset + next->size == after->offset) {
+
+        next->size += after->size;
+        free.erase(after);
+    }
+
+    if (next != free.begin()) {
+
+        auto before = next - 1;
+        if (before->offset + before->size == next->offset) {
+
+            before->size += next->size;
+            free.erase(next);
+        }
+    }
+
+    // release pages that are entirely unused
+    if (free.size() == 1 && free.front().offset == 0 && free.front().size == pageIt->size) {
+
+        glDeleteBuffers(1, &pageIt->buffer);
+        list.erase(pageIt);
+    }
+}
+
+void GLBufferArena::upload(const Allocation& allocation, long long offset, long long size, const void* data) {
+
+    // the copy target is not part of vertex array object state, and may hold both vertex and index buffers in WebGL
+    glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr) (allocation.offset + offset), (GLsizeiptr) size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GLBufferArena::dispose() {
+
+    for (auto list : {&vertexPages_, &indexPages_}) {
+
+        for (auto& page : *list) {
+
+            glDeleteBuffers(1, &page.buffer);
+        }
+
+        list->clear();
+    }
+}
+
+std::vector<GLBufferArena::Page>& GLBufferArena::pages(unsigned int target) {
+
+    return target == GL_ELEMENT_ARRAY_BUFFER ? indexPages_ : vertexPages_;
+}
@@ -0,0 +1,73 @@
+
+#ifndef THREEPP_GLBUFFERARENA_HPP
+#define THREEPP_GLBUFFERARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace threepp::gl {
+
+    // Packs many small, static buffers into a few large GL buffers ("pages").
+    // Vertex and index data live in separate pages, as WebGL does not allow a buffer to serve as both.
+    // Freed ranges go back to a per page free list and are reused by later allocations.
+    class GLBufferArena {
+
+    public:
+        struct Allocation {
+
+            unsigned int buffer = 0;
+            long long offset = 0;// in bytes
+            long long size = 0;
+        };
+
+        // Allocations (and offsets) are aligned to this many bytes, which satisfies every vertex and index type.
+        static constexpr long long alignment = 16;
+
+        explicit GLBufferArena(long long pageSize = 4 << 20);
+
+        [[nodiscard]] long long pageSize() const {
+
+            return pageSize_;
+        }
+
+        // target is GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+        Allocation allocate(unsigned int target, long long size);
+
+        // allocation.size may be the size that was requested, the range freed is always the one handed out.
+        void free(unsigned int target, const Allocation& allocation);
+
+        // Writes size bytes at offset within the allocation, without disturbing the bound vertex array object.
+        static void upload(const Allocation& allocation, long long offset, long long size, const void* data);
+
+        // GL buffers currently backing allocations, pages with no allocations left are released.
+        [[nodiscard]] size_t numPages() const {
+
+            return vertexPages_.size() + indexPages_.size();
+        }
+
+        void dispose();
+
+    private:
+        struct Range {
+
+            long long offset;
+            long long size;
+        };
+
+        struct Page {
+
+            unsigned int buffer;
+            long long size;
+            std::vector<Range> free;// sorted by offset, never adjacent
+        };
+
+        long long pageSize_;
+        std::vector<Page> vertexPages_;
+        std::vector<Page> indexPages_;
+
+        std::vector<Page>& pages(unsigned int target);
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLBUFFERARENA_HPP
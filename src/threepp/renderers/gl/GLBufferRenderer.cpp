@@ -35,15 +35,35 @@ void GLBufferRenderer::renderInstances(int start, int count, int primcount) {
     info_.update(count, mode_, primcount);
 }
 
+void GLBufferRenderer::renderMultiDraw(const std::vector<int>& starts, const std::vector<int>& counts) {
+
+    if (starts.empty()) return;
+
+#ifndef EMSCRIPTEN
+    glMultiDrawArrays(mode_, starts.data(), counts.data(), static_cast<GLsizei>(starts.size()));
+#else
+    for (size_t i = 0; i < starts.size(); i++) {
+
+        glDrawArrays(mode_, starts[i], counts[i]);
+    }
+#endif
+
+    int elementCount = 0;
+    for (auto count : counts) elementCount += count;
+
+    info_.update(elementCount, mode_, 1);
+}
+
 void GLIndexedBufferRenderer::setIndex(const Buffer& value) {
 
     type_ = value.type;
     bytesPerElement_ = value.bytesPerElement;
+    offset_ = value.offset;
 }
 
 void GLIndexedBufferRenderer::render(int start, int count) {
 
-    glDrawElements(mode_, count, type_, (GLvoid*) (start * bytesPerElement_));
+    glDrawElements(mode_, count, type_, (GLvoid*) (offset_ + start * bytesPerElement_));
 
     info_.update(count, mode_, 1);
 }
@@ -52,7 +72,32 @@ void GLIndexedBufferRenderer::renderInstances(int start, int count, int primcoun
 
     if (primcount == 0) return;
 
-    glDrawElementsInstanced(mode_, count, type_, (GLvoid*) (start * bytesPerElement_), primcount);
+    glDrawElementsInstanced(mode_, count, type_, (GLvoid*) (offset_ + start * bytesPerElement_), primcount);
 
     info_.update(count, mode_, primcount);
 }
+
+void GLIndexedBufferRenderer::renderMultiDraw(const std::vector<int>& starts, const std::vector<int>& counts) {
+
+    if (starts.empty()) return;
+
+    offsets_.clear();
+    for (auto start : starts) {
+
+        offsets_.emplace_back((const GLvoid*) (offset_ + start * bytesPerElement_));
+    }
+
+#ifndef EMSCRIPTEN
+    glMultiDrawElements(mode_, counts.data(), type_, offsets_.data(), static_cast<GLsizei>(starts.size()));
+#else
+    for (size_t i = 0; i < starts.size(); i++) {
+
+        glDrawElements(mode_, counts[i], type_, offsets_[i]);
+    }
+#endif
+
+    int elementCount = 0;
+    for (auto count : counts) elementCount += count;
+
+    info_.update(elementCount, mode_, 1);
+}
@@ -36,6 +36,35 @@ namespace threepp::gl {
 
         const int maxSamples;
 
+        // GL_KHR_parallel_shader_compile (or the ARB variant), programs can be polled for completion without blocking
+        const bool parallelShaderCompile;
+
+        // block compressed texture formats the GPU can sample, others are decompressed on upload
+        const bool textureCompressionS3TC;
+        const bool textureCompressionRGTC;
+        const bool textureCompressionBPTC;
+        const bool textureCompressionETC2;
+
+        [[nodiscard]] bool supportsCompressedFormat(Format format) const {
+
+            switch (format) {
+                case Format::RGB_S3TC_DXT1:
+                case Format::RGBA_S3TC_DXT1:
+                case Format::RGBA_S3TC_DXT5:
+                    return textureCompressionS3TC;
+                case Format::RED_RGTC1:
+                case Format::RED_GREEN_RGTC2:
+                    return textureCompressionRGTC;
+                case Format::RGBA_BPTC:
+                    return textureCompressionBPTC;
+                case Format::RGB_ETC2:
+                case Format::RGBA_ETC2_EAC:
+                    return textureCompressionETC2;
+                default:
+                    return false;
+            }
+        }
+
         GLCapabilities(const GLCapabilities&) = delete;
         void operator=(const GLCapabilities&) = delete;
 
@@ -52,6 +81,11 @@ namespace threepp::gl {
                << " maxFragmentUniforms: " << v.maxFragmentUniforms << "\n"
                << " vertexTextures: " << (v.vertexTextures ? "true" : "false") << "\n"
                << " maxSamples: " << v.maxSamples << "\n"
+               << " parallelShaderCompile: " << (v.parallelShaderCompile ? "true" : "false") << "\n"
+               << " textureCompressionS3TC: " << (v.textureCompressionS3TC ? "true" : "false") << "\n"
+               << " textureCompressionRGTC: " << (v.textureCompressionRGTC ? "true" : "false") << "\n"
+               << " textureCompressionBPTC: " << (v.textureCompressionBPTC ? "true" : "false") << "\n"
+               << " textureCompressionETC2: " << (v.textureCompressionETC2 ? "true" : "false") << "\n"
                << ")";
             return os;
         }
@@ -79,7 +113,14 @@ namespace threepp::gl {
               floatFragmentTextures(GL_ARB_texture_float),
               floatVertexTextures(vertexTextures && floatFragmentTextures),
 
-              maxSamples(glGetParameteri(GL_MAX_SAMPLES)) {}
+              maxSamples(glGetParameteri(GL_MAX_SAMPLES)),
+
+              parallelShaderCompile(glHasExtension("GL_KHR_parallel_shader_compile") || glHasExtension("GL_ARB_parallel_shader_compile")),
+
+              textureCompressionS3TC(glHasExtension("GL_EXT_texture_compression_s3tc")),
+              textureCompressionRGTC(glVersionAtLeast(3, 0) || glHasExtension("GL_ARB_texture_compression_rgtc")),
+              textureCompressionBPTC(glVersionAtLeast(4, 2) || glHasExtension("GL_ARB_texture_compression_bptc")),
+              textureCompressionETC2(glVersionAtLeast(4, 3) || glHasExtension("GL_ARB_ES3_compatibility")) {}
     };
 
 }// namespace threepp::gl
@@ -0,0 +1,340 @@
+
+#include "threepp/renderers/gl/GLClusteredLights.hpp"
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/lights/PointLight.hpp"
+#include "threepp/lights/SpotLight.hpp"
+#include "threepp/renderers/gl/GLUniforms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr int clusterCount = GLClusteredLights::tilesX * GLClusteredLights::tilesY * GLClusteredLights::slices;
+
+    // lights are 4 RGBA texels: position and distance, color and decay, direction and cone cos, penumbra cos
+    constexpr unsigned int lightsTextureWidth = 256;
+    constexpr unsigned int floatsPerLight = 16;
+    // light indices are packed 4 to a texel
+    constexpr unsigned int indexTextureWidth = 1024;
+
+    // Grows texture to hold at least rows rows, and returns its data.
+    std::vector<float>& reserveRows(std::shared_ptr<DataTexture>& texture, unsigned int width, unsigned int rows) {
+
+        rows = std::max(rows, 1u);
+
+        if (!texture || texture->image().height < rows) {
+
+            if (texture) {
+
+                rows = std::max(rows, texture->image().height * 2);
+                texture->dispose();
+            }
+
+            texture = DataTexture::create(std::vector<float>(width * rows * 4), width, rows);
+            texture->format = Format::RGBA;
+            texture->type = Type::Float;
+        }
+
+        texture->needsUpdate();
+
+        return texture->image().data<float>();
+    }
+
+    int tileAt(float ndc, int tiles) {
+
+        return std::clamp(static_cast<int>(std::floor((ndc + 1) * 0.5f * static_cast<float>(tiles))), 0, tiles - 1);
+    }
+
+    bool intersects(const Vector3& center, float radius, const Box3& box) {
+
+        const auto dx = std::max({box.min().x - center.x, 0.f, center.x - box.max().x});
+        const auto dy = std::max({box.min().y - center.y, 0.f, center.y - box.max().y});
+        const auto dz = std::max({box.min().z - center.z, 0.f, center.z - box.max().z});
+
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+}// namespace
+
+
+void GLClusteredLights::update(const std::vector<Light*>& lights, const Camera& camera, ThreadPool* pool) {
+
+    const auto near = camera.near;
+    const auto far = camera.far;
+
+    // logarithmic slices keep clusters close to cubes in perspective, which needs a positive near plane
+    const bool logarithmic = camera.is<PerspectiveCamera>() && near > 0;
+
+    if (logarithmic) {
+
+        slicing_.x = static_cast<float>(slices) / std::log(far / near);
+        slicing_.y = -std::log(near) * slicing_.x;
+
+    } else {
+
+        slicing_.x = static_cast<float>(slices) / (far - near);
+        slicing_.y = -near * slicing_.x;
+    }
+
+    size_.w = logarithmic ? 1.f : 0.f;
+    projection_.copy(camera.projectionMatrix);
+
+    if (clusterBoxes_.empty() || !boxesProjection_.equals(projection_) || !boxesSlicing_.equals(slicing_)) {
+
+        updateClusterBoxes(camera);
+    }
+
+    // light data, and the range of clusters each light may reach
+
+    auto& data = reserveRows(lightsTexture_, lightsTextureWidth, (static_cast<unsigned int>(lights.size()) * floatsPerLight / 4 + lightsTextureWidth - 1) / lightsTextureWidth);
+
+    const auto& viewMatrix = camera.matrixWorldInverse;
+    const bool perspective = camera.is<PerspectiveCamera>();
+
+    bounds_.resize(lights.size());
+
+    for (size_t i = 0; i < lights.size(); i++) {
+
+        const auto light = lights[i];
+        auto& bounds = bounds_[i];
+
+        Vector3 direction;
+        float distance = 0, decay = 1;
+        float coneCos = -2, penumbraCos = -1;// lets every direction through
+
+        if (auto spotLight = light->as<SpotLight>()) {
+
+            distance = spotLight->distance;
+            decay = spotLight->decay;
+            coneCos = std::cos(spotLight->angle);
+            penumbraCos = std::cos(spotLight->angle * (1 - spotLight->penumbra));
+
+            direction.setFromMatrixPosition(spotLight->matrixWorld);
+            Vector3 target;
+            target.setFromMatrixPosition(spotLight->target().matrixWorld);
+            direction.sub(target).transformDirection(viewMatrix);
+
+        } else if (auto pointLight = light->as<PointLight>()) {
+
+            distance = pointLight->distance;
+            decay = pointLight->decay;
+        }
+
+        bounds.center.setFromMatrixPosition(light->matrixWorld).applyMatrix4(viewMatrix);
+        bounds.radius = distance > 0 ? distance : std::numeric_limits<float>::infinity();
+
+        const auto color = Color(light->color).multiplyScalar(light->intensity);
+
+        const auto offset = i * floatsPerLight;
+        bounds.center.toArray(data, offset);
+        data[offset + 3] = distance;
+        color.toArray(data, offset + 4);
+        data[offset + 7] = decay;
+        direction.toArray(data, offset + 8);
+        data[offset + 11] = coneCos;
+        data[offset + 12] = penumbraCos;
+
+        const auto depth = -bounds.center.z;
+
+        if (std::isinf(bounds.radius)) {
+
+            bounds.x0 = bounds.y0 = bounds.z0 = 0;
+            bounds.x1 = tilesX - 1;
+            bounds.y1 = tilesY - 1;
+            bounds.z1 = slices - 1;
+            continue;
+        }
+
+        if (depth + bounds.radius < near || depth - bounds.radius > far) {
+
+            // reaches no cluster
+            bounds.z0 = 0;
+            bounds.z1 = -1;
+            continue;
+        }
+
+        bounds.z0 = std::clamp(static_cast<int>(sliceAt(std::max(depth - bounds.radius, near))), 0, slices - 1);
+        bounds.z1 = std::clamp(static_cast<int>(sliceAt(std::min(depth + bounds.radius, far))), 0, slices - 1);
+
+        if (perspective && depth - bounds.radius <= near) {
+
+            // surrounds the camera, so its projection is unbounded
+            bounds.x0 = bounds.y0 = 0;
+            bounds.x1 = tilesX - 1;
+            bounds.y1 = tilesY - 1;
+            continue;
+        }
+
+        // project the corners of the box around the light
+
+        Vector2 min(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+        Vector2 max(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity());
+
+        for (unsigned corner = 0; corner < 8; corner++) {
+
+            Vector3 point(
+                    bounds.center.x + ((corner & 1) ? bounds.radius : -bounds.radius),
+                    bounds.center.y + ((corner & 2) ? bounds.radius : -bounds.radius),
+                    bounds.center.z + ((corner & 4) ? bounds.radius : -bounds.radius));
+            point.applyMatrix4(projection_);
+
+            min.x = std::min(min.x, point.x);
+            min.y = std::min(min.y, point.y);
+            max.x = std::max(max.x, point.x);
+            max.y = std::max(max.y, point.y);
+        }
+
+        bounds.x0 = tileAt(min.x, tilesX);
+        bounds.x1 = tileAt(max.x, tilesX);
+        bounds.y0 = tileAt(min.y, tilesY);
+        bounds.y1 = tileAt(max.y, tilesY);
+    }
+
+    // assign lights to clusters, one slice at a time
+
+    clusterLights_.resize(clusterCount);
+
+    if (pool) {
+
+        pool->parallelFor(slices, [&](size_t slice) { updateSlice(static_cast<int>(slice)); });
+
+    } else {
+
+        for (int slice = 0; slice < slices; slice++) updateSlice(slice);
+    }
+
+    // pack the lists of all clusters into one texture, pointed to by the grid
+
+    size_t total = 0;
+    for (const auto& list : clusterLights_) total += list.size();
+
+    auto& grid = reserveRows(gridTexture_, tilesX * tilesY, slices);
+    auto& indices = reserveRows(indexTexture_, indexTextureWidth, static_cast<unsigned int>((total + indexTextureWidth * 4 - 1) / (indexTextureWidth * 4)));
+
+    size_t offset = 0;
+    for (int cluster = 0; cluster < clusterCount; cluster++) {
+
+        const auto& list = clusterLights_[cluster];
+
+        grid[cluster * 4] = static_cast<float>(offset);
+        grid[cluster * 4 + 1] = static_cast<float>(list.size());
+
+        std::copy(list.begin(), list.end(), indices.begin() + static_cast<std::ptrdiff_t>(offset));
+        offset += list.size();
+    }
+}
+
+void GLClusteredLights::setUniforms(GLUniforms& uniforms, GLTextures& textures) const {
+
+    if (!gridTexture_) return;// not updated yet
+
+    uniforms.setValue("clusterLights", lightsTexture_.get(), &textures);
+    uniforms.setValue("clusterGrid", gridTexture_.get(), &textures);
+    uniforms.setValue("clusterIndices", indexTexture_.get(), &textures);
+    uniforms.setValue("clusterProjection", projection_);
+    uniforms.setValue("clusterSize", size_);
+    uniforms.setValue("clusterSlicing", slicing_);
+}
+
+void GLClusteredLights::dispose() {
+
+    for (auto texture : {lightsTexture_.get(), gridTexture_.get(), indexTexture_.get()}) {
+
+        if (texture) texture->dispose();
+    }
+
+    lightsTexture_.reset();
+    gridTexture_.reset();
+    indexTexture_.reset();
+}
+
+float GLClusteredLights::sliceAt(float depth) const {
+
+    return (size_.w > 0 ? std::log(depth) : depth) * slicing_.x + slicing_.y;
+}
+
+float GLClusteredLights::depthAt(float slice) const {
+
+    const auto value = (slice - slicing_.y) / slicing_.x;
+
+    return size_.w > 0 ? std::exp(value) : value;
+}
+
+void GLClusteredLights::updateClusterBoxes(const Camera& camera) {
+
+    clusterBoxes_.resize(clusterCount);
+
+    for (int y = 0; y < tilesY; y++) {
+
+        for (int x = 0; x < tilesX; x++) {
+
+            // the four edges of the tile, from the near to the far plane
+            std::array<Vector3, 4> edgeNear, edgeFar;
+
+            for (unsigned i = 0; i < 4; i++) {
+
+                const auto ndcX = static_cast<float>(x + (i & 1)) / tilesX * 2 - 1;
+                const auto ndcY = static_cast<float>(y + ((i & 2) >> 1)) / tilesY * 2 - 1;
+
+                edgeNear[i].set(ndcX, ndcY, -1).applyMatrix4(camera.projectionMatrixInverse);
+                edgeFar[i].set(ndcX, ndcY, 1).applyMatrix4(camera.projectionMatrixInverse);
+            }
+
+            for (int z = 0; z < slices; z++) {
+
+                auto& box = clusterBoxes_[x + y * tilesX + z * tilesX * tilesY];
+                box.makeEmpty();
+
+                for (auto depth : {depthAt(static_cast<float>(z)), depthAt(static_cast<float>(z + 1))}) {
+
+                    for (unsigned i = 0; i < 4; i++) {
+
+                        const auto t = (depth + edgeNear[i].z) / (edgeNear[i].z - edgeFar[i].z);
+
+                        Vector3 point;
+                        point.lerpVectors(edgeNear[i], edgeFar[i], t);
+                        box.expandByPoint(point);
+                    }
+                }
+            }
+        }
+    }
+
+    boxesProjection_.copy(projection_);
+    boxesSlicing_.copy(slicing_);
+}
+
+void GLClusteredLights::updateSlice(int slice) {
+
+    const auto first = slice * tilesX * tilesY;
+
+    for (int i = 0; i < tilesX * tilesY; i++) clusterLights_[first + i].clear();
+
+    for (size_t i = 0; i < bounds_.size(); i++) {
+
+        const auto& bounds = bounds_[i];
+
+        if (slice < bounds.z0 || slice > bounds.z1) continue;
+
+        const bool everywhere = std::isinf(bounds.radius);
+
+        for (int y = bounds.y0; y <= bounds.y1; y++) {
+
+            for (int x = bounds.x0; x <= bounds.x1; x++) {
+
+                const auto cluster = first + x + y * tilesX;
+
+                if (everywhere || intersects(bounds.center, bounds.radius, clusterBoxes_[cluster])) {
+
+                    clusterLights_[cluster].emplace_back(static_cast<float>(i));
+                }
+            }
+        }
+    }
+}
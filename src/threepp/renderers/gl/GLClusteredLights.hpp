@@ -0,0 +1,76 @@
+
+#ifndef THREEPP_GLCLUSTEREDLIGHTS_HPP
+#define THREEPP_GLCLUSTEREDLIGHTS_HPP
+
+#include "threepp/cameras/Camera.hpp"
+#include "threepp/lights/Light.hpp"
+#include "threepp/math/Box3.hpp"
+#include "threepp/math/Vector2.hpp"
+#include "threepp/math/Vector4.hpp"
+#include "threepp/textures/DataTexture.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace threepp::gl {
+
+    struct GLUniforms;
+    struct GLTextures;
+
+    // Froxel grid for many point and spot lights: screen tiles times view depth slices, each listing the lights that reach it.
+    // Rebuilt on the CPU every frame into float textures read by programs compiled with USE_CLUSTERED_LIGHTS,
+    // so the number of lights never changes the program.
+    class GLClusteredLights {
+
+    public:
+        static constexpr int tilesX = 16;
+        static constexpr int tilesY = 9;
+        static constexpr int slices = 24;
+
+        // Light positions and directions are taken in the view space of camera. Slices are built in parallel on pool when given.
+        void update(const std::vector<Light*>& lights, const Camera& camera, ThreadPool* pool = nullptr);
+
+        void setUniforms(GLUniforms& uniforms, GLTextures& textures) const;
+
+        void dispose();
+
+    private:
+        struct LightBounds {
+
+            Vector3 center;
+            float radius;
+
+            int x0, x1;
+            int y0, y1;
+            int z0, z1;
+        };
+
+        std::shared_ptr<DataTexture> lightsTexture_;
+        std::shared_ptr<DataTexture> gridTexture_;
+        std::shared_ptr<DataTexture> indexTexture_;
+
+        Matrix4 projection_;
+        Vector4 size_{tilesX, tilesY, slices, 0};
+        // slice = depth (or its log) * x + y
+        Vector2 slicing_;
+
+        std::vector<Box3> clusterBoxes_;
+        Matrix4 boxesProjection_;
+        Vector2 boxesSlicing_;
+
+        std::vector<LightBounds> bounds_;
+        std::vector<std::vector<float>> clusterLights_;
+
+        [[nodiscard]] float sliceAt(float depth) const;
+
+        [[nodiscard]] float depthAt(float slice) const;
+
+        void updateClusterBoxes(const Camera& camera);
+
+        void updateSlice(int slice);
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLCLUSTEREDLIGHTS_HPP
@@ -4,6 +4,7 @@
 #include "threepp/renderers/gl/GLAttributes.hpp"
 #include "threepp/renderers/gl/GLBindingStates.hpp"
 #include "threepp/renderers/gl/GLInfo.hpp"
+#include "threepp/renderers/gl/GLSlotMap.hpp"
 
 #ifndef EMSCRIPTEN
 #include <glad/glad.h>
@@ -39,7 +40,7 @@ struct GLGeometries::Impl {
 
             geometry->removeEventListener("dispose", *this);
 
-            scope_->geometries_.erase(geometry);
+            scope_->geometries_.remove(geometry);
 
 
             if (scope_->wireframeAttributes_.contains(geometry)) {
@@ -52,10 +53,6 @@ struct GLGeometries::Impl {
 
             scope_->bindingStates_.releaseStatesOfGeometry(geometry);
 
-            //            if (auto ig = dynamic_cast<InstancedBufferGeometry*>(geometry)) {
-            //                ig->_maxInstanceCount = 0;
-            //            }
-
             --scope_->info_.memory.geometries;
         }
 
@@ -69,8 +66,8 @@ struct GLGeometries::Impl {
 
     OnGeometryDispose onGeometryDispose_;
 
-    std::unordered_map<BufferGeometry*, bool> geometries_;
-    std::unordered_map<BufferGeometry*, std::unique_ptr<IntBufferAttribute>> wireframeAttributes_;
+    GLSlotMap<BufferGeometry, bool> geometries_;
+    std::unordered_map<BufferGeometry*, std::unique_ptr<IndexBufferAttribute>> wireframeAttributes_;
 
     Impl(GLAttributes& attributes, GLInfo& info, GLBindingStates& bindingStates)
         : info_(info),
@@ -80,11 +77,12 @@ struct GLGeometries::Impl {
 
     void get(Object3D* /*object*/, BufferGeometry* geometry) {
 
-        if (geometries_.contains(geometry) && geometries_.at(geometry)) return;
+        auto& known = geometries_.get(geometry);
+        if (known) return;
 
         geometry->addEventListener("dispose", onGeometryDispose_);
 
-        geometries_[geometry] = true;
+        known = true;
 
         ++info_.memory.geometries;
     }
@@ -120,29 +118,27 @@ struct GLGeometries::Impl {
         std::vector<unsigned int> indices;
 
         const auto geometryIndex = geometry->getIndex();
-        const auto geometryPosition = geometry->getAttribute<float>("position");
+        const auto geometryPosition = geometry->getAttribute("position");
         unsigned int version = 0;
 
         if (geometryIndex != nullptr) {
 
-            const auto& array = geometryIndex->array();
             version = geometryIndex->version;
 
-            for (unsigned i = 0, l = array.size(); i < l; i += 3) {
+            for (unsigned i = 0, l = geometryIndex->count(); i < l; i += 3) {
 
-                const auto a = array[i + 0];
-                const auto b = array[i + 1];
-                const auto c = array[i + 2];
+                const auto a = geometryIndex->getX(i + 0);
+                const auto b = geometryIndex->getX(i + 1);
+                const auto c = geometryIndex->getX(i + 2);
 
                 indices.insert(indices.end(), {a, b, b, c, c, a});
             }
 
         } else {
 
-            const auto& array = geometryPosition->array();
             version = geometryPosition->version;
 
-            for (unsigned i = 0, l = array.size() / 3 - 1; i < l; i += 3) {
+            for (unsigned i = 0, l = geometryPosition->count() - 1; i < l; i += 3) {
 
                 const auto a = i + 0;
                 const auto b = i + 1;
@@ -152,7 +148,7 @@ struct GLGeometries::Impl {
             }
         }
 
-        auto attribute = IntBufferAttribute::create(indices, 1);
+        auto attribute = IndexBufferAttribute::create(indices);
         attribute->version = version;
 
         // Updating index buffer in VAO now. See WebGLBindingStates
@@ -165,7 +161,7 @@ struct GLGeometries::Impl {
         wireframeAttributes_[geometry] = std::move(attribute);
     }
 
-    IntBufferAttribute* getWireframeAttribute(BufferGeometry* geometry) {
+    IndexBufferAttribute* getWireframeAttribute(BufferGeometry* geometry) {
 
         if (wireframeAttributes_.contains(geometry)) {
 
@@ -193,8 +189,7 @@ struct GLGeometries::Impl {
 
     ~Impl() {
 
-        auto copy = geometries_;
-        for (auto [geom, _] : copy) {
+        for (auto geom : geometries_.keys()) {
             geom->dispose();
         }
     }
@@ -219,7 +214,7 @@ void GLGeometries::updateWireframeAttribute(BufferGeometry* geometry) {
     pimpl_->updateWireframeAttribute(geometry);
 }
 
-IntBufferAttribute* GLGeometries::getWireframeAttribute(BufferGeometry* geometry) {
+IndexBufferAttribute* GLGeometries::getWireframeAttribute(BufferGeometry* geometry) {
 
     return pimpl_->getWireframeAttribute(geometry);
 }
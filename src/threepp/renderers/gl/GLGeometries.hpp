@@ -27,7 +27,7 @@ namespace threepp {
 
             void updateWireframeAttribute(BufferGeometry* geometry);
 
-            IntBufferAttribute* getWireframeAttribute(BufferGeometry* geometry);
+            IndexBufferAttribute* getWireframeAttribute(BufferGeometry* geometry);
 
             ~GLGeometries();
 
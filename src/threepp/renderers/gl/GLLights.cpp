@@ -3,6 +3,7 @@
 
 #include "threepp/renderers/GLRenderTarget.hpp"
 
+#include "threepp/lights/DirectionalLightShadow.hpp"
 #include "threepp/lights/LightProbe.hpp"
 #include "threepp/lights/LightShadow.hpp"
 
@@ -28,10 +29,15 @@ namespace {
         }
     }
 
+    bool isClustered(const Light& light) {
+
+        return !light.castShadow && (light.is<PointLight>() || light.is<SpotLight>());
+    }
+
 }// namespace
 
 
-void GLLights::setup(std::vector<Light*>& lights) {
+void GLLights::setup(std::vector<Light*>& lights, bool clustered) {
 
     float r = 0, g = 0, b = 0;
 
@@ -46,20 +52,32 @@ void GLLights::setup(std::vector<Light*>& lights) {
     int numPointShadows = 0;
     int numSpotShadows = 0;
 
+    // maps are allocated again when their layout changes, e.g. DirectionalLightShadow::setCascades
+    bool shadowMapsChanged = false;
+
     std::ranges::stable_sort(lights, shadowCastingLightsFirst);
 
+    state.clustered = clustered;
+    state.clusteredLights.clear();
+
     for (auto light : lights) {
 
         const auto& color = light->color;
         const auto intensity = light->intensity;
 
-        if (light->type() == "AmbientLight") {
+        // clustered lights stay in the arrays too, for programs that don't shade through the clusters
+        if (clustered && isClustered(*light)) {
+
+            state.clusteredLights.emplace_back(light);
+        }
+
+        if (light->is<AmbientLight>()) {
 
             r += color.r * intensity;
             g += color.g * intensity;
             b += color.b * intensity;
 
-        } else if (light->type() == "LightProbe") {
+        } else if (light->is<LightProbe>()) {
 
             const auto l = light->as<LightProbe>();
 
@@ -77,21 +95,33 @@ void GLLights::setup(std::vector<Light*>& lights) {
             if (light->castShadow) {
 
                 auto& shadow = directionalLight->shadow;
+                auto directionalShadow = std::dynamic_pointer_cast<DirectionalLightShadow>(shadow);
 
                 auto shadowUniforms = shadowCache_.get(*light);
 
                 shadowUniforms->at("shadowBias") = shadow->bias;
                 shadowUniforms->at("shadowNormalBias") = shadow->normalBias;
                 shadowUniforms->at("shadowRadius") = shadow->radius;
-                std::get<Vector2>(shadowUniforms->at("shadowMapSize")).copy(shadow->mapSize);
+                // size of the whole map, cascades included
+                std::get<Vector2>(shadowUniforms->at("shadowMapSize")).copy(shadow->mapSize).multiply(shadow->getFrameExtents());
+                shadowUniforms->at("shadowCascades") = directionalShadow ? directionalShadow->cascades() : 1;
+
+                const auto map = shadow->map ? shadow->map->texture.get() : nullptr;
 
                 ensureCapacity(state.directionalShadow, directionalLength + 1);
                 ensureCapacity(state.directionalShadowMap, directionalLength + 1);
                 ensureCapacity(state.directionalShadowMatrix, directionalLength + 1);
+                ensureCapacity(state.directionalShadowCascadeMatrix, (directionalLength + 1) * DirectionalLightShadow::maxCascades);
+                shadowMapsChanged = shadowMapsChanged || state.directionalShadowMap[directionalLength] != map;
                 state.directionalShadow[directionalLength] = shadowUniforms;
-                state.directionalShadowMap[directionalLength] = shadow->map ? shadow->map->texture.get() : nullptr;
+                state.directionalShadowMap[directionalLength] = map;
                 state.directionalShadowMatrix[directionalLength] = &shadow->matrix;
 
+                for (int i = 0; i < DirectionalLightShadow::maxCascades; i++) {
+
+                    state.directionalShadowCascadeMatrix[directionalLength * DirectionalLightShadow::maxCascades + i] = directionalShadow ? &directionalShadow->cascadeMatrices[i] : &shadow->matrix;
+                }
+
                 ++numDirectionalShadows;
             }
 
@@ -104,7 +134,7 @@ void GLLights::setup(std::vector<Light*>& lights) {
 
             const auto uniforms = cache_.get(*light);
 
-            std::get<Vector3>(uniforms->at("position")).setFromMatrixPosition(*spotLight->matrixWorld);
+            std::get<Vector3>(uniforms->at("position")).setFromMatrixPosition(spotLight->matrixWorld);
 
             std::get<Color>(uniforms->at("color")).copy(color).multiplyScalar(spotLight->intensity);
             std::get<float>(uniforms->at("distance")) = spotLight->distance;
@@ -197,7 +227,9 @@ void GLLights::setup(std::vector<Light*>& lights) {
         hash.hemiLength != hemiLength ||
         hash.numDirectionalShadows != numDirectionalShadows ||
         hash.numPointShadows != numPointShadows ||
-        hash.numSpotShadows != numSpotShadows) {
+        hash.numSpotShadows != numSpotShadows ||
+        hash.clustered != static_cast<int>(clustered) ||
+        shadowMapsChanged) {
 
         state.directional.resize(directionalLength);
         state.spot.resize(spotLength);
@@ -211,6 +243,7 @@ void GLLights::setup(std::vector<Light*>& lights) {
         state.spotShadow.resize(numSpotShadows);
         state.spotShadowMap.resize(numSpotShadows);
         state.directionalShadowMatrix.resize(numDirectionalShadows);
+        state.directionalShadowCascadeMatrix.resize(numDirectionalShadows * DirectionalLightShadow::maxCascades);
         state.pointShadowMatrix.resize(numPointShadows);
         state.spotShadowMatrix.resize(numSpotShadows);
 
@@ -223,6 +256,8 @@ void GLLights::setup(std::vector<Light*>& lights) {
         hash.numPointShadows = numPointShadows;
         hash.numSpotShadows = numSpotShadows;
 
+        hash.clustered = clustered;
+
         state.version = nextVersion++;
     }
 }
@@ -245,10 +280,10 @@ void GLLights::setupView(std::vector<Light*>& lights, Camera* camera) {
 
             auto& direction = std::get<Vector3>(uniforms->at("direction"));
 
-            direction.setFromMatrixPosition(*light->matrixWorld);
+            direction.setFromMatrixPosition(light->matrixWorld);
 
             Vector3 vector3;
-            vector3.setFromMatrixPosition(*l->target().matrixWorld);
+            vector3.setFromMatrixPosition(l->target().matrixWorld);
             direction.sub(vector3);
             direction.transformDirection(viewMatrix);
 
@@ -256,19 +291,19 @@ void GLLights::setupView(std::vector<Light*>& lights, Camera* camera) {
 
         } else if (light->as<SpotLight>()) {
 
-            auto l = dynamic_cast<SpotLight*>(light);
+            auto l = light->as<SpotLight>();
             auto& uniforms = state.spot.at(spotLength);
 
             auto& position = std::get<Vector3>(uniforms->at("position"));
             auto& direction = std::get<Vector3>(uniforms->at("direction"));
 
-            position.setFromMatrixPosition(*l->matrixWorld);
+            position.setFromMatrixPosition(l->matrixWorld);
             position.applyMatrix4(viewMatrix);
 
-            direction.setFromMatrixPosition(*l->matrixWorld);
+            direction.setFromMatrixPosition(l->matrixWorld);
 
             Vector3 vector3;
-            vector3.setFromMatrixPosition(*l->target().matrixWorld);
+            vector3.setFromMatrixPosition(l->target().matrixWorld);
             direction.sub(vector3);
             direction.transformDirection(viewMatrix);
 
@@ -280,7 +315,7 @@ void GLLights::setupView(std::vector<Light*>& lights, Camera* camera) {
 
             auto& position = std::get<Vector3>(uniforms->at("position"));
 
-            position.setFromMatrixPosition(*light->matrixWorld);
+            position.setFromMatrixPosition(light->matrixWorld);
             position.applyMatrix4(viewMatrix);
 
             ++pointLength;
@@ -291,7 +326,7 @@ void GLLights::setupView(std::vector<Light*>& lights, Camera* camera) {
 
             auto& direction = std::get<Vector3>(uniforms->at("direction"));
 
-            direction.setFromMatrixPosition(*light->matrixWorld);
+            direction.setFromMatrixPosition(light->matrixWorld);
             direction.transformDirection(viewMatrix);
             direction.normalize();
 
@@ -86,7 +86,8 @@ namespace threepp::gl {
                         {"shadowBias", 0.f},
                         {"shadowNormalBias", 0.f},
                         {"shadowRadius", 1.f},
-                        {"shadowMapSize", Vector2()}};
+                        {"shadowMapSize", Vector2()},
+                        {"shadowCascades", 1}};
 
             } else if (type == "SpotLight") {
 
@@ -131,6 +132,8 @@ namespace threepp::gl {
                 int numDirectionalShadows = -1;
                 int numPointShadows = -1;
                 int numSpotShadows = -1;
+
+                int clustered = -1;
             };
 
             unsigned int version = 0;
@@ -143,6 +146,7 @@ namespace threepp::gl {
             std::vector<LightUniforms*> directionalShadow;
             std::vector<Texture*> directionalShadowMap;
             std::vector<Matrix4*> directionalShadowMatrix;
+            std::vector<Matrix4*> directionalShadowCascadeMatrix;
             std::vector<LightUniforms*> spot;
             std::vector<LightUniforms*> spotShadow;
             std::vector<Texture*> spotShadowMap;
@@ -152,11 +156,16 @@ namespace threepp::gl {
             std::vector<Texture*> pointShadowMap;
             std::vector<Matrix4*> pointShadowMatrix;
             std::vector<LightUniforms*> hemi;
+
+            // Point and spot lights without shadows are also shaded by GLClusteredLights when clustered,
+            // programs using the clusters only read the shadow-casting part of the point and spot arrays.
+            bool clustered = false;
+            std::vector<Light*> clusteredLights;
         };
 
         LightState state{};
 
-        void setup(std::vector<Light*>& lights);
+        void setup(std::vector<Light*>& lights, bool clustered = false);
 
         void setupView(std::vector<Light*>& lights, Camera* camera);
 
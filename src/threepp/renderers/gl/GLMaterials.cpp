@@ -20,49 +20,49 @@ struct GLMaterials::Impl {
 
     explicit Impl(GLProperties& properties): properties(properties) {}
 
-    void refreshUniformsCommon(UniformMap& uniforms, Material* material) {
-
-        auto colorMaterial = dynamic_cast<MaterialWithColor*>(material);
-        auto mapMaterial = dynamic_cast<MaterialWithMap*>(material);
-        auto specularMaterial = dynamic_cast<MaterialWithSpecularMap*>(material);
-        auto displacementMaterial = dynamic_cast<MaterialWithDisplacementMap*>(material);
-        auto normalMaterial = dynamic_cast<MaterialWithNormalMap*>(material);
-        auto bumpMaterial = dynamic_cast<MaterialWithBumpMap*>(material);
-        auto roughnessMaterial = dynamic_cast<MaterialWithRoughness*>(material);
-        auto metalnessMaterial = dynamic_cast<MaterialWithMetalness*>(material);
-        auto alphaMaterial = dynamic_cast<MaterialWithAlphaMap*>(material);
-        auto emissiveMaterial = dynamic_cast<MaterialWithEmissive*>(material);
+    void refreshUniformsCommon(MaterialUniforms& uniforms, Material* material) {
+
+        auto colorMaterial = material->as<MaterialWithColor>();
+        auto mapMaterial = material->as<MaterialWithMap>();
+        auto specularMaterial = material->as<MaterialWithSpecularMap>();
+        auto displacementMaterial = material->as<MaterialWithDisplacementMap>();
+        auto normalMaterial = material->as<MaterialWithNormalMap>();
+        auto bumpMaterial = material->as<MaterialWithBumpMap>();
+        auto roughnessMaterial = material->as<MaterialWithRoughness>();
+        auto metalnessMaterial = material->as<MaterialWithMetalness>();
+        auto alphaMaterial = material->as<MaterialWithAlphaMap>();
+        auto emissiveMaterial = material->as<MaterialWithEmissive>();
         // auto spriteMaterial = dynamic_cast<SpriteMaterial*>(material);
         // TODO clearcoat
 
-        auto aoMaterial = dynamic_cast<MaterialWithAoMap*>(material);
-        auto lightMaterial = dynamic_cast<MaterialWithLightMap*>(material);
+        auto aoMaterial = material->as<MaterialWithAoMap>();
+        auto lightMaterial = material->as<MaterialWithLightMap>();
 
-        uniforms.at("opacity").setValue(material->opacity);
+        uniforms.at(MaterialUniform::Opacity).setValue(material->opacity);
 
         if (colorMaterial) {
 
-            uniforms.at("diffuse").value<Color>().copy(colorMaterial->color);
+            uniforms.at(MaterialUniform::Diffuse).value<Color>().copy(colorMaterial->color);
         }
 
         if (emissiveMaterial) {
 
-            uniforms.at("emissive").value<Color>().copy(emissiveMaterial->emissive).multiplyScalar(emissiveMaterial->emissiveIntensity);
+            uniforms.at(MaterialUniform::Emissive).value<Color>().copy(emissiveMaterial->emissive).multiplyScalar(emissiveMaterial->emissiveIntensity);
         }
 
         if (mapMaterial && mapMaterial->map) {
 
-            uniforms.at("map").setValue(mapMaterial->map.get());
+            uniforms.at(MaterialUniform::Map).setValue(mapMaterial->map.get());
         }
 
         if (alphaMaterial && alphaMaterial->alphaMap) {
 
-            uniforms.at("alphaMap").setValue(alphaMaterial->alphaMap.get());
+            uniforms.at(MaterialUniform::AlphaMap).setValue(alphaMaterial->alphaMap.get());
         }
 
         if (specularMaterial && specularMaterial->specularMap) {
 
-            uniforms.at("specularMap").setValue(specularMaterial->specularMap.get());
+            uniforms.at(MaterialUniform::SpecularMap).setValue(specularMaterial->specularMap.get());
         }
 
         auto envMap = properties.materialProperties.get(material)->envMap;
@@ -70,29 +70,29 @@ struct GLMaterials::Impl {
 
             auto cubeTexture = dynamic_cast<CubeTexture*>(envMap);
 
-            uniforms.at("envMap").setValue(envMap);
-            uniforms.at("flipEnvMap").value<bool>() = cubeTexture && cubeTexture->_needsFlipEnvMap;
+            uniforms.at(MaterialUniform::EnvMap).setValue(envMap);
+            uniforms.at(MaterialUniform::FlipEnvMap).value<bool>() = cubeTexture && cubeTexture->_needsFlipEnvMap;
 
-            auto reflectiveMaterial = dynamic_cast<MaterialWithReflectivity*>(material);
+            auto reflectiveMaterial = material->as<MaterialWithReflectivity>();
             if (reflectiveMaterial) {
-                uniforms.at("reflectivity").value<float>() = reflectiveMaterial->reflectivity;
-                uniforms.at("refractionRatio").value<float>() = reflectiveMaterial->refractionRatio;
+                uniforms.at(MaterialUniform::Reflectivity).value<float>() = reflectiveMaterial->reflectivity;
+                uniforms.at(MaterialUniform::RefractionRatio).value<float>() = reflectiveMaterial->refractionRatio;
             }
 
             const auto maxMipMapLevel = properties.textureProperties.get(envMap)->maxMipLevel;
             if (maxMipMapLevel) {
-                uniforms["maxMipLevel"].value<int>() = *maxMipMapLevel;
+                uniforms[MaterialUniform::MaxMipLevel].value<int>() = *maxMipMapLevel;
             }
         }
 
         if (lightMaterial && lightMaterial->lightMap) {
-            uniforms.at("lightMap").setValue(lightMaterial->lightMap.get());
-            uniforms.at("lightMapIntensity").setValue(lightMaterial->lightMapIntensity);
+            uniforms.at(MaterialUniform::LightMap).setValue(lightMaterial->lightMap.get());
+            uniforms.at(MaterialUniform::LightMapIntensity).setValue(lightMaterial->lightMapIntensity);
         }
 
         if (aoMaterial && aoMaterial->aoMap) {
-            uniforms.at("aoMap").setValue(aoMaterial->aoMap.get());
-            uniforms.at("aoMapIntensity").setValue(aoMaterial->aoMapIntensity);
+            uniforms.at(MaterialUniform::AoMap).setValue(aoMaterial->aoMap.get());
+            uniforms.at(MaterialUniform::AoMapIntensity).setValue(aoMaterial->aoMapIntensity);
         }
 
         // uv repeat and offset setting priorities
@@ -140,7 +140,7 @@ struct GLMaterials::Impl {
                 uvScaleMap->updateMatrix();
             }
 
-            uniforms.at("uvTransform").value<Matrix3>().copy(uvScaleMap->matrix);
+            uniforms.at(MaterialUniform::UvTransform).value<Matrix3>().copy(uvScaleMap->matrix);
         }
 
         // uv repeat and offset setting priorities for uv2
@@ -165,228 +165,228 @@ struct GLMaterials::Impl {
                 uv2ScaleMap->updateMatrix();
             }
 
-            uniforms.at("uv2Transform").value<Matrix3>().copy(uv2ScaleMap->matrix);
+            uniforms.at(MaterialUniform::Uv2Transform).value<Matrix3>().copy(uv2ScaleMap->matrix);
         }
     }
 
-    void refreshUniformsLambert(UniformMap& uniforms, MeshLambertMaterial* material) {
+    void refreshUniformsLambert(MaterialUniforms& uniforms, MeshLambertMaterial* material) {
 
         auto& emissiveMap = material->emissiveMap;
         if (emissiveMap) {
-            uniforms.at("emissiveMap").setValue(emissiveMap.get());
+            uniforms.at(MaterialUniform::EmissiveMap).setValue(emissiveMap.get());
         }
     }
 
-    void refreshUniformsPhong(UniformMap& uniforms, MeshPhongMaterial* material) {
+    void refreshUniformsPhong(MaterialUniforms& uniforms, MeshPhongMaterial* material) {
 
-        uniforms.at("specular").value<Color>().copy(material->specular);
-        uniforms.at("shininess").value<float>() = std::max(material->shininess, (float) 1E-4);// to prevent pow( 0.0, 0.0 )
+        uniforms.at(MaterialUniform::Specular).value<Color>().copy(material->specular);
+        uniforms.at(MaterialUniform::Shininess).value<float>() = std::max(material->shininess, (float) 1E-4);// to prevent pow( 0.0, 0.0 )
 
         if (material->emissiveMap) {
 
-            uniforms.at("emissiveMap").setValue(material->emissiveMap.get());
+            uniforms.at(MaterialUniform::EmissiveMap).setValue(material->emissiveMap.get());
         }
 
         if (material->bumpMap) {
 
-            uniforms.at("bumpMap").setValue(material->bumpMap.get());
-            uniforms.at("bumpScale").setValue(material->bumpScale);
+            uniforms.at(MaterialUniform::BumpMap).setValue(material->bumpMap.get());
+            uniforms.at(MaterialUniform::BumpScale).setValue(material->bumpScale);
             if (material->side == Side::Back) {
-                uniforms.at("bumpScale").value<float>() *= -1;
+                uniforms.at(MaterialUniform::BumpScale).value<float>() *= -1;
             }
         }
 
         if (material->normalMap) {
 
-            uniforms.at("normalMap").setValue(material->normalMap.get());
-            uniforms.at("normalScale").value<Vector2>().copy(material->normalScale);
+            uniforms.at(MaterialUniform::NormalMap).setValue(material->normalMap.get());
+            uniforms.at(MaterialUniform::NormalScale).value<Vector2>().copy(material->normalScale);
             if (material->side == Side::Back) {
-                uniforms.at("normalScale").value<Vector2>().negate();
+                uniforms.at(MaterialUniform::NormalScale).value<Vector2>().negate();
             }
         }
 
         if (material->displacementMap) {
 
-            uniforms.at("displacementMap").setValue(material->displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(material->displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
     }
 
-    void refreshUniformsStandard(UniformMap& uniforms, MeshStandardMaterial* material) {
+    void refreshUniformsStandard(MaterialUniforms& uniforms, MeshStandardMaterial* material) {
 
-        uniforms.at("roughness").value<float>() = material->roughness;
-        uniforms.at("metalness").value<float>() = material->metalness;
+        uniforms.at(MaterialUniform::Roughness).value<float>() = material->roughness;
+        uniforms.at(MaterialUniform::Metalness).value<float>() = material->metalness;
 
         if (material->roughnessMap) {
 
-            uniforms.at("roughnessMap").setValue(material->roughnessMap.get());
+            uniforms.at(MaterialUniform::RoughnessMap).setValue(material->roughnessMap.get());
         }
 
         if (material->metalnessMap) {
 
-            uniforms.at("metalnessMap").setValue(material->metalnessMap.get());
+            uniforms.at(MaterialUniform::MetalnessMap).setValue(material->metalnessMap.get());
         }
 
         if (material->emissiveMap) {
 
-            uniforms.at("emissiveMap").setValue(material->emissiveMap.get());
+            uniforms.at(MaterialUniform::EmissiveMap).setValue(material->emissiveMap.get());
         }
 
         if (material->bumpMap) {
 
-            uniforms.at("bumpMap").setValue(material->bumpMap.get());
-            uniforms.at("bumpScale").setValue(material->bumpScale);
+            uniforms.at(MaterialUniform::BumpMap).setValue(material->bumpMap.get());
+            uniforms.at(MaterialUniform::BumpScale).setValue(material->bumpScale);
             if (material->side == Side::Back) {
-                uniforms.at("bumpScale").value<float>() *= -1;
+                uniforms.at(MaterialUniform::BumpScale).value<float>() *= -1;
             }
         }
 
         if (material->normalMap) {
 
-            uniforms.at("normalMap").setValue(material->normalMap.get());
-            uniforms.at("normalScale").value<Vector2>().copy(material->normalScale);
+            uniforms.at(MaterialUniform::NormalMap).setValue(material->normalMap.get());
+            uniforms.at(MaterialUniform::NormalScale).value<Vector2>().copy(material->normalScale);
             if (material->side == Side::Back) {
-                uniforms.at("normalScale").value<Vector2>().negate();
+                uniforms.at(MaterialUniform::NormalScale).value<Vector2>().negate();
             }
         }
 
         if (material->displacementMap) {
 
-            uniforms.at("displacementMap").setValue(material->displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(material->displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
 
         auto envMap = properties.materialProperties.get(material);
         if (envMap) {
 
-            uniforms["envMapIntensity"].value<float>() = material->envMapIntensity;
+            uniforms[MaterialUniform::EnvMapIntensity].value<float>() = material->envMapIntensity;
         }
     }
 
-    void refreshUniformsMatcap(UniformMap& uniforms, MeshMatcapMaterial* material) {
+    void refreshUniformsMatcap(MaterialUniforms& uniforms, MeshMatcapMaterial* material) {
 
         if (material->matcap) {
 
-            uniforms.at("matcap").setValue(material->matcap.get());
+            uniforms.at(MaterialUniform::Matcap).setValue(material->matcap.get());
         }
 
         if (material->bumpMap) {
 
-            uniforms.at("bumpMap").setValue(material->bumpMap.get());
-            uniforms.at("bumpScale").setValue(material->bumpScale);
+            uniforms.at(MaterialUniform::BumpMap).setValue(material->bumpMap.get());
+            uniforms.at(MaterialUniform::BumpScale).setValue(material->bumpScale);
             if (material->side == Side::Back) {
-                uniforms.at("bumpScale").value<float>() *= -1;
+                uniforms.at(MaterialUniform::BumpScale).value<float>() *= -1;
             }
         }
 
         if (material->normalMap) {
 
-            uniforms.at("normalMap").setValue(material->normalMap.get());
-            uniforms.at("normalScale").value<Vector2>().copy(material->normalScale);
+            uniforms.at(MaterialUniform::NormalMap).setValue(material->normalMap.get());
+            uniforms.at(MaterialUniform::NormalScale).value<Vector2>().copy(material->normalScale);
             if (material->side == Side::Back) {
-                uniforms.at("normalScale").value<Vector2>().negate();
+                uniforms.at(MaterialUniform::NormalScale).value<Vector2>().negate();
             }
         }
 
         if (material->displacementMap) {
 
-            uniforms.at("displacementMap").setValue(material->displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(material->displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
     }
 
-    void refreshUniformsDepth(UniformMap& uniforms, MeshDepthMaterial* material) {
+    void refreshUniformsDepth(MaterialUniforms& uniforms, MeshDepthMaterial* material) {
 
         if (material->displacementMap) {
 
-            uniforms.at("displacementMap").setValue(material->displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(material->displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
     }
 
-    void refreshUniformsDistance(UniformMap& uniforms, MeshDistanceMaterial* material) {
+    void refreshUniformsDistance(MaterialUniforms& uniforms, MeshDistanceMaterial* material) {
 
         if (material->displacementMap) {
 
-            uniforms.at("displacementMap").setValue(material->displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(material->displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
 
-        uniforms.at("referencePosition").value<Vector3>().copy(material->referencePosition);
-        uniforms.at("nearDistance").value<float>() = material->nearDistance;
-        uniforms.at("farDistance").value<float>() = material->farDistance;
+        uniforms.at(MaterialUniform::ReferencePosition).value<Vector3>().copy(material->referencePosition);
+        uniforms.at(MaterialUniform::NearDistance).value<float>() = material->nearDistance;
+        uniforms.at(MaterialUniform::FarDistance).value<float>() = material->farDistance;
     }
 
-    void refreshUniformsToon(UniformMap& uniforms, MeshToonMaterial* material) {
+    void refreshUniformsToon(MaterialUniforms& uniforms, MeshToonMaterial* material) {
 
         auto& gradientMap = material->gradientMap;
         if (gradientMap) {
 
-            uniforms.at("gradientMap").setValue(gradientMap.get());
+            uniforms.at(MaterialUniform::GradientMap).setValue(gradientMap.get());
         }
 
         auto& emissiveMap = material->emissiveMap;
         if (emissiveMap) {
 
-            uniforms.at("emissiveMap").setValue(emissiveMap.get());
+            uniforms.at(MaterialUniform::EmissiveMap).setValue(emissiveMap.get());
         }
 
         auto& bumpMap = material->bumpMap;
         if (bumpMap) {
 
-            uniforms.at("bumpMap").setValue(bumpMap.get());
-            uniforms.at("bumpScale").value<float>() = material->bumpScale;
+            uniforms.at(MaterialUniform::BumpMap).setValue(bumpMap.get());
+            uniforms.at(MaterialUniform::BumpScale).value<float>() = material->bumpScale;
             if (material->side == Side::Back) {
-                uniforms.at("bumpScale").value<float>() *= -1;
+                uniforms.at(MaterialUniform::BumpScale).value<float>() *= -1;
             }
         }
 
         auto& normalMap = material->normalMap;
         if (normalMap) {
 
-            uniforms.at("normalMap").setValue(normalMap.get());
-            uniforms.at("normalScale").value<Vector2>().copy(material->normalScale);
+            uniforms.at(MaterialUniform::NormalMap).setValue(normalMap.get());
+            uniforms.at(MaterialUniform::NormalScale).value<Vector2>().copy(material->normalScale);
             if (material->side == Side::Back) {
-                uniforms.at("normalScale").value<Vector2>().negate();
+                uniforms.at(MaterialUniform::NormalScale).value<Vector2>().negate();
             }
         }
 
         auto& displacementMap = material->displacementMap;
         if (displacementMap) {
 
-            uniforms.at("displacementMap").setValue(displacementMap.get());
-            uniforms.at("displacementScale").value<float>() = material->displacementScale;
-            uniforms.at("displacementBias").value<float>() = material->displacementBias;
+            uniforms.at(MaterialUniform::DisplacementMap).setValue(displacementMap.get());
+            uniforms.at(MaterialUniform::DisplacementScale).value<float>() = material->displacementScale;
+            uniforms.at(MaterialUniform::DisplacementBias).value<float>() = material->displacementBias;
         }
     }
 
 
-    void refreshUniformsLine(UniformMap& uniforms, LineBasicMaterial* material) {
+    void refreshUniformsLine(MaterialUniforms& uniforms, LineBasicMaterial* material) {
 
-        uniforms.at("diffuse").value<Color>().copy(material->color);
-        uniforms.at("opacity").value<float>() = material->opacity;
+        uniforms.at(MaterialUniform::Diffuse).value<Color>().copy(material->color);
+        uniforms.at(MaterialUniform::Opacity).value<float>() = material->opacity;
     }
 
-    void refreshUniformsPoints(UniformMap& uniforms, PointsMaterial* material, int pixelRatio, float height) {
+    void refreshUniformsPoints(MaterialUniforms& uniforms, PointsMaterial* material, int pixelRatio, float height) {
 
-        uniforms.at("diffuse").value<Color>().copy(material->color);
-        uniforms.at("opacity").value<float>() = material->opacity;
-        uniforms.at("size").value<float>() = material->size * static_cast<float>(pixelRatio);
-        uniforms.at("scale").value<float>() = height * 0.5f;
+        uniforms.at(MaterialUniform::Diffuse).value<Color>().copy(material->color);
+        uniforms.at(MaterialUniform::Opacity).value<float>() = material->opacity;
+        uniforms.at(MaterialUniform::Size).value<float>() = material->size * static_cast<float>(pixelRatio);
+        uniforms.at(MaterialUniform::Scale).value<float>() = height * 0.5f;
 
         if (material->map) {
 
-            uniforms.at("map").setValue(material->map.get());
+            uniforms.at(MaterialUniform::Map).setValue(material->map.get());
         }
 
         if (material->alphaMap) {
 
-            uniforms.at("alphaMap").setValue(material->alphaMap.get());
+            uniforms.at(MaterialUniform::AlphaMap).setValue(material->alphaMap.get());
         }
 
         // uv repeat and offset setting priorities
@@ -411,23 +411,23 @@ struct GLMaterials::Impl {
                 uvScaleMap->updateMatrix();
             }
 
-            uniforms.at("uvTransform").value<Matrix3>().copy(uvScaleMap->matrix);
+            uniforms.at(MaterialUniform::UvTransform).value<Matrix3>().copy(uvScaleMap->matrix);
         }
     }
 
-    void refreshUniformsSprites(UniformMap& uniforms, SpriteMaterial* material) {
-        uniforms.at("diffuse").value<Color>().copy(material->color);
-        uniforms.at("opacity").value<float>() = material->opacity;
-        uniforms.at("rotation").value<float>() = material->rotation;
+    void refreshUniformsSprites(MaterialUniforms& uniforms, SpriteMaterial* material) {
+        uniforms.at(MaterialUniform::Diffuse).value<Color>().copy(material->color);
+        uniforms.at(MaterialUniform::Opacity).value<float>() = material->opacity;
+        uniforms.at(MaterialUniform::Rotation).value<float>() = material->rotation;
 
         if (material->map) {
 
-            uniforms.at("map").setValue(material->map.get());
+            uniforms.at(MaterialUniform::Map).setValue(material->map.get());
         }
 
         if (material->alphaMap) {
 
-            uniforms.at("alphaMap").setValue(material->alphaMap.get());
+            uniforms.at(MaterialUniform::AlphaMap).setValue(material->alphaMap.get());
         }
 
         // uv repeat and offset setting priorities
@@ -452,29 +452,29 @@ struct GLMaterials::Impl {
                 uvScaleMap->updateMatrix();
             }
 
-            uniforms.at("uvTransform").value<Matrix3>().copy(uvScaleMap->matrix);
+            uniforms.at(MaterialUniform::UvTransform).value<Matrix3>().copy(uvScaleMap->matrix);
         }
     }
 
-    void refreshFogUniforms(UniformMap& uniforms, FogVariant& fog) {
+    void refreshFogUniforms(MaterialUniforms& uniforms, FogVariant& fog) {
 
         if (fog.index() == 0) {
 
             auto& f = std::get<Fog>(fog);
-            uniforms.at("fogColor").value<Color>().copy(f.color);
+            uniforms.at(MaterialUniform::FogColor).value<Color>().copy(f.color);
 
-            uniforms.at("fogNear").value<float>() = f.near;
-            uniforms.at("fogFar").value<float>() = f.far;
+            uniforms.at(MaterialUniform::FogNear).value<float>() = f.near;
+            uniforms.at(MaterialUniform::FogFar).value<float>() = f.far;
         } else {
 
             auto& f = std::get<FogExp2>(fog);
-            uniforms.at("fogColor").value<Color>().copy(f.color);
+            uniforms.at(MaterialUniform::FogColor).value<Color>().copy(f.color);
 
-            uniforms.at("fogDensity").value<float>() = f.density;
+            uniforms.at(MaterialUniform::FogDensity).value<float>() = f.density;
         }
     }
 
-    void refreshMaterialUniforms(UniformMap& uniforms, Material* material, int pixelRatio, int height) {
+    void refreshMaterialUniforms(MaterialUniforms& uniforms, Material* material, int pixelRatio, int height) {
 
         const auto type = material->type();
 
@@ -537,8 +537,8 @@ struct GLMaterials::Impl {
         } else if (type == "ShadowMaterial") {
 
             auto m = material->as<ShadowMaterial>();
-            uniforms.at("color").value<Color>().copy(m->color);
-            uniforms.at("opacity").value<float>() = material->opacity;
+            uniforms.at(MaterialUniform::Color).value<Color>().copy(m->color);
+            uniforms.at(MaterialUniform::Opacity).value<float>() = material->opacity;
 
         } else if (type == "SpriteMaterial") {
 
@@ -554,12 +554,12 @@ struct GLMaterials::Impl {
     }
 };
 
-void GLMaterials::refreshFogUniforms(UniformMap& uniforms, FogVariant& fog) {
+void GLMaterials::refreshFogUniforms(MaterialUniforms& uniforms, FogVariant& fog) {
 
     return pimpl_->refreshFogUniforms(uniforms, fog);
 }
 
-void GLMaterials::refreshMaterialUniforms(UniformMap& uniforms, Material* material, int pixelRatio, int height) {
+void GLMaterials::refreshMaterialUniforms(MaterialUniforms& uniforms, Material* material, int pixelRatio, int height) {
 
     pimpl_->refreshMaterialUniforms(uniforms, material, pixelRatio, height);
 }
@@ -5,7 +5,7 @@
 
 #include "threepp/materials/Material.hpp"
 
-#include "threepp/core/Uniform.hpp"
+#include "threepp/renderers/gl/MaterialUniforms.hpp"
 #include "threepp/scenes/Scene.hpp"
 
 namespace threepp::gl {
@@ -16,9 +16,9 @@ namespace threepp::gl {
 
         explicit GLMaterials(GLProperties& properties);
 
-        void refreshFogUniforms(UniformMap& uniforms, FogVariant& fog);
+        void refreshFogUniforms(MaterialUniforms& uniforms, FogVariant& fog);
 
-        void refreshMaterialUniforms(UniformMap& uniforms, Material* material, int pixelRatio, int height);
+        void refreshMaterialUniforms(MaterialUniforms& uniforms, Material* material, int pixelRatio, int height);
 
         ~GLMaterials();
 
@@ -51,7 +51,7 @@ namespace threepp::gl {
         void update(Object3D* object, BufferGeometry* geometry, Material* material, GLProgram* program) {
 
             std::vector<float> objectInfluences;
-            if (auto objectWithMorphTargetInfluences = dynamic_cast<ObjectWithMorphTargetInfluences*>(object)) {
+            if (auto objectWithMorphTargetInfluences = object->as<ObjectWithMorphTargetInfluences>()) {
                 objectInfluences = objectWithMorphTargetInfluences->morphTargetInfluences();
             }
 
@@ -5,6 +5,9 @@
 #include "threepp/renderers/gl/GLAttributes.hpp"
 #include "threepp/renderers/gl/GLGeometries.hpp"
 #include "threepp/renderers/gl/GLInfo.hpp"
+#include "threepp/renderers/gl/GLSlotMap.hpp"
+
+#include <optional>
 
 #ifndef EMSCRIPTEN
 #include <glad/glad.h>
@@ -30,6 +33,7 @@ struct GLObjects::Impl {
             scope->attributes_.remove(instancedMesh->instanceMatrix());
 
             if (instancedMesh->instanceColor()) scope->attributes_.remove(instancedMesh->instanceColor());
+            for (auto buffer : instancedMesh->visibleInstanceBuffers()) scope->attributes_.remove(buffer);
         }
 
     private:
@@ -42,7 +46,7 @@ struct GLObjects::Impl {
 
     OnInstancedMeshDispose onInstancedMeshDispose;
 
-    std::unordered_map<BufferGeometry*, size_t> updateMap_;
+    GLSlotMap<BufferGeometry, std::optional<size_t>> updateMap_;
 
     Impl(GLGeometries& geometries, GLAttributes& attributes, GLInfo& info)
         : attributes_(attributes),
@@ -58,11 +62,12 @@ struct GLObjects::Impl {
 
         // Update once per frame
 
-        if (!updateMap_.contains(geometry) || updateMap_[geometry] != frame) {
+        auto& updated = updateMap_.get(geometry);
+        if (updated != frame) {
 
             geometries_.update(geometry);
 
-            updateMap_[geometry] = frame;
+            updated = frame;
         }
 
         if (auto instancedMesh = object->as<InstancedMesh>()) {
@@ -72,11 +77,31 @@ struct GLObjects::Impl {
                 object->addEventListener("dispose", onInstancedMeshDispose);
             }
 
-            attributes_.update(instancedMesh->instanceMatrix(), GL_ARRAY_BUFFER);
+            if (instancedMesh->hasVisibilityPipeline()) {
+
+                // the visible instances are uploaded by the renderer, once culled for the camera
+                for (const auto& level : instancedMesh->levels()) {
+
+                    const auto levelGeometry = level.geometry.get();
+                    geometries_.get(object, levelGeometry);
+
+                    auto& levelUpdated = updateMap_.get(levelGeometry);
+                    if (levelUpdated != frame) {
+
+                        geometries_.update(levelGeometry);
+
+                        levelUpdated = frame;
+                    }
+                }
+
+            } else {
+
+                attributes_.update(instancedMesh->instanceMatrix(), GL_ARRAY_BUFFER);
 
-            if (instancedMesh->instanceColor() != nullptr) {
+                if (instancedMesh->instanceColor() != nullptr) {
 
-                attributes_.update(instancedMesh->instanceColor(), GL_ARRAY_BUFFER);
+                    attributes_.update(instancedMesh->instanceColor(), GL_ARRAY_BUFFER);
+                }
             }
         }
 
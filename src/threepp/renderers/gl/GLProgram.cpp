@@ -2,17 +2,21 @@
 #include "threepp/renderers/gl/GLProgram.hpp"
 
 #include "threepp/renderers/gl/GLBindingStates.hpp"
+#include "threepp/renderers/gl/GLCapabilities.hpp"
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
 #include "threepp/renderers/gl/GLPrograms.hpp"
+#include "threepp/renderers/gl/GLUniformBlocks.hpp"
 #include "threepp/renderers/gl/GLUniforms.hpp"
+#include "threepp/renderers/gl/ShaderPreprocessor.hpp"
 
 #include "threepp/renderers/GLRenderer.hpp"
 #include "threepp/renderers/shaders/ShaderChunk.hpp"
-#include "threepp/utils/RegexUtil.hpp"
 #include "threepp/utils/StringUtils.hpp"
 
 #include <cmath>
 #include <iostream>
 #include <list>
+#include <sstream>
 #include <vector>
 
 #ifndef EMSCRIPTEN
@@ -21,6 +25,10 @@
 #include <GLES3/gl32.h>
 #endif
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -62,25 +70,6 @@ namespace {
         }
     }
 
-    std::string loopReplacer(const std::smatch& match) {
-
-        static std::regex reg1(R"(\[\s*i\s*\])");
-        static std::regex reg2("UNROLLED_LOOP_INDEX");
-
-        auto start = utils::parseInt(match[1].str());
-        auto end = utils::parseInt(match[2].str());
-
-        std::stringstream ss;
-        for (int i = start; i < end; ++i) {
-
-            auto str = std::regex_replace(match[3].str(), reg1, "[ " + std::to_string(i) + " ]");
-            utils::replaceAll(str, "UNROLLED_LOOP_INDEX", std::to_string(i));
-            ss << str;
-        }
-
-        return ss.str();
-    }
-
     std::string getTexelDecodingFunction(const std::string& functionName, Encoding encoding) {
 
         const auto components = getEncodingComponents(encoding);
@@ -189,50 +178,6 @@ namespace {
         utils::replaceAll(str, "UNION_CLIPPING_PLANES", std::to_string(parameters->numClippingPlanes - parameters->numClipIntersection));
     }
 
-    // Resolve Includes
-
-    std::string resolveIncludes(const std::string& str) {
-
-        static const std::regex rex("#include +<([\\w\\d.]+)>");
-
-        std::string result;
-
-        std::sregex_iterator rex_it(str.begin(), str.end(), rex);
-        std::sregex_iterator rex_end;
-        size_t pos = 0;
-
-        while (rex_it != rex_end) {
-            std::smatch match = *rex_it;
-            result.append(str, pos, match.position(0) - pos);
-            pos = match.position(0) + match.length(0);
-
-            const std::ssub_match& sub = match[1];
-            const std::string& r = shaders::ShaderChunk::instance().get(sub.str());
-            if (r.empty()) {
-                std::stringstream ss;
-                ss << "unable to resolve #include <" << sub.str() << ">";
-                throw std::logic_error(ss.str());
-            }
-            result.append(r);
-            ++rex_it;
-        }
-
-        if (pos == 0) return str;
-        else {
-            result.append(str, pos, str.length());
-            return result;
-        }
-    }
-
-    // Unroll loops
-
-    std::string unrollLoops(const std::string& glsl) {
-
-        static const std::regex rex(R"(#pragma unroll_loop_start\s+for\s*\(\s*int\s+i\s*=\s*(\d+)\s*;\s*i\s*<\s*(\d+)\s*;\s*i\s*\+\+\s*\)\s*\{([\s\S]+?)\}\s+#pragma unroll_loop_end)");
-
-        return regex_replace(glsl, rex, loopReplacer);
-    }
-
     inline std::string generatePrecision() {
 
         return "precision highp float;\nprecision highp int;\n#define HIGH_PRECISION";
@@ -325,13 +270,43 @@ namespace {
         return envMapBlendingDefine;
     }
 
+    std::string generateCameraUniforms(const ProgramParameters* parameters, bool vertex) {
+
+        if (parameters->uniformBlocks) {
+
+            // must be identical in both stages, std140 layout mirrored by GLUniformBlocks::updateCamera
+            return "layout( std140 ) uniform threeCamera {\n"
+                   "	mat4 projectionMatrix;\n"
+                   "	mat4 viewMatrix;\n"
+                   "	vec3 cameraPosition;\n"
+                   "	bool isOrthographic;\n"
+                   "};";
+        }
+
+        return std::string(vertex ? "uniform mat4 projectionMatrix;\n" : "") +
+               "uniform mat4 viewMatrix;\n"
+               "uniform vec3 cameraPosition;\n"
+               "uniform bool isOrthographic;";
+    }
+
 
 }// namespace
 
 
-GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates)
+GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates, GLProgramBinaryCache* binaryCache, bool asyncLinking)
     : cacheKey(std::move(cacheKey)), bindingStates(bindingStates) {
 
+    this->program = glCreateProgram();
+
+    const auto& binaryCacheDirectory = renderer->programBinaryCacheDirectory;
+    const bool useBinaryCache = binaryCache && !binaryCacheDirectory.empty() && binaryCache->supported();
+
+    if (useBinaryCache && binaryCache->load(binaryCacheDirectory, program, this->cacheKey)) {
+
+        GLUniformBlocks::bindProgram(program);
+        return;
+    }
+
     auto& defines = parameters->defines;
 
     auto vertexShader = parameters->vertexShader;
@@ -346,8 +321,6 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
 
     auto customDefines = generateDefines(defines);
 
-    this->program = glCreateProgram();
-
     std::string prefixVertex, prefixFragment;
 
     if (parameters->isRawShaderMaterial) {
@@ -400,6 +373,7 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
 
                     parameters->instancing ? "#define USE_INSTANCING" : "",
                     parameters->instancingColor ? "#define USE_INSTANCING_COLOR" : "",
+                    parameters->batching ? "#define USE_BATCHING" : "",
 
                     parameters->supportsVertexTextures ? "#define VERTEX_TEXTURES" : "",
 
@@ -437,6 +411,7 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
                     parameters->vertexAlphas ? "#define USE_COLOR_ALPHA" : "",
                     parameters->vertexUvs ? "#define USE_UV" : "",
                     parameters->uvsVertexOnly ? "#define UVS_VERTEX_ONLY" : "",
+                    parameters->octahedralNormals ? "#define USE_OCTAHEDRAL_NORMALS" : "",
 
                     parameters->flatShading ? "#define FLAT_SHADED" : "",
 
@@ -455,13 +430,12 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
 
                     parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
 
+                    parameters->uniformBlocks ? "#define USE_UNIFORM_BLOCKS" : "",
+
                     "uniform mat4 modelMatrix;",
                     "uniform mat4 modelViewMatrix;",
-                    "uniform mat4 projectionMatrix;",
-                    "uniform mat4 viewMatrix;",
                     "uniform mat3 normalMatrix;",
-                    "uniform vec3 cameraPosition;",
-                    "uniform bool isOrthographic;",
+                    generateCameraUniforms(parameters, true),
 
                     "#ifdef USE_INSTANCING",
 
@@ -475,6 +449,12 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
 
                     "#endif",
 
+                    "#ifdef USE_BATCHING",
+
+                    "	attribute float batchId;",
+
+                    "#endif",
+
                     "attribute vec3 position;",
                     "attribute vec3 normal;",
                     "attribute vec2 uv;",
@@ -600,12 +580,13 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
                     parameters->premultipliedAlpha ? "#define PREMULTIPLIED_ALPHA" : "",
 
                     parameters->physicallyCorrectLights ? "#define PHYSICALLY_CORRECT_LIGHTS" : "",
+                    parameters->clusteredLights ? "#define USE_CLUSTERED_LIGHTS" : "",
 
                     parameters->logarithmicDepthBuffer ? "#define USE_LOGDEPTHBUF" : "",
 
-                    "uniform mat4 viewMatrix;",
-                    "uniform vec3 cameraPosition;",
-                    "uniform bool isOrthographic;",
+                    parameters->uniformBlocks ? "#define USE_UNIFORM_BLOCKS" : "",
+
+                    generateCameraUniforms(parameters, false),
 
                     (parameters->toneMapping != ToneMapping::None) ? "#define TONE_MAPPING" : "",
                     (parameters->toneMapping != ToneMapping::None) ? shaders::ShaderChunk::instance().tonemapping_pars_fragment() : "",// this code is required here because it is used by the toneMapping() function defined below
@@ -713,9 +694,52 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
         glBindAttribLocation(program, 0, "position");
     }
 
+    if (useBinaryCache) {
+
+        binaryCache->prepare(program);
+    }
+
     glLinkProgram(program);
 
-    if (renderer->checkShaderErrors) {
+    pendingLink = std::make_unique<PendingLink>(PendingLink{
+            glVertexShader,
+            glFragmentShader,
+            renderer->checkShaderErrors,
+            useBinaryCache ? binaryCache : nullptr,
+            binaryCacheDirectory});
+
+    if (!asyncLinking) {
+
+        finishLink();
+    }
+}
+
+bool GLProgram::isReady() {
+
+    if (!pendingLink) return true;
+
+    if (GLCapabilities::instance().parallelShaderCompile) {
+
+        GLint completed = GL_FALSE;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+
+        if (completed != GL_TRUE) return false;
+    }
+
+    // without the extension the driver may still compile in the background, but querying the result blocks
+
+    finishLink();
+
+    return true;
+}
+
+void GLProgram::finishLink() {
+
+    if (!pendingLink) return;
+
+    const auto link = std::move(pendingLink);
+
+    if (link->checkShaderErrors) {
 
         int length;
         glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
@@ -730,12 +754,21 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
         }
     }
 
-    glDeleteShader(glVertexShader);
-    glDeleteShader(glFragmentShader);
+    glDeleteShader(link->vertexShader);
+    glDeleteShader(link->fragmentShader);
+
+    GLUniformBlocks::bindProgram(program);
+
+    if (link->binaryCache) {
+
+        link->binaryCache->save(link->binaryCacheDirectory, program, this->cacheKey);
+    }
 }
 
 GLUniforms* GLProgram::getUniforms() {
 
+    finishLink();
+
     if (!cachedUniforms) {
         cachedUniforms = std::make_unique<GLUniforms>(program);
     }
@@ -745,6 +778,8 @@ GLUniforms* GLProgram::getUniforms() {
 
 std::unordered_map<std::string, int> GLProgram::getAttributes() {
 
+    finishLink();
+
     if (cachedAttributes.empty()) {
 
         cachedAttributes = fetchAttributeLocations(program);
@@ -755,6 +790,13 @@ std::unordered_map<std::string, int> GLProgram::getAttributes() {
 
 void GLProgram::destroy() {
 
+    if (pendingLink) {
+
+        glDeleteShader(pendingLink->vertexShader);
+        glDeleteShader(pendingLink->fragmentShader);
+        pendingLink.reset();
+    }
+
     bindingStates->releaseStatesOfProgram(*this);
 
     glDeleteProgram(program);
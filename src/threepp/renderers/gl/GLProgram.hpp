@@ -4,8 +4,10 @@
 #define THREEPP_GLPROGRAM_HPP
 
 #include "GLUniforms.hpp"
+#include "ProgramCacheKey.hpp"
 #include "ProgramParameters.hpp"
 
+#include <filesystem>
 #include <memory>
 #include <utility>
 
@@ -16,22 +18,29 @@ namespace threepp {
     namespace gl {
 
         class GLBindingStates;
+        class GLProgramBinaryCache;
 
         struct GLProgram {
 
             std::string name;
             int id = programIdCount++;
+            // the data hashed into key, see GLPrograms::getProgramCacheKey
             std::string cacheKey;
+            ProgramCacheKey key;
             int usedTimes = 1;
             int program = -1;
 
-            GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates);
+            // With asyncLinking, the constructor only issues compile and link commands, see isReady().
+            GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates, GLProgramBinaryCache* binaryCache = nullptr, bool asyncLinking = false);
 
             GLProgram(const GLProgram&) = delete;
             GLProgram(GLProgram&&) = delete;
             GLProgram& operator=(const GLProgram&) = delete;
             GLProgram& operator=(GLProgram&&) = delete;
 
+            // Whether linking has completed. Polls without blocking when GL_KHR_parallel_shader_compile is available.
+            bool isReady();
+
             GLUniforms* getUniforms();
 
             std::unordered_map<std::string, int> getAttributes();
@@ -39,13 +48,26 @@ namespace threepp {
             void destroy();
 
         protected:
+            struct PendingLink {
+
+                unsigned int vertexShader;
+                unsigned int fragmentShader;
+                bool checkShaderErrors;
+                GLProgramBinaryCache* binaryCache;
+                std::filesystem::path binaryCacheDirectory;
+            };
+
             GLBindingStates* bindingStates = nullptr;
+            std::unique_ptr<PendingLink> pendingLink;
             std::unique_ptr<GLUniforms> cachedUniforms;
             std::unordered_map<std::string, int> cachedAttributes;
 
             GLProgram() = default;
 
             inline static int programIdCount{0};
+
+            // checks for errors and releases the shaders, blocks if linking is still in progress
+            void finishLink();
         };
 
     }// namespace gl
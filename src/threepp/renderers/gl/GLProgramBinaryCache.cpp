@@ -0,0 +1,191 @@
+
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
+
+#include "threepp/renderers/gl/ProgramCacheKey.hpp"
+#include "threepp/renderers/shaders/ShaderChunk.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef EMSCRIPTEN
+#include <glad/glad.h>
+#endif
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr uint32_t magic = 0x42503354;// "T3PB"
+    constexpr uint32_t fileVersion = 1;
+    constexpr uint64_t maxBinaryLength = 1ull << 28;
+
+    struct Header {
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t binaryFormat;
+        uint32_t reserved;
+        uint64_t keyLength;
+        uint64_t binaryLength;
+    };
+
+#ifndef EMSCRIPTEN
+    std::string glString(GLenum name) {
+
+        const auto str = glGetString(name);
+
+        return str ? reinterpret_cast<const char*>(str) : "";
+    }
+#endif
+
+}// namespace
+
+
+GLProgramBinaryCache::GLProgramBinaryCache(ProgramInfo& info)
+    : info_(info) {}
+
+bool GLProgramBinaryCache::supported() {
+
+    if (!supported_) {
+
+#ifndef EMSCRIPTEN
+        GLint numFormats = 0;
+        if (glGetProgramBinary && glProgramBinary && glProgramParameteri) {
+
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        }
+
+        supported_ = numFormats > 0;
+
+        if (*supported_) {
+
+            std::stringstream ss;
+            ss << glString(GL_VENDOR) << '\n'
+               << glString(GL_RENDERER) << '\n'
+               << glString(GL_VERSION) << '\n'
+               << shaders::ShaderChunk::instance().fingerprint() << '\n';
+            environment_ = ss.str();
+        }
+#else
+        // WebGL does not expose program binaries
+        supported_ = false;
+#endif
+    }
+
+    return *supported_;
+}
+
+void GLProgramBinaryCache::prepare(unsigned int program) const {
+
+#ifndef EMSCRIPTEN
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+}
+
+bool GLProgramBinaryCache::load(const std::filesystem::path& directory, unsigned int program, const std::string& keyData) {
+
+#ifndef EMSCRIPTEN
+    const auto key = entryKey(keyData);
+
+    std::ifstream in(entryPath(directory, key), std::ios::binary);
+
+    Header header{};
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(Header)) ||
+        header.magic != magic || header.version != fileVersion || header.keyLength != key.size() ||
+        header.binaryLength == 0 || header.binaryLength > maxBinaryLength) {
+
+        ++info_.binaryCacheMisses;
+        return false;
+    }
+
+    std::string storedKey(header.keyLength, '\0');
+    std::vector<char> binary(header.binaryLength);
+    if (!in.read(storedKey.data(), static_cast<std::streamsize>(storedKey.size())) ||
+        !in.read(binary.data(), static_cast<std::streamsize>(binary.size())) ||
+        storedKey != key) {
+
+        ++info_.binaryCacheMisses;
+        return false;
+    }
+
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE) {
+
+        ++info_.binaryCacheRejected;
+        ++info_.binaryCacheMisses;
+        return false;
+    }
+
+    ++info_.binaryCacheHits;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GLProgramBinaryCache::save(const std::filesystem::path& directory, unsigned int program, const std::string& keyData) {
+
+#ifndef EMSCRIPTEN
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+    const auto key = entryKey(keyData);
+    const auto path = entryPath(directory, key);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    // write to a temporary file first, so that a concurrent or interrupted run never sees a partial entry
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+
+            std::cerr << "THREE.GLProgramBinaryCache: Unable to write to " << directory << std::endl;
+            return;
+        }
+
+        const Header header{magic, fileVersion, binaryFormat, 0, key.size(), static_cast<uint64_t>(length)};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        out.write(binary.data(), length);
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) std::filesystem::remove(tmpPath, ec);
+#endif
+}
+
+std::string GLProgramBinaryCache::entryKey(const std::string& keyData) const {
+
+    return environment_ + keyData;
+}
+
+std::filesystem::path GLProgramBinaryCache::entryPath(const std::filesystem::path& directory, const std::string& entryKey) const {
+
+    const auto hash = ProgramCacheKey::fromData(entryKey);
+
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << hash.h0 << std::setw(16) << hash.h1 << ".bin";
+
+    return directory / ss.str();
+}
@@ -0,0 +1,48 @@
+
+#ifndef THREEPP_GLPROGRAMBINARYCACHE_HPP
+#define THREEPP_GLPROGRAMBINARYCACHE_HPP
+
+#include "threepp/renderers/gl/GLInfo.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace threepp::gl {
+
+    // Stores linked program binaries on disk (glGetProgramBinary) so that later runs can skip shader compilation.
+    // Entries are keyed by the program cache key data together with the driver vendor/renderer/version strings and a
+    // fingerprint of the shader library, so a driver or library update simply results in misses.
+    class GLProgramBinaryCache {
+
+    public:
+        explicit GLProgramBinaryCache(ProgramInfo& info);
+
+        // Whether the current context can retrieve and load program binaries.
+        [[nodiscard]] bool supported();
+
+        // Must be called before linking a program that is to be saved.
+        void prepare(unsigned int program) const;
+
+        // Loads the binary stored for keyData into program.
+        // Returns false on a miss or when the driver rejects the binary, in which case program should be linked from source.
+        bool load(const std::filesystem::path& directory, unsigned int program, const std::string& keyData);
+
+        // Stores the binary of a successfully linked program.
+        void save(const std::filesystem::path& directory, unsigned int program, const std::string& keyData);
+
+    private:
+        ProgramInfo& info_;
+
+        std::optional<bool> supported_;
+        // driver strings and shader library fingerprint
+        std::string environment_;
+
+        [[nodiscard]] std::string entryKey(const std::string& keyData) const;
+
+        [[nodiscard]] std::filesystem::path entryPath(const std::filesystem::path& directory, const std::string& entryKey) const;
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLPROGRAMBINARYCACHE_HPP
@@ -3,10 +3,11 @@
 
 #include "threepp/materials/RawShaderMaterial.hpp"
 #include "threepp/renderers/GLRenderer.hpp"
-#include "threepp/utils/StringUtils.hpp"
 
 #include "threepp/renderers/shaders/ShaderLib.hpp"
 
+#include <algorithm>
+
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -32,13 +33,14 @@ namespace {
 }// namespace
 
 
-GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping)
+GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info)
     : logarithmicDepthBuffer(GLCapabilities::instance().logarithmicDepthBuffer),
       floatVertexTextures(GLCapabilities::instance().floatVertexTextures),
       maxVertexUniforms(GLCapabilities::instance().maxVertexUniforms),
       vertexTextures(GLCapabilities::instance().vertexTextures),
       bindingStates(bindingStates),
-      clipping(clipping) {}
+      clipping(clipping),
+      binaryCache(info.programs) {}
 
 
 ProgramParameters GLPrograms::getParameters(
@@ -53,44 +55,17 @@ ProgramParameters GLPrograms::getParameters(
     return {renderer, clipping, lights, numShadows, object, scene, material, shaderIDs};
 }
 
-std::string GLPrograms::getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters) {
-
-    std::vector<std::string> array;
-
-    if (parameters.shaderID) {
-
-        array.emplace_back(*parameters.shaderID);
-
-    } else {
-
-        array.emplace_back(parameters.fragmentShader);
-        array.emplace_back(parameters.vertexShader);
-    }
-
-    if (!parameters.defines.empty()) {
+ProgramCacheKey GLPrograms::getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters, std::string& keyData) {
 
-        for (const auto& [name, value] : parameters.defines) {
-
-            array.emplace_back(name);
-            array.emplace_back(value);
-        }
-    }
+    keyData.clear();
+    parameters.writeKey(keyData);
 
     if (!parameters.isRawShaderMaterial) {
 
-        auto hash = utils::split(parameters.hash(), '\n');
-        for (const auto& value : hash) {
-
-            array.emplace_back(value);
-        }
-
-        array.emplace_back(std::to_string(as_integer(renderer.outputEncoding)));
-        array.emplace_back(std::to_string(renderer.gammaFactor));
+        keyData.append(reinterpret_cast<const char*>(&renderer.gammaFactor), sizeof(float));
     }
 
-    //    array.emplace_back(parameters.customProgramCacheKey);
-
-    return utils::join(array);
+    return ProgramCacheKey::fromData(keyData);
 }
 
 UniformMap* GLPrograms::getUniforms(Material& material) {
@@ -110,26 +85,47 @@ UniformMap* GLPrograms::getUniforms(Material& material) {
     return nullptr;
 }
 
-GLProgram* GLPrograms::acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const std::string& cacheKey) {
+GLProgram* GLPrograms::acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const ProgramCacheKey& key, const std::string& keyData) {
 
     GLProgram* program = nullptr;
 
     // Check if code has been already compiled
-    for (auto& preexistingProgram : programs) {
+    if (const auto it = programsByKey.find(key); it != programsByKey.end()) {
+
+        if (it->second->cacheKey == keyData) {
+
+            program = it->second;
 
-        if (preexistingProgram->cacheKey == cacheKey) {
+        } else {
 
-            program = preexistingProgram.get();
-            ++(program->usedTimes);
+            // hash collision, fall back to comparing the key data of every program
+            for (auto& preexistingProgram : programs) {
 
-            break;
+                if (preexistingProgram->cacheKey == keyData) {
+
+                    program = preexistingProgram.get();
+                    break;
+                }
+            }
         }
     }
 
-    if (!program) {
+    if (program) {
+
+        ++(program->usedTimes);
 
-        programs.emplace_back(std::make_unique<GLProgram>(&renderer, cacheKey, &parameters, &bindingStates));
+    } else {
+
+        programs.emplace_back(std::make_unique<GLProgram>(&renderer, keyData, &parameters, &bindingStates, &binaryCache, asyncLinking));
         program = programs.back().get();
+        program->key = key;
+
+        programsByKey.try_emplace(key, program);
+
+        if (asyncLinking) {
+
+            pending[program->id] = program;
+        }
     }
 
     return program;
@@ -139,6 +135,13 @@ void GLPrograms::releaseProgram(GLProgram* program) {
 
     if (--(program->usedTimes) == 0) {
 
+        pending.erase(program->id);
+
+        if (const auto it = programsByKey.find(program->key); it != programsByKey.end() && it->second == program) {
+
+            programsByKey.erase(it);
+        }
+
         if (const auto it = std::ranges::find_if(programs, [program](auto& p) {
                 return p->id == program->id;
             });
@@ -149,3 +152,15 @@ void GLPrograms::releaseProgram(GLProgram* program) {
         }
     }
 }
+
+void GLPrograms::pollPending() {
+
+    std::erase_if(pending, [](const auto& entry) {
+        return entry.second->isReady();
+    });
+}
+
+bool GLPrograms::isPending(int programId) const {
+
+    return pending.contains(programId);
+}
@@ -7,6 +7,8 @@
 #include "GLClipping.hpp"
 #include "GLLights.hpp"
 #include "GLProgram.hpp"
+#include "GLProgramBinaryCache.hpp"
+#include "ProgramCacheKey.hpp"
 #include "ProgramParameters.hpp"
 
 #include "threepp/core/Object3D.hpp"
@@ -37,12 +39,22 @@ namespace threepp {
             int maxVertexUniforms;
             bool vertexTextures;
 
+            // programs acquired while this is set are linked in the background, see GLProgram::isReady
+            bool asyncLinking = false;
+
         private:
             GLClipping& clipping;
             GLBindingStates& bindingStates;
 
+            std::unordered_map<ProgramCacheKey, GLProgram*, ProgramCacheKey::Hash> programsByKey;
+
+            GLProgramBinaryCache binaryCache;
+
+            // programs created with asyncLinking that have not been seen ready yet, by id
+            std::unordered_map<int, GLProgram*> pending;
+
         public:
-            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping);
+            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info);
 
             static ProgramParameters getParameters(
                     const GLRenderer& renderer,
@@ -53,13 +65,20 @@ namespace threepp {
                     Scene* scene,
                     Object3D* object);
 
-            static std::string getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters);
+            // Writes the state identifying the program into keyData (reusing its storage) and returns its 128-bit hash.
+            static ProgramCacheKey getProgramCacheKey(const GLRenderer& renderer, const ProgramParameters& parameters, std::string& keyData);
 
             static UniformMap* getUniforms(Material& material);
 
-            GLProgram* acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const std::string& cacheKey);
+            GLProgram* acquireProgram(const GLRenderer& renderer, const ProgramParameters& parameters, const ProgramCacheKey& key, const std::string& keyData);
 
             void releaseProgram(GLProgram* program);
+
+            // Polls the programs still linking in the background. Without GL_KHR_parallel_shader_compile this waits for them.
+            void pollPending();
+
+            // Whether the program with the given id is still linking. Released programs are not pending.
+            [[nodiscard]] bool isPending(int programId) const;
         };
 
     }// namespace gl
@@ -5,7 +5,10 @@
 
 #include "threepp/scenes/Scene.hpp"
 
+#include "GLSlotMap.hpp"
 #include "GLUniforms.hpp"
+#include "MaterialUniforms.hpp"
+#include "ProgramCacheKey.hpp"
 #include "threepp/core/Uniform.hpp"
 #include "threepp/materials/Material.hpp"
 #include "threepp/renderers/GLRenderTarget.hpp"
@@ -37,7 +40,7 @@ namespace threepp::gl {
 
         GLProgram* program = nullptr;
         GLProgram* currentProgram = nullptr;
-        std::unordered_map<std::string, GLProgram*> programs{};
+        std::unordered_map<ProgramCacheKey, GLProgram*, ProgramCacheKey::Hash> programs{};
 
         std::optional<FogVariant> fog;
 
@@ -50,16 +53,22 @@ namespace threepp::gl {
 
         std::optional<Encoding> outputEncoding;
         bool instancing{};
+        bool batching{};
+        bool clusteredLights{};
         bool skinning{};
         bool vertexAlphas{};
+        bool octahedralNormals{};
 
         bool needsLights{};
         bool receiveShadow{};
 
         unsigned int lightsStateVersion{};
 
-        std::vector<UniformObject*> uniformsList;
+        std::vector<UniformSlot> uniformsList;
+        // set while currentProgram is still linking, the list is built once it is ready
+        bool uniformsListNeedsUpdate{};
         UniformMap* uniforms;
+        MaterialUniforms materialUniforms;
 
         unsigned int version{};
     };
@@ -69,12 +78,12 @@ namespace threepp::gl {
 
         T* get(E* key) {
 
-            return &properties_[key];
+            return &properties_.get(key);
         }
 
         void remove(E* key) {
 
-            properties_.erase(key);
+            properties_.remove(key);
         }
 
         void dispose() {
@@ -84,7 +93,8 @@ namespace threepp::gl {
 
     private:
         friend class GLProperties;
-        std::unordered_map<E*, T> properties_;
+
+        GLSlotMap<E, T> properties_;
     };
 
     class GLProperties {
@@ -96,17 +106,14 @@ namespace threepp::gl {
 
         void dispose() {
 
-            auto texturePropertiesCopy = textureProperties.properties_;
-            for (auto& [tex, _] : texturePropertiesCopy) {
+            for (auto tex : textureProperties.properties_.keys()) {
                 tex->dispose();
             }
-            auto materialPropertiesCopy = materialProperties.properties_;
-            for (auto& [mat, _] : materialPropertiesCopy) {
+            for (auto mat : materialProperties.properties_.keys()) {
                 mat->dispose();
             }
 
-            auto renderTargetPropertiesCopy = renderTargetProperties.properties_;
-            for (auto& [target, _] : renderTargetPropertiesCopy) {
+            for (auto target : renderTargetProperties.properties_.keys()) {
                 target->dispose();
             }
 
@@ -2,6 +2,10 @@
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
 #include <memory>
 
 using namespace threepp;
@@ -9,39 +13,61 @@ using namespace threepp::gl;
 
 namespace {
 
-    struct {
-
-        bool operator()(const RenderItem* a, const RenderItem* b) {
-            if (a->groupOrder != b->groupOrder) {
-                return a->groupOrder < b->groupOrder;
-            } else if (a->renderOrder != b->renderOrder) {
-                return a->renderOrder < b->renderOrder;
-            } else if (a->program != nullptr && b->program != nullptr && (a->program->id != b->program->id)) {
-                return a->program->id < b->program->id;
-            } else if (a->material->id != b->material->id) {
-                return a->material->id < b->material->id;
-            } else if (a->z != b->z) {
-                return a->z < b->z;
-            } else {
-                return a->id < b->id;
-            }
+    bool painterSortStable(const RenderItem& a, const RenderItem& b) {
+
+        if (a.groupOrder != b.groupOrder) {
+            return a.groupOrder < b.groupOrder;
+        } else if (a.renderOrder != b.renderOrder) {
+            return a.renderOrder < b.renderOrder;
+        } else if (a.program != nullptr && b.program != nullptr && (a.programId != b.programId)) {
+            return a.programId < b.programId;
+        } else if (a.materialId != b.materialId) {
+            return a.materialId < b.materialId;
+        } else if (a.z != b.z) {
+            return a.z < b.z;
+        } else {
+            return a.id < b.id;
+        }
+    }
+
+    bool reversePainterSortStable(const RenderItem& a, const RenderItem& b) {
+
+        if (a.groupOrder != b.groupOrder) {
+            return a.groupOrder < b.groupOrder;
+        } else if (a.renderOrder != b.renderOrder) {
+            return a.renderOrder < b.renderOrder;
+        } else if (a.z != b.z) {
+            return a.z > b.z;
+        } else {
+            return a.id < b.id;
+        }
+    }
+
+    // Maps a float onto an unsigned int with the same ordering (-0 and +0 compare equal, as with operator<).
+    uint32_t sortableBits(float z) {
+
+        if (z == 0) z = 0;
+
+        uint32_t bits;
+        std::memcpy(&bits, &z, sizeof(float));
+
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    struct KeyField {
+
+        uint32_t min = std::numeric_limits<uint32_t>::max();
+        uint32_t max = 0;
+
+        void expand(uint32_t value) {
+            min = std::min(min, value);
+            max = std::max(max, value);
         }
-    } painterSortStable;
-
-    struct {
-        bool operator()(const RenderItem* a, const RenderItem* b) {
-
-            if (a->groupOrder != b->groupOrder) {
-                return a->groupOrder < b->groupOrder;
-            } else if (a->renderOrder != b->renderOrder) {
-                return a->renderOrder < b->renderOrder;
-            } else if (a->z != b->z) {
-                return a->z > b->z;
-            } else {
-                return a->id < b->id;
-            }
+
+        [[nodiscard]] int bits() const {
+            return min > max ? 0 : std::bit_width(max - min);
         }
-    } reversePainterSortStable;
+    };
 
 }// namespace
 
@@ -55,48 +81,48 @@ void gl::GLRenderList::init() {
     transparent.clear();
 }
 
-gl::RenderItem* gl::GLRenderList::getNextRenderItem(
+unsigned int gl::GLRenderList::getNextRenderItem(
         Object3D* object,
         BufferGeometry* geometry,
         Material* material,
         unsigned int groupOrder, float z, std::optional<GeometryGroup> group) {
 
-    gl::RenderItem* renderItem = nullptr;
     auto materialProperties = properties.materialProperties.get(material);
 
     if (renderItemsIndex >= renderItems.size()) {
-        auto r = std::make_unique<RenderItem>(RenderItem{object->id,
-                                                         object,
-                                                         geometry,
-                                                         material,
-                                                         materialProperties->program,
-                                                         groupOrder,
-                                                         object->renderOrder,
-                                                         z,
-                                                         group});
-        renderItems.emplace_back(std::move(r));
-        renderItem = renderItems.back().get();
+
+        renderItems.emplace_back(RenderItem{object->id,
+                                            object,
+                                            geometry,
+                                            material,
+                                            materialProperties->program,
+                                            groupOrder,
+                                            object->renderOrder,
+                                            z,
+                                            group});
 
     } else {
 
-        renderItem = renderItems.at(renderItemsIndex).get();
+        auto& renderItem = renderItems[renderItemsIndex];
 
-        renderItem->id = object->id;
-        renderItem->object = object;
-        renderItem->geometry = geometry;
-        renderItem->material = material;
+        renderItem.id = object->id;
+        renderItem.object = object;
+        renderItem.geometry = geometry;
+        renderItem.material = material;
         if (materialProperties->program) {
-            renderItem->program = materialProperties->program;
+            renderItem.program = materialProperties->program;
         }
-        renderItem->groupOrder = groupOrder;
-        renderItem->renderOrder = object->renderOrder;
-        renderItem->z = z;
-        renderItem->group = group;
+        renderItem.groupOrder = groupOrder;
+        renderItem.renderOrder = object->renderOrder;
+        renderItem.z = z;
+        renderItem.group = group;
     }
 
-    ++renderItemsIndex;
+    auto& renderItem = renderItems[renderItemsIndex];
+    renderItem.materialId = material->id;
+    renderItem.programId = renderItem.program ? renderItem.program->id : 0;
 
-    return renderItem;
+    return static_cast<unsigned int>(renderItemsIndex++);
 }
 
 void gl::GLRenderList::push(
@@ -137,8 +163,156 @@ void GLRenderList::unshift(
 
 void GLRenderList::sort() {
 
-    if (opaque.size() > 1) std::stable_sort(opaque.begin(), opaque.end(), painterSortStable);
-    if (transparent.size() > 1) std::stable_sort(transparent.begin(), transparent.end(), reversePainterSortStable);
+    if (opaque.size() > 1) sortOpaque();
+    if (transparent.size() > 1) sortTransparent();
+}
+
+void GLRenderList::sortOpaque() {
+
+    // key layout (most to least significant): groupOrder, renderOrder, program id, material id, depth.
+    // Each id field only gets as many bits as its range in this list requires.
+
+    KeyField groupOrder, renderOrder, programId, materialId;
+    size_t numPrograms = 0;
+
+    for (auto index : opaque) {
+
+        const auto& item = renderItems[index];
+        groupOrder.expand(item.groupOrder);
+        renderOrder.expand(item.renderOrder);
+        materialId.expand(item.materialId);
+        if (item.program) {
+            programId.expand(static_cast<uint32_t>(item.programId));
+            ++numPrograms;
+        }
+    }
+
+    // program ids are only compared when both items have a program
+    const bool mixedPrograms = numPrograms != 0 && numPrograms != opaque.size();
+    const int gBits = groupOrder.bits(), rBits = renderOrder.bits(), pBits = programId.bits(), mBits = materialId.bits();
+
+    if (mixedPrograms || gBits + rBits + pBits + mBits > 32) {
+
+        std::stable_sort(opaque.begin(), opaque.end(), [this](unsigned int a, unsigned int b) {
+            return painterSortStable(renderItems[a], renderItems[b]);
+        });
+        return;
+    }
+
+    sortEntries_.resize(opaque.size());
+    for (size_t i = 0; i < opaque.size(); ++i) {
+
+        const auto& item = renderItems[opaque[i]];
+
+        uint64_t key = item.groupOrder - groupOrder.min;
+        key = (key << rBits) | (item.renderOrder - renderOrder.min);
+        key = (key << pBits) | (numPrograms ? static_cast<uint32_t>(item.programId) - programId.min : 0);
+        key = (key << mBits) | (item.materialId - materialId.min);
+        key = (key << 32) | sortableBits(item.z);
+
+        sortEntries_[i] = {key, opaque[i]};
+    }
+
+    radixSort();
+
+    for (size_t i = 0; i < opaque.size(); ++i) {
+        opaque[i] = sortEntries_[i].index;
+    }
+}
+
+void GLRenderList::sortTransparent() {
+
+    // key layout (most to least significant): groupOrder, renderOrder, inverted depth (back to front).
+
+    KeyField groupOrder, renderOrder;
+
+    for (auto index : transparent) {
+
+        const auto& item = renderItems[index];
+        groupOrder.expand(item.groupOrder);
+        renderOrder.expand(item.renderOrder);
+    }
+
+    const int gBits = groupOrder.bits(), rBits = renderOrder.bits();
+
+    if (gBits + rBits > 32) {
+
+        std::stable_sort(transparent.begin(), transparent.end(), [this](unsigned int a, unsigned int b) {
+            return reversePainterSortStable(renderItems[a], renderItems[b]);
+        });
+        return;
+    }
+
+    sortEntries_.resize(transparent.size());
+    for (size_t i = 0; i < transparent.size(); ++i) {
+
+        const auto& item = renderItems[transparent[i]];
+
+        uint64_t key = item.groupOrder - groupOrder.min;
+        key = (key << rBits) | (item.renderOrder - renderOrder.min);
+        key = (key << 32) | ~sortableBits(item.z);
+
+        sortEntries_[i] = {key, transparent[i]};
+    }
+
+    radixSort();
+
+    for (size_t i = 0; i < transparent.size(); ++i) {
+        transparent[i] = sortEntries_[i].index;
+    }
+}
+
+void GLRenderList::radixSort() {
+
+    // stable LSD radix sort on the 64-bit keys, one byte per pass
+
+    const auto n = sortEntries_.size();
+    sortScratch_.resize(n);
+
+    std::array<std::array<size_t, 256>, 8> histograms{};
+    for (const auto& entry : sortEntries_) {
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    for (int pass = 0; pass < 8; ++pass) {
+
+        auto& histogram = histograms[pass];
+        const auto shift = pass * 8;
+
+        // every key shares this byte, nothing to do
+        if (histogram[(sortEntries_.front().key >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (auto& count : histogram) {
+            const auto c = count;
+            count = offset;
+            offset += c;
+        }
+
+        for (const auto& entry : sortEntries_) {
+            sortScratch_[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+
+        sortEntries_.swap(sortScratch_);
+    }
+
+    // equal keys fall back to ordering by object id, preserving insertion order among equal ids
+
+    for (size_t begin = 0; begin < n;) {
+
+        size_t end = begin + 1;
+        while (end < n && sortEntries_[end].key == sortEntries_[begin].key) ++end;
+
+        if (end - begin > 1) {
+            std::stable_sort(sortEntries_.begin() + static_cast<std::ptrdiff_t>(begin), sortEntries_.begin() + static_cast<std::ptrdiff_t>(end), [this](const SortEntry& a, const SortEntry& b) {
+                return renderItems[a.index].id < renderItems[b.index].id;
+            });
+        }
+
+        begin = end;
+    }
 }
 
 void GLRenderList::finish() {
@@ -147,16 +321,16 @@ void GLRenderList::finish() {
 
     for (auto i = renderItemsIndex, il = renderItems.size(); i < il; ++i) {
 
-        auto& renderItem = renderItems.at(i);
+        auto& renderItem = renderItems[i];
 
-        if (!renderItem->id) break;
+        if (!renderItem.id) break;
 
-        renderItem->id = std::nullopt;
-        renderItem->object = nullptr;
-        renderItem->geometry = nullptr;
-        renderItem->material = nullptr;
-        renderItem->program = nullptr;
-        renderItem->group = std::nullopt;
+        renderItem.id = std::nullopt;
+        renderItem.object = nullptr;
+        renderItem.geometry = nullptr;
+        renderItem.material = nullptr;
+        renderItem.program = nullptr;
+        renderItem.group = std::nullopt;
     }
 }
 
@@ -164,14 +338,14 @@ GLRenderLists::GLRenderLists(GLProperties& properties): properties(properties) {
 
 GLRenderList* GLRenderLists::get(Object3D* scene, size_t renderCallDepth) {
 
-    if (!lists.contains(scene->uuid)) {
+    if (!lists.contains(scene->uuid())) {
 
-        auto& l = lists[scene->uuid].emplace_back(std::make_unique<GLRenderList>(properties));
+        auto& l = lists[scene->uuid()].emplace_back(std::make_unique<GLRenderList>(properties));
         return l.get();
 
     } else {
 
-        auto& l = lists.at(scene->uuid);
+        auto& l = lists.at(scene->uuid());
         if (renderCallDepth >= l.size()) {
 
             l.emplace_back(std::make_unique<GLRenderList>(properties));
@@ -10,6 +10,8 @@
 #include "GLProgram.hpp"
 #include "GLProperties.hpp"
 
+#include <cstdint>
+
 namespace threepp::gl {
 
     struct RenderItem {
@@ -23,21 +25,27 @@ namespace threepp::gl {
         unsigned int renderOrder;
         float z;
         std::optional<GeometryGroup> group;
+
+        // copies of the ids used for sorting, so that sorting does not chase pointers
+        unsigned int materialId;
+        int programId;
     };
 
     struct GLRenderList {
 
-        std::vector<RenderItem*> opaque;
-        std::vector<RenderItem*> transparent;
+        // indices into renderItems, in draw order once sort() has been called
+        std::vector<unsigned int> opaque;
+        std::vector<unsigned int> transparent;
 
-        std::vector<std::unique_ptr<RenderItem>> renderItems;
+        // render items are stored contiguously and reused between frames
+        std::vector<RenderItem> renderItems;
         size_t renderItemsIndex = 0;
 
         explicit GLRenderList(GLProperties& properties);
 
         void init();
 
-        RenderItem* getNextRenderItem(
+        unsigned int getNextRenderItem(
                 Object3D* object,
                 BufferGeometry* geometry,
                 Material* material,
@@ -55,12 +63,32 @@ namespace threepp::gl {
                 Material* material,
                 unsigned int groupOrder, float z, std::optional<GeometryGroup> group);
 
+        [[nodiscard]] const RenderItem& get(unsigned int index) const {
+
+            return renderItems[index];
+        }
+
         void sort();
 
         void finish();
 
     private:
         GLProperties& properties;
+
+        struct SortEntry {
+
+            uint64_t key;
+            unsigned int index;
+        };
+
+        std::vector<SortEntry> sortEntries_;
+        std::vector<SortEntry> sortScratch_;
+
+        void sortOpaque();
+
+        void sortTransparent();
+
+        void radixSort();
     };
 
     struct GLRenderLists {
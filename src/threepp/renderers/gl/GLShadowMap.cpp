@@ -11,6 +11,7 @@
 #include "threepp/materials/MeshDistanceMaterial.hpp"
 #include "threepp/materials/ShaderMaterial.hpp"
 
+#include "threepp/lights/DirectionalLightShadow.hpp"
 #include "threepp/lights/PointLight.hpp"
 #include "threepp/lights/PointLightShadow.hpp"
 
@@ -21,9 +22,12 @@
 
 #include "threepp/renderers/gl/GLCapabilities.hpp"
 #include "threepp/renderers/gl/GLObjects.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
+#include "threepp/renderers/gl/GLUtils.hpp"
 
-
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
 
 using namespace threepp;
@@ -36,6 +40,118 @@ namespace {
             {Side::Back, Side::Front},
             {Side::Double, Side::Double}};
 
+    enum class Casters {
+        All,
+        Static,
+        Dynamic
+    };
+
+    // Whether object and all of its ancestors are visible.
+    bool isVisible(const Object3D* object) {
+
+        for (; object; object = object->parent) {
+
+            if (!object->visible) return false;
+        }
+
+        return true;
+    }
+
+    // What the depth of a static caster depends on, as last drawn into LightShadow::staticMap.
+    struct StaticCaster {
+
+        struct MaterialState {
+
+            const Material* material;
+            unsigned int version;
+            bool visible;
+
+            bool operator==(const MaterialState&) const = default;
+        };
+
+        Object3D* object;
+        Matrix4 matrixWorld;
+        unsigned int layers{};
+        bool frustumCulled{};
+        // checked here rather than relying on updateMatrixWorld, which TransformHierarchy may skip
+        bool visible{};
+        bool castShadow{};
+        bool receiveShadow{};
+
+        BufferGeometry* geometry{};
+        unsigned int attributesVersion{};
+        unsigned int positionVersion{};
+
+        std::vector<MaterialState> materials;
+
+        explicit StaticCaster(Object3D* object): object(object) {
+
+            update();
+        }
+
+        // Whether anything changed since the last call.
+        bool update() {
+
+            const auto geometry = object->geometry().get();
+            const auto position = geometry ? geometry->getAttribute("position") : nullptr;
+            const auto attributesVersion = geometry ? geometry->attributesVersion() : 0;
+            const auto positionVersion = position ? position->version : 0;
+            const auto& objectMaterials = object->as<ObjectWithMaterials>()->materials();
+
+            const auto stateOf = [](const Material* material) {
+                return material ? MaterialState{material, material->version(), material->visible} : MaterialState{};
+            };
+
+            const auto visible = isVisible(object);
+
+            bool changed = !this->matrixWorld.equals(object->matrixWorld) ||
+                           this->layers != object->layers.mask() ||
+                           this->frustumCulled != object->frustumCulled ||
+                           this->visible != visible ||
+                           this->castShadow != object->castShadow ||
+                           this->receiveShadow != object->receiveShadow ||
+                           this->geometry != geometry ||
+                           this->attributesVersion != attributesVersion ||
+                           this->positionVersion != positionVersion ||
+                           this->materials.size() != objectMaterials.size();
+
+            for (size_t i = 0; !changed && i < objectMaterials.size(); i++) {
+
+                changed = this->materials[i] != stateOf(objectMaterials[i].get());
+            }
+
+            if (!changed) return false;
+
+            this->matrixWorld.copy(object->matrixWorld);
+            this->layers = object->layers.mask();
+            this->frustumCulled = object->frustumCulled;
+            this->visible = visible;
+            this->castShadow = object->castShadow;
+            this->receiveShadow = object->receiveShadow;
+            this->geometry = geometry;
+            this->attributesVersion = attributesVersion;
+            this->positionVersion = positionVersion;
+
+            this->materials.clear();
+            for (const auto& material : objectMaterials) this->materials.emplace_back(stateOf(material.get()));
+
+            return true;
+        }
+    };
+
+    // The static casters of a scene, and the views they were drawn with.
+    struct StaticCasters {
+
+        const Object3D* scene = nullptr;
+        unsigned int sceneVersion = 0;
+        unsigned int cameraLayers = 0;
+
+        std::vector<StaticCaster> casters;
+        std::vector<Matrix4> views;// per viewport, projection times view
+        Vector2 mapSize;
+
+        bool drawn = false;
+    };
 
 }// namespace
 
@@ -43,6 +159,7 @@ struct GLShadowMap::Impl {
 
     GLShadowMap* scope;
     GLObjects& _objects;
+    GLProperties& _properties;
 
     const Frustum* _frustum;
 
@@ -60,9 +177,13 @@ struct GLShadowMap::Impl {
 
     std::shared_ptr<Mesh> fullScreenMesh;
 
-    Impl(GLShadowMap* scope, GLObjects& objects)
+    // The static casters last drawn into LightShadow::staticMap, collected again only when Object3D::staticShadowVersion changes.
+    std::unordered_map<const LightShadow*, StaticCasters> _staticCasters;
+
+    Impl(GLShadowMap* scope, GLObjects& objects, GLProperties& properties)
         : scope(scope),
           _objects(objects),
+          _properties(properties),
           _frustum(nullptr),
           _maxTextureSize(GLCapabilities::instance().maxTextureSize) {
 
@@ -78,7 +199,7 @@ struct GLShadowMap::Impl {
         // vertical pass
 
         shadowMaterialVertical->uniforms.at("shadow_pass").setValue(shadow->map->texture.get());
-        shadowMaterialVertical->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize);
+        shadowMaterialVertical->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize).multiply(shadow->getFrameExtents());
         shadowMaterialVertical->uniforms.at("radius").value<float>() = shadow->radius;
         _renderer.setRenderTarget(shadow->mapPass.get());
         _renderer.clear();
@@ -87,7 +208,7 @@ struct GLShadowMap::Impl {
         // horizontal pass
 
         shadowMaterialHorizontal->uniforms.at("shadow_pass").setValue(shadow->mapPass->texture.get());
-        shadowMaterialHorizontal->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize);
+        shadowMaterialHorizontal->uniforms.at("resolution").value<Vector2>().copy(shadow->mapSize).multiply(shadow->getFrameExtents());
         shadowMaterialHorizontal->uniforms.at("radius").value<float>() = shadow->radius;
         _renderer.setRenderTarget(shadow->map.get());
         _renderer.clear();
@@ -129,7 +250,7 @@ struct GLShadowMap::Impl {
 
         Material* result;
 
-        if (light->type() == "PointLight") {
+        if (light->is<PointLight>()) {
 
             result = getDistanceMaterialVariant(false);
 
@@ -186,9 +307,9 @@ struct GLShadowMap::Impl {
             resultWithLineWidth->linewidth = materialWithLineWidth->linewidth;
         }
 
-        if (light->type() == "PointLight") {
+        if (light->is<PointLight>()) {
             if (auto distanceMaterial = material->as<MeshDistanceMaterial>()) {
-                distanceMaterial->referencePosition.setFromMatrixPosition(*light->matrixWorld);
+                distanceMaterial->referencePosition.setFromMatrixPosition(light->matrixWorld);
                 distanceMaterial->nearDistance = shadowCameraNear;
                 distanceMaterial->farDistance = shadowCameraFar;
             }
@@ -197,51 +318,174 @@ struct GLShadowMap::Impl {
         return result;
     }
 
-    void renderObject(GLRenderer& _renderer, Object3D* object, Camera* camera, Camera* shadowCamera, Light* light) {
+    bool isCaster(Object3D* object, Camera* camera) const {
 
-        if (!object->visible) return;
+        if (!object->layers.test(camera->layers)) return false;
+        if (!object->is<Mesh>() && !object->is<Line>() && !object->is<Points>()) return false;
+
+        return (object->castShadow || (object->receiveShadow && scope->type == ShadowMap::VSM)) && (!object->frustumCulled || _frustum->intersectsObject(*object));
+    }
+
+    // Hidden casters are collected too, so that showing them again only needs StaticCaster::update.
+    void collectStaticCasters(Object3D* object, std::vector<StaticCaster>& casters) const {
 
-        bool visible = object->layers.test(camera->layers);
+        if (object->staticShadow && (object->is<Mesh>() || object->is<Line>() || object->is<Points>())) {
 
-        if (visible && (object->is<Mesh>() || object->is<Line>() || object->is<Points>())) {
+            casters.emplace_back(object);
+        }
+
+        for (auto& child : object->children) {
 
-            if ((object->castShadow || (object->receiveShadow && scope->type == ShadowMap::VSM)) && (!object->frustumCulled || _frustum->intersectsObject(*object))) {
+            collectStaticCasters(child, casters);
+        }
+    }
 
-                object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, *object->matrixWorld);
+    // Whether the static casters of shadow need to be drawn again, collecting them first if the scene changed.
+    bool updateStaticCasters(LightShadow& shadow, Object3D* scene, Camera* camera, Light* light) {
 
-                const auto geometry = _objects.update(object);
-                const auto material = object->as<ObjectWithMaterials>()->materials();
+        auto& cache = _staticCasters[&shadow];
+        bool changed = !cache.drawn;
 
-                if (material.size() > 1) {
+        const auto noLongerStatic = std::ranges::any_of(cache.casters, [](const StaticCaster& caster) { return !caster.object->staticShadow; });
 
-                    const auto& groups = geometry->groups;
+        if (cache.scene != scene || cache.sceneVersion != Object3D::staticShadowVersion() || noLongerStatic) {
 
-                    for (const auto& group : groups) {
+            cache.scene = scene;
+            cache.sceneVersion = Object3D::staticShadowVersion();
+            cache.casters.clear();
 
-                        if (material.size() > group.materialIndex) {
-                            const auto groupMaterial = material[group.materialIndex].get();
+            collectStaticCasters(scene, cache.casters);
+            changed = true;
 
-                            if (groupMaterial && groupMaterial->visible) {
+        } else {
 
-                                const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, groupMaterial, light, shadowCamera->near, shadowCamera->far);
+            for (auto& caster : cache.casters) {
 
-                                _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, group);
-                            }
-                        }
-                    }
+                // no short circuit, every caster is brought up to date
+                changed |= caster.update();
+            }
+        }
+
+        if (cache.cameraLayers != camera->layers.mask() || !cache.mapSize.equals(shadow.mapSize)) {
+
+            cache.cameraLayers = camera->layers.mask();
+            cache.mapSize.copy(shadow.mapSize);
+            changed = true;
+        }
+
+        cache.views.resize(shadow.getViewportCount());
+        for (unsigned vp = 0; vp < shadow.getViewportCount(); vp++) {
+
+            updateMatrices(shadow, *light, *camera, vp);
+
+            Matrix4 view;
+            view.multiplyMatrices(shadow.camera->projectionMatrix, shadow.camera->matrixWorldInverse);
+
+            if (!cache.views[vp].equals(view)) {
+
+                cache.views[vp].copy(view);
+                changed = true;
+            }
+        }
+
+        return changed;
+    }
+
+    void renderCaster(GLRenderer& _renderer, Object3D* object, Camera* camera, Camera* shadowCamera, Light* light) {
+
+        if (!isCaster(object, camera)) return;
 
-                } else if (material.front()->visible) {
+        object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, object->matrixWorld);
 
-                    const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, material.front().get(), light, shadowCamera->near, shadowCamera->far);
+        const auto geometry = _objects.update(object);
+        const auto material = object->as<ObjectWithMaterials>()->materials();
 
-                    _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, std::nullopt);
+        if (material.size() > 1) {
+
+            const auto& groups = geometry->groups;
+
+            for (const auto& group : groups) {
+
+                if (material.size() > group.materialIndex) {
+                    const auto groupMaterial = material[group.materialIndex].get();
+
+                    if (groupMaterial && groupMaterial->visible) {
+
+                        const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, groupMaterial, light, shadowCamera->near, shadowCamera->far);
+
+                        _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, group);
+                    }
                 }
             }
+
+        } else if (material.front()->visible) {
+
+            const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, material.front().get(), light, shadowCamera->near, shadowCamera->far);
+
+            _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, std::nullopt);
+        }
+    }
+
+    void renderObject(GLRenderer& _renderer, Object3D* object, Camera* camera, Camera* shadowCamera, Light* light, Casters casters) {
+
+        if (!object->visible) return;
+
+        bool included = casters == Casters::All || object->staticShadow == (casters == Casters::Static);
+
+        if (included) {
+
+            renderCaster(_renderer, object, camera, shadowCamera, light);
         }
 
         for (auto& child : object->children) {
 
-            renderObject(_renderer, child, camera, shadowCamera, light);
+            renderObject(_renderer, child, camera, shadowCamera, light, casters);
+        }
+    }
+
+    void updateMatrices(LightShadow& shadow, Light& light, Camera& camera, unsigned vp) {
+
+        auto directionalShadow = dynamic_cast<DirectionalLightShadow*>(&shadow);
+
+        if (auto pointLightShadow = dynamic_cast<PointLightShadow*>(&shadow)) {
+            pointLightShadow->updateMatrices(*light.as<PointLight>(), vp);
+        } else if (directionalShadow && directionalShadow->cascades() > 1) {
+            directionalShadow->updateCascade(light, camera, vp);
+        } else {
+            shadow.updateMatrices(light);
+        }
+
+        _frustum = &shadow.getFrustum();
+    }
+
+    // Draws the casters of scene, or only the given static casters when casters is Casters::Static.
+    void renderViewports(GLRenderer& _renderer, LightShadow& shadow, Object3D* scene, Camera* camera, Light* light, Casters casters, const std::vector<StaticCaster>* staticCasters = nullptr) {
+
+        for (unsigned vp = 0; vp < shadow.getViewportCount(); vp++) {
+
+            const auto& viewport = shadow.getViewport(vp);
+
+            _viewport.set(
+                    _viewportSize.x * viewport.x,
+                    _viewportSize.y * viewport.y,
+                    _viewportSize.x * viewport.z,
+                    _viewportSize.y * viewport.w);
+
+            _renderer.state().viewport(_viewport);
+
+            updateMatrices(shadow, *light, *camera, vp);
+
+            if (staticCasters) {
+
+                for (const auto& caster : *staticCasters) {
+
+                    if (caster.visible) renderCaster(_renderer, caster.object, camera, shadow.camera.get(), light);
+                }
+
+            } else {
+
+                renderObject(_renderer, scene, camera, shadow.camera.get(), light, casters);
+            }
         }
     }
 
@@ -333,32 +577,78 @@ struct GLShadowMap::Impl {
                 shadow->camera->updateProjectionMatrix();
             }
 
-            _renderer.setRenderTarget(shadow->map.get());
-            _renderer.clear();
+            bool staticChanged = false;
+            const std::vector<StaticCaster>* staticCasters = nullptr;
+
+            // cascades follow the view camera, so their views change almost every frame
+            const auto directionalShadow = std::dynamic_pointer_cast<DirectionalLightShadow>(shadow);
+            const bool cascaded = directionalShadow && directionalShadow->cascades() > 1;
+
+            if (shadow->cacheStaticCasters && !cascaded) {
+
+                staticChanged = updateStaticCasters(*shadow, scene, camera, light);
+                staticCasters = &_staticCasters[shadow.get()].casters;
+
+            } else {
+
+                _staticCasters.erase(shadow.get());
+            }
+
+            if (staticCasters && !staticCasters->empty()) {
+
+                auto& map = *shadow->map;
+
+                if (!shadow->staticMap || shadow->staticMap->width != map.width || shadow->staticMap->height != map.height) {
+
+                    if (shadow->staticMap) shadow->staticMap->dispose();
+
+                    GLRenderTarget::Options pars{};
+                    pars.minFilter = map.texture->minFilter;
+                    pars.magFilter = map.texture->magFilter;
+                    pars.format = map.texture->format;
+
+                    shadow->staticMap = GLRenderTarget::create(map.width, map.height, pars);
+                    shadow->staticMap->texture->name = light->name + ".staticShadowMap";
+
+                    staticChanged = true;
+                }
+
+                if (staticChanged) {
+
+                    _renderer.setRenderTarget(shadow->staticMap.get());
+                    _renderer.clear();
+
+                    renderViewports(_renderer, *shadow, scene, camera, light, Casters::Static, staticCasters);
+
+                    _staticCasters[shadow.get()].drawn = true;
+                }
+
+                _renderer.setRenderTarget(&map);
+
+                // start from the cached static depth, then add the moving casters on top
 
-            const auto viewportCount = shadow->getViewportCount();
+                const auto staticFramebuffer = *_properties.renderTargetProperties.get(shadow->staticMap.get())->glFramebuffer;
+                const auto framebuffer = *_properties.renderTargetProperties.get(&map)->glFramebuffer;
+                const auto width = static_cast<GLint>(map.width), height = static_cast<GLint>(map.height);
 
-            for (unsigned vp = 0; vp < viewportCount; vp++) {
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFramebuffer);
+                glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
 
-                const auto& viewport = shadow->getViewport(vp);
+                renderViewports(_renderer, *shadow, scene, camera, light, Casters::Dynamic);
 
-                _viewport.set(
-                        _viewportSize.x * viewport.x,
-                        _viewportSize.y * viewport.y,
-                        _viewportSize.x * viewport.z,
-                        _viewportSize.y * viewport.w);
+            } else {
 
-                _state.viewport(_viewport);
+                if (shadow->staticMap) {
 
-                if (auto pointLightShadow = std::dynamic_pointer_cast<PointLightShadow>(shadow)) {
-                    pointLightShadow->updateMatrices(*light->as<PointLight>(), vp);
-                } else {
-                    shadow->updateMatrices(*light);
+                    shadow->staticMap->dispose();
+                    shadow->staticMap.reset();
                 }
 
-                _frustum = &shadow->getFrustum();
+                _renderer.setRenderTarget(shadow->map.get());
+                _renderer.clear();
 
-                renderObject(_renderer, scene, camera, shadow->camera.get(), light);
+                renderViewports(_renderer, *shadow, scene, camera, light, Casters::All);
             }
 
             // do blur pass for VSM
@@ -407,8 +697,8 @@ private:
     std::shared_ptr<ShaderMaterial> shadowMaterialHorizontal = createShadowMaterialHorizontal();
 };
 
-GLShadowMap::GLShadowMap(GLObjects& objects)
-    : type(ShadowMap::PFC), pimpl_(std::make_unique<Impl>(this, objects)) {}
+GLShadowMap::GLShadowMap(GLObjects& objects, GLProperties& properties)
+    : type(ShadowMap::PFC), pimpl_(std::make_unique<Impl>(this, objects, properties)) {}
 
 
 void GLShadowMap::render(GLRenderer& renderer, const std::vector<Light*>& lights, Object3D* scene, Camera* camera) {
@@ -0,0 +1,212 @@
+
+#ifndef THREEPP_GLSLOTMAP_HPP
+#define THREEPP_GLSLOTMAP_HPP
+
+#include "threepp/core/misc.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace threepp::gl {
+
+    // Table ids are handed out per key type and reused once a table is destroyed, so every live table
+    // (of any renderer) has its own handle entry on the object, and the handle lists stay short.
+    template<class K>
+    class SlotMapIds {
+
+    public:
+        static unsigned int acquire() {
+
+            std::lock_guard lock(mutex_);
+
+            if (free_.empty()) return next_++;
+
+            const auto id = free_.back();
+            free_.pop_back();
+
+            return id;
+        }
+
+        static void release(unsigned int id) {
+
+            std::lock_guard lock(mutex_);
+
+            free_.emplace_back(id);
+        }
+
+    private:
+        inline static std::mutex mutex_;
+        inline static unsigned int next_ = 0;
+        inline static std::vector<unsigned int> free_;
+    };
+
+    // Per object renderer state, stored in slots that are found through the RendererHandle cached on the object.
+    // A handle is trusted only when its slot still holds the same object with the same generation, otherwise
+    // (first use, a recycled slot or table id) the object is looked up by pointer and its handle refreshed.
+    // Values never move, so references stay valid until the object is removed.
+    // Keys without rendererHandles are always looked up by pointer.
+    template<class K, class V>
+    class GLSlotMap {
+
+    public:
+        GLSlotMap(): owner_(SlotMapIds<K>::acquire()) {}
+
+        ~GLSlotMap() {
+
+            SlotMapIds<K>::release(owner_);
+        }
+
+        GLSlotMap(const GLSlotMap&) = delete;
+        GLSlotMap& operator=(const GLSlotMap&) = delete;
+
+        // Inserts a default value when missing.
+        V& get(K* key) {
+
+            if (auto slot = cached(key)) return slot->value;
+
+            auto it = index_.find(key);
+            if (it == index_.end()) {
+
+                unsigned int i;
+                if (!free_.empty()) {
+
+                    i = free_.back();
+                    free_.pop_back();
+
+                } else {
+
+                    i = static_cast<unsigned int>(slots_.size());
+                    slots_.emplace_back();
+                }
+
+                slots_[i].key = key;
+                it = index_.emplace(key, i).first;
+            }
+
+            auto& slot = slots_[it->second];
+            setHandle(key, it->second, slot.generation);
+
+            return slot.value;
+        }
+
+        V* find(K* key) {
+
+            if (auto slot = cached(key)) return &slot->value;
+
+            const auto it = index_.find(key);
+            if (it == index_.end()) return nullptr;
+
+            auto& slot = slots_[it->second];
+            setHandle(key, it->second, slot.generation);
+
+            return &slot.value;
+        }
+
+        [[nodiscard]] bool contains(K* key) const {
+
+            return index_.contains(key);
+        }
+
+        void remove(K* key) {
+
+            const auto it = index_.find(key);
+            if (it == index_.end()) return;
+
+            auto& slot = slots_[it->second];
+            slot.key = nullptr;
+            slot.value = V{};
+            ++slot.generation;
+
+            free_.emplace_back(it->second);
+            index_.erase(it);
+        }
+
+        [[nodiscard]] std::vector<K*> keys() const {
+
+            std::vector<K*> result;
+            result.reserve(index_.size());
+            for (const auto& [key, _] : index_) result.emplace_back(key);
+
+            return result;
+        }
+
+        template<class F>
+        void forEach(F&& f) {
+
+            for (auto& slot : slots_) {
+
+                if (slot.key) f(slot.key, slot.value);
+            }
+        }
+
+        void clear() {
+
+            for (auto& slot : slots_) {
+
+                if (!slot.key) continue;
+
+                slot.key = nullptr;
+                slot.value = V{};
+                ++slot.generation;
+            }
+
+            free_.clear();
+            for (auto i = static_cast<unsigned int>(slots_.size()); i > 0; --i) free_.emplace_back(i - 1);
+
+            index_.clear();
+        }
+
+    private:
+        struct Slot {
+
+            K* key = nullptr;
+            unsigned int generation = 0;
+            V value{};
+        };
+
+        static constexpr bool hasHandles = requires(K* k) { k->rendererHandles; };
+
+        unsigned int owner_;
+
+        std::deque<Slot> slots_;
+        std::vector<unsigned int> free_;
+        std::unordered_map<K*, unsigned int> index_;
+
+        void setHandle(K* key, unsigned int index, unsigned int generation) const {
+
+            if constexpr (hasHandles) {
+
+                auto& handles = key->rendererHandles;
+                if (handles.size() <= owner_) handles.resize(owner_ + 1);
+
+                handles[owner_] = {index, generation};
+            }
+        }
+
+        Slot* cached(K* key) {
+
+            if constexpr (hasHandles) {
+
+                const auto& handles = key->rendererHandles;
+                if (handles.size() <= owner_) return nullptr;
+
+                const auto& h = handles[owner_];
+                if (h.index >= slots_.size()) return nullptr;
+
+                auto& slot = slots_[h.index];
+                if (slot.key != key || slot.generation != h.generation) return nullptr;
+
+                return &slot;
+
+            } else {
+
+                return nullptr;
+            }
+        }
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLSLOTMAP_HPP
@@ -8,6 +8,8 @@
 #include "threepp/textures/DataTexture3D.hpp"
 #include "threepp/textures/DepthTexture.hpp"
 
+#include "threepp/textures/CompressedTextureDecoder.hpp"
+
 #if EMSCRIPTEN
 #include <GLES3/gl32.h>
 #endif
@@ -77,6 +79,12 @@ namespace {
         return internalFormat;
     }
 
+    void releaseData(Texture& texture) {
+
+        for (auto& image : texture.images()) image.releaseData();
+        for (auto& mipmap : texture.mipmaps()) mipmap.releaseData();
+    }
+
 }// namespace
 
 gl::GLTextures::GLTextures(gl::GLState& state, gl::GLProperties& properties, gl::GLInfo& info)
@@ -154,9 +162,39 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
                           static_cast<int>(image.width),
                           static_cast<int>(image.height),
                           static_cast<int>(image.depth),
-                          glFormat, glType, image.data().data());
+                          glFormat, glType, image.pixels());
         textureProperties->maxMipLevel = 0;
 
+    } else if (isCompressed(texture.format)) {
+
+        // levels are uploaded as they are, or decoded to RGBA when the GPU can't sample the format
+        const bool supported = GLCapabilities::instance().supportsCompressedFormat(texture.format);
+
+        for (unsigned i = 0; i < mipmaps.size(); ++i) {
+
+            auto& mipmap = mipmaps[i];
+
+            if (supported) {
+
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), glFormat,
+                                       static_cast<int>(mipmap.width), static_cast<int>(mipmap.height), 0,
+                                       static_cast<GLsizei>(compressedLevelBytes(texture.format, mipmap.width, mipmap.height)), mipmap.pixels());
+
+            } else {
+
+                const auto pixels = decompressImage(texture.format, static_cast<const unsigned char*>(mipmap.pixels()), mipmap.width, mipmap.height);
+                state->texImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA8,
+                                  static_cast<int>(mipmap.width), static_cast<int>(mipmap.height),
+                                  GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            }
+        }
+
+        // a prebuilt chain may stop short of 1x1, limiting the levels keeps the texture mipmap complete
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, std::max(0, static_cast<int>(mipmaps.size()) - 1));
+
+        textureProperties->maxMipLevel = static_cast<int>(mipmaps.size()) - 1;
+
     } else {
 
         // regular Texture (image, video, canvas)
@@ -172,7 +210,7 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
                 auto& mipmap = mipmaps[i];
                 state->texImage2D(GL_TEXTURE_2D, i, glInternalFormat,
                                   static_cast<int>(mipmap.width), static_cast<int>(mipmap.height),
-                                  glFormat, glType, mipmap.data().data());
+                                  glFormat, glType, mipmap.pixels());
             }
 
             texture.generateMipmaps = false;
@@ -180,14 +218,10 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
 
         } else {
 
-            if (glType == GL_UNSIGNED_BYTE) {
-                state->texImage2D(GL_TEXTURE_2D, 0, glInternalFormat,
-                                  static_cast<int>(image.width), static_cast<int>(image.height),
-                                  glFormat, glType, texture.image().data().data());
-            } else if (glType == GL_FLOAT) {
+            if (glType == GL_UNSIGNED_BYTE || glType == GL_FLOAT) {
                 state->texImage2D(GL_TEXTURE_2D, 0, glInternalFormat,
                                   static_cast<int>(image.width), static_cast<int>(image.height),
-                                  glFormat, glType, texture.image().data<float>().data());
+                                  glFormat, glType, image.pixels());
             } else {
 
                 std::cerr << "Unnsupported gltype=" << glType << std::endl;
@@ -201,6 +235,8 @@ void gl::GLTextures::uploadTexture(TextureProperties* textureProperties, Texture
         generateMipmap(textureType, texture, image.width, image.height);
     }
 
+    if (texture.releaseDataAfterUpload) releaseData(texture);
+
     textureProperties->version = texture.version();
 
     if (texture.onUpdate) texture.onUpdate.value()(texture);
@@ -365,10 +401,10 @@ void gl::GLTextures::uploadCubeTexture(TextureProperties* textureProperties, Tex
     auto& mipmaps = texture.mipmaps();
     for (int i = 0; i < 6; i++) {
         auto& image = images[i];
-        state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, glInternalFormat, image.width, image.height, glFormat, glType, image.data().data());
+        state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, glInternalFormat, image.width, image.height, glFormat, glType, image.pixels());
 
         for (unsigned j = 0; j < mipmaps.size(); j++) {
-            state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, j + i, glInternalFormat, image.width, image.height, glFormat, glType, mipmaps[j].data().data());
+            state->texImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, j + i, glInternalFormat, image.width, image.height, glFormat, glType, mipmaps[j].pixels());
         }
     }
 
@@ -378,6 +414,8 @@ void gl::GLTextures::uploadCubeTexture(TextureProperties* textureProperties, Tex
         generateMipmap(GL_TEXTURE_CUBE_MAP, texture, images.front().width, images.front().height);
     }
 
+    if (texture.releaseDataAfterUpload) releaseData(texture);
+
     textureProperties->version = texture.version();
     if (texture.onUpdate) {
         texture.onUpdate.value()(texture);
@@ -0,0 +1,250 @@
+
+#include "threepp/renderers/gl/GLUniformBlocks.hpp"
+
+#include "threepp/cameras/OrthographicCamera.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#ifndef EMSCRIPTEN
+#include <glad/glad.h>
+#else
+#include <GLES3/gl32.h>
+#endif
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // sizes in floats, following the std140 rules: vec3 and struct members of arrays are aligned to 16 bytes
+
+    constexpr size_t cameraSize = 36;// mat4 projectionMatrix, mat4 viewMatrix, vec3 cameraPosition, bool isOrthographic
+    constexpr size_t fogSize = 8;    // vec3 fogColor, float fogDensity, float fogNear, float fogFar
+
+    constexpr size_t lightsHeaderSize = 40;// vec3 ambientLightColor, vec3 lightProbe[9]
+    constexpr size_t directionalStride = 8;
+    constexpr size_t pointStride = 12;
+    constexpr size_t spotStride = 16;
+    constexpr size_t hemiStride = 12;
+
+    void writeVec3(float* dst, float x, float y, float z) {
+
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+
+    void writeVec3(float* dst, const NestedUniformValue& value) {
+
+        if (std::holds_alternative<Color>(value)) {
+
+            const auto& c = std::get<Color>(value);
+            writeVec3(dst, c.r, c.g, c.b);
+
+        } else {
+
+            const auto& v = std::get<Vector3>(value);
+            writeVec3(dst, v.x, v.y, v.z);
+        }
+    }
+
+    float getFloat(const LightUniforms& uniforms, const std::string& name) {
+
+        return std::get<float>(uniforms.at(name));
+    }
+
+}// namespace
+
+
+void GLUniformBlocks::bindProgram(unsigned int program) {
+
+    const auto bind = [program](const char* name, unsigned int binding) {
+        const auto index = glGetUniformBlockIndex(program, name);
+        if (index != GL_INVALID_INDEX) {
+
+            glUniformBlockBinding(program, index, binding);
+        }
+    };
+
+    bind("threeCamera", cameraBinding);
+    bind("threeLights", lightsBinding);
+    bind("threeClusteredLights", clusteredLightsBinding);
+    bind("threeFog", fogBinding);
+}
+
+void GLUniformBlocks::invalidate() {
+
+    ++serial_;
+}
+
+void GLUniformBlocks::updateCamera(const Camera& camera) {
+
+    if (!needsUpdate(camera_, &camera)) return;
+
+    auto& data = camera_.data;
+    data.assign(cameraSize, 0.f);
+
+    std::copy(camera.projectionMatrix.elements.begin(), camera.projectionMatrix.elements.end(), data.begin());
+    std::copy(camera.matrixWorldInverse.elements.begin(), camera.matrixWorldInverse.elements.end(), data.begin() + 16);
+
+    const auto& e = camera.matrixWorld.elements;
+    writeVec3(&data[32], e[12], e[13], e[14]);
+    data[35] = std::bit_cast<float>(static_cast<uint32_t>(camera.is<OrthographicCamera>()));
+
+    upload(camera_, cameraBinding);
+}
+
+void GLUniformBlocks::updateLights(const GLLights::LightState& lights, bool clusteredProgram) {
+
+    if (clusteredProgram) {
+
+        if (!needsUpdate(clusteredLights_, &lights)) return;
+
+        // shadow-casting lights come first, see ProgramParameters
+        fillLights(clusteredLights_, lights, lights.pointShadowMap.size(), lights.spotShadowMap.size());
+        upload(clusteredLights_, clusteredLightsBinding);
+
+    } else {
+
+        if (!needsUpdate(lights_, &lights)) return;
+
+        fillLights(lights_, lights, lights.point.size(), lights.spot.size());
+        upload(lights_, lightsBinding);
+    }
+}
+
+void GLUniformBlocks::fillLights(Block& block, const GLLights::LightState& lights, size_t numPoint, size_t numSpot) {
+
+    auto& data = block.data;
+    data.assign(lightsHeaderSize +
+                        lights.directional.size() * directionalStride +
+                        numPoint * pointStride +
+                        numSpot * spotStride +
+                        lights.hemi.size() * hemiStride,
+                0.f);
+
+    writeVec3(&data[0], lights.ambient.r, lights.ambient.g, lights.ambient.b);
+    for (size_t i = 0; i < lights.probe.size(); i++) {
+
+        const auto& p = lights.probe[i];
+        writeVec3(&data[4 + i * 4], p.x, p.y, p.z);
+    }
+
+    auto dst = &data[lightsHeaderSize];
+
+    for (const auto light : lights.directional) {
+
+        writeVec3(dst, light->at("direction"));
+        writeVec3(dst + 4, light->at("color"));
+        dst += directionalStride;
+    }
+
+    for (size_t i = 0; i < numPoint; i++) {
+
+        const auto light = lights.point[i];
+
+        writeVec3(dst, light->at("position"));
+        writeVec3(dst + 4, light->at("color"));
+        dst[7] = getFloat(*light, "distance");
+        dst[8] = getFloat(*light, "decay");
+        dst += pointStride;
+    }
+
+    for (size_t i = 0; i < numSpot; i++) {
+
+        const auto light = lights.spot[i];
+
+        writeVec3(dst, light->at("position"));
+        writeVec3(dst + 4, light->at("direction"));
+        writeVec3(dst + 8, light->at("color"));
+        dst[11] = getFloat(*light, "distance");
+        dst[12] = getFloat(*light, "decay");
+        dst[13] = getFloat(*light, "coneCos");
+        dst[14] = getFloat(*light, "penumbraCos");
+        dst += spotStride;
+    }
+
+    for (const auto light : lights.hemi) {
+
+        writeVec3(dst, light->at("direction"));
+        writeVec3(dst + 4, light->at("skyColor"));
+        writeVec3(dst + 8, light->at("groundColor"));
+        dst += hemiStride;
+    }
+}
+
+void GLUniformBlocks::updateFog(const FogVariant& fog) {
+
+    if (!needsUpdate(fog_, &fog)) return;
+
+    auto& data = fog_.data;
+    data.assign(fogSize, 0.f);
+
+    if (fog.index() == 0) {
+
+        const auto& f = std::get<Fog>(fog);
+        writeVec3(&data[0], f.color.r, f.color.g, f.color.b);
+        data[4] = f.near;
+        data[5] = f.far;
+
+    } else {
+
+        const auto& f = std::get<FogExp2>(fog);
+        writeVec3(&data[0], f.color.r, f.color.g, f.color.b);
+        data[3] = f.density;
+    }
+
+    upload(fog_, fogBinding);
+}
+
+void GLUniformBlocks::dispose() {
+
+    for (auto block : {&camera_, &lights_, &clusteredLights_, &fog_}) {
+
+        if (block->buffer) {
+
+            glDeleteBuffers(1, &block->buffer);
+        }
+
+        *block = {};
+    }
+}
+
+bool GLUniformBlocks::needsUpdate(Block& block, const void* source) const {
+
+    if (block.source == source && block.serial == serial_) return false;
+
+    block.source = source;
+    block.serial = serial_;
+
+    return true;
+}
+
+void GLUniformBlocks::upload(Block& block, unsigned int binding) {
+
+    const auto size = static_cast<GLsizeiptr>(block.data.size() * sizeof(float));
+
+    if (!block.buffer) {
+
+        glGenBuffers(1, &block.buffer);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+
+    if (static_cast<size_t>(size) > block.capacity) {
+
+        glBufferData(GL_UNIFORM_BUFFER, size, block.data.data(), GL_DYNAMIC_DRAW);
+        block.capacity = size;
+
+        // binds the whole buffer, so that the range always covers the block
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, block.buffer);
+
+    } else {
+
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, block.data.data());
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
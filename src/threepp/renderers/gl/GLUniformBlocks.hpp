@@ -0,0 +1,70 @@
+
+#ifndef THREEPP_GLUNIFORMBLOCKS_HPP
+#define THREEPP_GLUNIFORMBLOCKS_HPP
+
+#include "threepp/renderers/gl/GLLights.hpp"
+
+#include "threepp/cameras/Camera.hpp"
+#include "threepp/scenes/Scene.hpp"
+
+#include <vector>
+
+namespace threepp::gl {
+
+    // std140 uniform buffers for per-frame data shared by every program: camera, lights and fog.
+    // Each buffer is uploaded at most once per render() (or when its source changes within one), instead of
+    // setting the same uniforms again on every program switch. Programs opt in with USE_UNIFORM_BLOCKS.
+    class GLUniformBlocks {
+
+    public:
+        static constexpr unsigned int cameraBinding = 0;
+        static constexpr unsigned int lightsBinding = 1;
+        static constexpr unsigned int fogBinding = 2;
+        static constexpr unsigned int clusteredLightsBinding = 3;
+
+        // Connects the blocks declared by program to the binding points above. Must be called after linking.
+        static void bindProgram(unsigned int program);
+
+        // Marks all buffers as stale, called at the start of each render().
+        void invalidate();
+
+        void updateCamera(const Camera& camera);
+
+        // The layout follows lights_pars_begin, which depends on the number of lights of each type.
+        // Programs using the clusters read their own block, holding only the shadow-casting point and spot lights.
+        void updateLights(const GLLights::LightState& lights, bool clusteredProgram = false);
+
+        void updateFog(const FogVariant& fog);
+
+        void dispose();
+
+    private:
+        struct Block {
+
+            unsigned int buffer = 0;
+            size_t capacity = 0;
+
+            const void* source = nullptr;
+            unsigned int serial = 0;
+
+            std::vector<float> data;
+        };
+
+        unsigned int serial_ = 1;
+
+        Block camera_;
+        Block lights_;
+        Block clusteredLights_;
+        Block fog_;
+
+        // whether block needs to be refilled from source
+        bool needsUpdate(Block& block, const void* source) const;
+
+        static void fillLights(Block& block, const GLLights::LightState& lights, size_t numPoint, size_t numSpot);
+
+        static void upload(Block& block, unsigned int binding);
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLUNIFORMBLOCKS_HPP
@@ -167,11 +167,9 @@ namespace {
             cache[0] = f;
         }
 
-        template<class ArrayLike>
-        void setValueV2fHelper(ArrayLike& value) {
+        // the setters below read the value in place, without copying it out of the variant
 
-            float x = value[0];
-            float y = value[1];
+        void setValueV2f(float x, float y) {
 
             ensureCapacity(cache, 2);
             if (cache[0] != x || cache[1] != y) {
@@ -185,19 +183,17 @@ namespace {
 
         void setValueV2f(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueV2f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector2 arg) { setValueV2fHelper(arg); },
-                       },
-                       value);
-        }
+            if (auto v = std::get_if<Vector2>(&value)) {
 
-        template<class ArrayLike>
-        void setValueV3fHelper(ArrayLike& value) {
+                setValueV2f(v->x, v->y);
 
-            float x = value[0];
-            float y = value[1];
-            float z = value[2];
+            } else {
+
+                std::cerr << "setValueV2f: unsupported variant at index: " << value.index() << std::endl;
+            }
+        }
+
+        void setValueV3f(float x, float y, float z) {
 
             ensureCapacity(cache, 3);
             if (cache[0] != x || cache[1] != y || cache[2] != z) {
@@ -212,47 +208,47 @@ namespace {
 
         void setValueV3f(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueV3f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector3 arg) { setValueV3fHelper(arg); },
-                               [&](Vector3* arg) { setValueV3fHelper(*arg); },
-                               [&](Color arg) { setValueV3fHelper(arg); },
-                       },
-                       value);
-        }
+            if (auto v = std::get_if<Vector3>(&value)) {
 
-        template<class ArrayLike>
-        void setValueV4fHelper(ArrayLike& value) {
+                setValueV3f(v->x, v->y, v->z);
 
-            float x = value[0];
-            float y = value[1];
-            float z = value[2];
-            float w = value[3];
+            } else if (auto p = std::get_if<Vector3*>(&value)) {
 
-            ensureCapacity(cache, 4);
-            if (cache[0] != x || cache[1] != y && cache[2] != z || cache[3] != w) {
+                setValueV3f((*p)->x, (*p)->y, (*p)->z);
 
-                glUniform4f(addr, x, y, z, w);
+            } else if (auto c = std::get_if<Color>(&value)) {
 
-                cache[0] = x;
-                cache[1] = y;
-                cache[2] = z;
-                cache[3] = w;
+                setValueV3f(c->r, c->g, c->b);
+
+            } else {
+
+                std::cerr << "setValueV3f: unsupported variant at index: " << value.index() << std::endl;
             }
         }
 
         void setValueV4f(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueV4f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector4 arg) { setValueV4fHelper(arg); },
-                               [&](Quaternion arg) { setValueV4fHelper(arg); },
-                       },
-                       value);
+            auto v = std::get_if<Vector4>(&value);
+            if (!v) {
+
+                std::cerr << "setValueV4f: unsupported variant at index: " << value.index() << std::endl;
+                return;
+            }
+
+            ensureCapacity(cache, 4);
+            if (cache[0] != v->x || cache[1] != v->y || cache[2] != v->z || cache[3] != v->w) {
+
+                glUniform4f(addr, v->x, v->y, v->z, v->w);
+
+                cache[0] = v->x;
+                cache[1] = v->y;
+                cache[2] = v->z;
+                cache[3] = v->w;
+            }
         }
 
         template<class ArrayLike>
-        void setValueM3Helper(ArrayLike& value) {
+        void setValueM3Helper(const ArrayLike& value) {
 
             if (arraysEqual(cache, value)) return;
 
@@ -264,15 +260,18 @@ namespace {
 
         void setValueM3(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueM3: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Matrix3 arg) { setValueM3Helper(arg.elements); },
-                       },
-                       value);
+            if (auto m = std::get_if<Matrix3>(&value)) {
+
+                setValueM3Helper(m->elements);
+
+            } else {
+
+                std::cerr << "setValueM3: unsupported variant at index: " << value.index() << std::endl;
+            }
         }
 
         template<class ArrayLike>
-        void setValueM4Helper(ArrayLike& value) {
+        void setValueM4Helper(const ArrayLike& value) {
 
             if (arraysEqual(cache, value)) return;
 
@@ -284,11 +283,18 @@ namespace {
 
         void setValueM4(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Matrix4 arg) { setValueM4Helper(arg.elements); },
-                               [&](Matrix4* arg) { setValueM4Helper(arg->elements); }},
-                       value);
+            if (auto m = std::get_if<Matrix4>(&value)) {
+
+                setValueM4Helper(m->elements);
+
+            } else if (auto p = std::get_if<Matrix4*>(&value)) {
+
+                setValueM4Helper((*p)->elements);
+
+            } else {
+
+                std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl;
+            }
         }
     };
 
@@ -337,10 +343,10 @@ namespace {
                 case 0x8b5c:// MAT4
                     return [&](const UniformValue& value, GLTextures*) {
                         std::visit(overloaded{
-                                           [&](auto) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
-                                           [&](std::vector<float> arg) { glUniformMatrix4fv(addr, activeInfo.size, false, arg.data()); },
-                                           [&](std::vector<Matrix4> arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flatten(arg, activeInfo.size, 16).data()); },
-                                           [&](std::vector<Matrix4*> arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flattenP(arg, activeInfo.size, 16).data()); }},
+                                           [&](const auto&) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
+                                           [&](const std::vector<float>& arg) { glUniformMatrix4fv(addr, activeInfo.size, false, arg.data()); },
+                                           [&](const std::vector<Matrix4>& arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flatten(arg, activeInfo.size, 16).data()); },
+                                           [&](const std::vector<Matrix4*>& arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flattenP(arg, activeInfo.size, 16).data()); }},
                                    value);
                     };
                 case 0x8b5e:// SAMPLER_2D
@@ -386,10 +392,10 @@ namespace {
 
             std::visit(
                     overloaded{
-                            [&](auto) { std::cout << "StructuredUniform '" << activeInfo.name << "': unsupported variant at index: " << value.index() << std::endl; },
-                            [&](std::unordered_map<std::string, NestedUniformValue> args) {
+                            [&](const auto&) { std::cout << "StructuredUniform '" << activeInfo.name << "': unsupported variant at index: " << value.index() << std::endl; },
+                            [&](const std::unordered_map<std::string, NestedUniformValue>& args) {
                                 for (auto& u : seq) {
-                                    NestedUniformValue& v = args.at(u->id);
+                                    const NestedUniformValue& v = args.at(u->id);
                                     std::visit(overloaded{
                                                        [&](auto) { std::cout << "Warning: Unhandled NestedUniformValue!" << std::endl; },
                                                        [&](int arg) { u->setValue(arg, textures); },
@@ -400,7 +406,7 @@ namespace {
                                                v);
                                 }
                             },
-                            [&](std::vector<std::unordered_map<std::string, NestedUniformValue>*> arg) {
+                            [&](const std::vector<std::unordered_map<std::string, NestedUniformValue>*>& arg) {
                                 for (auto& u : seq) {
                                     const auto index = utils::parseInt(u->id);
                                     auto value = arg[index];
@@ -480,6 +486,9 @@ GLUniforms::GLUniforms(unsigned int program) {
         ActiveUniformInfo info(program, i);
         GLint addr = glGetUniformLocation(program, info.name.c_str());
 
+        // members of uniform blocks have no location, they are set through GLUniformBlocks
+        if (addr < 0) continue;
+
         parseUniform(info, addr, dynamic_cast<Container*>(this));
     }
 }
@@ -492,27 +501,28 @@ void GLUniforms::setValue(const std::string& name, const UniformValue& value, GL
     }
 }
 
-void GLUniforms::upload(std::vector<UniformObject*>& seq, UniformMap& values, GLTextures* textures) {
-
-    for (const auto& u : seq) {
+void GLUniforms::upload(const std::vector<UniformSlot>& seq, GLTextures* textures) {
 
-        Uniform& v = values.at(u->id);
+    for (const auto& [u, v] : seq) {
 
-        if (!v.needsUpdate || (v.needsUpdate && v.needsUpdate.value())) {
+        if (!v->needsUpdate || v->needsUpdate.value()) {
 
             // note: always updating when .needsUpdate is undefined
-            u->setValue(v.value(), textures);
+            u->setValue(v->value(), textures);
         }
     }
 }
 
-std::vector<UniformObject*> GLUniforms::seqWithValue(const std::vector<std::unique_ptr<UniformObject>>& seq, UniformMap& values) {
+std::vector<UniformSlot> GLUniforms::seqWithValue(const std::vector<std::unique_ptr<UniformObject>>& seq, UniformMap& values) {
 
-    std::vector<UniformObject*> r;
+    std::vector<UniformSlot> r;
 
     for (const auto& u : seq) {
 
-        if (values.contains(u->id)) r.emplace_back(u.get());
+        if (const auto it = values.find(u->id); it != values.end()) {
+
+            r.push_back({u.get(), &it->second});
+        }
     }
 
     return r;
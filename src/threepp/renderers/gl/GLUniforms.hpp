@@ -24,6 +24,13 @@ namespace threepp::gl {
         virtual ~UniformObject() = default;
     };
 
+    // A program uniform together with the material value it is set from, resolved once per program.
+    struct UniformSlot {
+
+        UniformObject* object;
+        Uniform* value;
+    };
+
     struct Container {
 
         std::vector<std::unique_ptr<UniformObject>> seq;
@@ -38,9 +45,10 @@ namespace threepp::gl {
 
         void setValue(const std::string& name, const UniformValue& value, GLTextures* textures = nullptr);
 
-        static void upload(std::vector<UniformObject*>& seq, UniformMap& values, GLTextures* textures);
+        static void upload(const std::vector<UniformSlot>& seq, GLTextures* textures);
 
-        static std::vector<UniformObject*> seqWithValue(const std::vector<std::unique_ptr<UniformObject>>& seq, UniformMap& values);
+        // The slots point into values, which must outlive them and may not have entries removed.
+        static std::vector<UniformSlot> seqWithValue(const std::vector<std::unique_ptr<UniformObject>>& seq, UniformMap& values);
     };
 
 }// namespace threepp::gl
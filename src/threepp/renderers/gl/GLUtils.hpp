@@ -11,6 +11,26 @@
 
 #include "threepp/constants.hpp"
 
+// compressed formats missing from the GL 4.1 loader
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RED_RGTC1
+#define GL_COMPRESSED_RED_RGTC1 0x8DBB
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#include <string_view>
+
 namespace threepp::gl {
 
     inline GLint glGetParameteri(GLenum id) {
@@ -25,6 +45,26 @@ namespace threepp::gl {
         return result;
     }
 
+    inline bool glHasExtension(std::string_view name) {
+#ifndef EMSCRIPTEN
+        const auto count = glGetParameteri(GL_NUM_EXTENSIONS);
+        for (GLint i = 0; i < count; ++i) {
+            const auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension && name == extension) return true;
+        }
+#endif
+        return false;
+    }
+
+    inline bool glVersionAtLeast(int major, int minor) {
+#ifndef EMSCRIPTEN
+        const auto version = glGetParameteri(GL_MAJOR_VERSION) * 10 + glGetParameteri(GL_MINOR_VERSION);
+        return version >= major * 10 + minor;
+#else
+        return false;
+#endif
+    }
+
     constexpr inline GLuint toGLFormat(Format p) {
 
         switch (p) {
@@ -54,6 +94,22 @@ namespace threepp::gl {
                 return GL_RGB_INTEGER;
             case Format::RGBAInteger:
                 return GL_RGBA_INTEGER;
+            case Format::RGB_S3TC_DXT1:
+                return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case Format::RGBA_S3TC_DXT1:
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case Format::RGBA_S3TC_DXT5:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case Format::RED_RGTC1:
+                return GL_COMPRESSED_RED_RGTC1;
+            case Format::RED_GREEN_RGTC2:
+                return GL_COMPRESSED_RG_RGTC2;
+            case Format::RGBA_BPTC:
+                return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case Format::RGB_ETC2:
+                return GL_COMPRESSED_RGB8_ETC2;
+            case Format::RGBA_ETC2_EAC:
+                return GL_COMPRESSED_RGBA8_ETC2_EAC;
             default:
                 return 0;
         }
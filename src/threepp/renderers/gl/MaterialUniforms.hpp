@@ -0,0 +1,197 @@
+
+#ifndef THREEPP_MATERIALUNIFORMS_HPP
+#define THREEPP_MATERIALUNIFORMS_HPP
+
+#include "threepp/core/Uniform.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace threepp::gl {
+
+    // Uniforms written by the renderer when refreshing a material.
+    enum class MaterialUniform {
+        Opacity,
+        Diffuse,
+        Color,
+        Emissive,
+        Map,
+        AlphaMap,
+        SpecularMap,
+        EnvMap,
+        FlipEnvMap,
+        Reflectivity,
+        RefractionRatio,
+        MaxMipLevel,
+        EnvMapIntensity,
+        LightMap,
+        LightMapIntensity,
+        AoMap,
+        AoMapIntensity,
+        UvTransform,
+        Uv2Transform,
+        EmissiveMap,
+        Specular,
+        Shininess,
+        BumpMap,
+        BumpScale,
+        NormalMap,
+        NormalScale,
+        DisplacementMap,
+        DisplacementScale,
+        DisplacementBias,
+        Roughness,
+        Metalness,
+        RoughnessMap,
+        MetalnessMap,
+        Matcap,
+        GradientMap,
+        ReferencePosition,
+        NearDistance,
+        FarDistance,
+        Size,
+        Scale,
+        Rotation,
+        FogColor,
+        FogNear,
+        FogFar,
+        FogDensity,
+        AmbientLightColor,
+        LightProbe,
+        DirectionalLights,
+        DirectionalLightShadows,
+        PointLights,
+        PointLightShadows,
+        SpotLights,
+        SpotLightShadows,
+        HemisphereLights,
+        Count
+    };
+
+    // Slots into a material's UniformMap, indexed by MaterialUniform.
+    // A slot is looked up by name on first use only, so refreshing a material does not hash uniform names.
+    // Maps owned by the user (ShaderMaterial::uniforms) may be replaced at any time and are therefore never cached.
+    class MaterialUniforms {
+
+    public:
+        MaterialUniforms() = default;
+
+        MaterialUniforms(UniformMap& uniforms, bool cache)
+            : uniforms_(&uniforms), cache_(cache) {}
+
+        [[nodiscard]] UniformMap* map() const {
+
+            return uniforms_;
+        }
+
+        // Like UniformMap::at, throws when the material has no such uniform.
+        Uniform& at(MaterialUniform uniform) {
+
+            return *resolve(uniform, false);
+        }
+
+        // Like UniformMap::operator[], adds the uniform when missing.
+        Uniform& operator[](MaterialUniform uniform) {
+
+            return *resolve(uniform, true);
+        }
+
+    private:
+        UniformMap* uniforms_ = nullptr;
+        bool cache_ = false;
+
+        std::array<Uniform*, static_cast<size_t>(MaterialUniform::Count)> slots_{};
+
+        Uniform* resolve(MaterialUniform uniform, bool insert) {
+
+            const auto index = static_cast<size_t>(uniform);
+
+            if (auto slot = slots_[index]) return slot;
+
+            const auto& name = names()[index];
+
+            Uniform* result;
+            if (insert) {
+
+                result = &(*uniforms_)[name];
+
+            } else {
+
+                const auto it = uniforms_->find(name);
+                if (it == uniforms_->end()) throw std::out_of_range("No uniform named '" + name + "'");
+
+                result = &it->second;
+            }
+
+            // unordered_map never moves its elements, so the pointer stays valid for as long as the entry exists
+            if (cache_) slots_[index] = result;
+
+            return result;
+        }
+
+        static const std::array<std::string, static_cast<size_t>(MaterialUniform::Count)>& names() {
+
+            static const std::array<std::string, static_cast<size_t>(MaterialUniform::Count)> names{
+                    "opacity",
+                    "diffuse",
+                    "color",
+                    "emissive",
+                    "map",
+                    "alphaMap",
+                    "specularMap",
+                    "envMap",
+                    "flipEnvMap",
+                    "reflectivity",
+                    "refractionRatio",
+                    "maxMipLevel",
+                    "envMapIntensity",
+                    "lightMap",
+                    "lightMapIntensity",
+                    "aoMap",
+                    "aoMapIntensity",
+                    "uvTransform",
+                    "uv2Transform",
+                    "emissiveMap",
+                    "specular",
+                    "shininess",
+                    "bumpMap",
+                    "bumpScale",
+                    "normalMap",
+                    "normalScale",
+                    "displacementMap",
+                    "displacementScale",
+                    "displacementBias",
+                    "roughness",
+                    "metalness",
+                    "roughnessMap",
+                    "metalnessMap",
+                    "matcap",
+                    "gradientMap",
+                    "referencePosition",
+                    "nearDistance",
+                    "farDistance",
+                    "size",
+                    "scale",
+                    "rotation",
+                    "fogColor",
+                    "fogNear",
+                    "fogFar",
+                    "fogDensity",
+                    "ambientLightColor",
+                    "lightProbe",
+                    "directionalLights",
+                    "directionalLightShadows",
+                    "pointLights",
+                    "pointLightShadows",
+                    "spotLights",
+                    "spotLightShadows",
+                    "hemisphereLights"};
+
+            return names;
+        }
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_MATERIALUNIFORMS_HPP
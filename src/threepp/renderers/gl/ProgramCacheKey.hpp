@@ -0,0 +1,65 @@
+
+#ifndef THREEPP_PROGRAMCACHEKEY_HPP
+#define THREEPP_PROGRAMCACHEKEY_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace threepp::gl {
+
+    // 128-bit hash of the state that determines the generated shader code.
+    // The data it was computed from is kept in GLProgram::cacheKey, so that collisions can be detected on a hit.
+    struct ProgramCacheKey {
+
+        uint64_t h0{};
+        uint64_t h1{};
+
+        bool operator==(const ProgramCacheKey& other) const = default;
+
+        // two seeded 64-bit lanes over the data, 8 bytes at a time
+        static ProgramCacheKey fromData(std::string_view data) {
+
+            uint64_t h0 = 0x9e3779b97f4a7c15ULL ^ data.size();
+            uint64_t h1 = 0x6a09e667f3bcc909ULL + data.size();
+
+            const auto size = data.size();
+            for (size_t i = 0; i < size; i += 8) {
+
+                uint64_t word = 0;
+                std::memcpy(&word, data.data() + i, std::min<size_t>(8, size - i));
+
+                h0 = std::rotl(h0 ^ (word * 0x87c37b91114253d5ULL), 31) * 0x4cf5ad432745937fULL;
+                h1 = std::rotl(h1 + (word ^ 0x52dce729da3ed7b5ULL), 27) * 0x9e3779b97f4a7c15ULL + h0;
+            }
+
+            return {mix(h0), mix(h1 ^ h0)};
+        }
+
+        struct Hash {
+
+            size_t operator()(const ProgramCacheKey& key) const {
+
+                return static_cast<size_t>(key.h0 ^ (key.h1 << 1));
+            }
+        };
+
+    private:
+        static uint64_t mix(uint64_t h) {
+
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+
+            return h;
+        }
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_PROGRAMCACHEKEY_HPP
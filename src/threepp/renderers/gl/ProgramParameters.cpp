@@ -7,11 +7,12 @@
 #include "threepp/renderers/shaders/ShaderLib.hpp"
 
 #include "threepp/materials/RawShaderMaterial.hpp"
+#include "threepp/objects/BatchedMesh.hpp"
 #include "threepp/objects/InstancedMesh.hpp"
 #include "threepp/objects/SkinnedMesh.hpp"
 #include "threepp/scenes/Scene.hpp"
 
-#include <sstream>
+#include <type_traits>
 
 using namespace threepp;
 using namespace threepp::gl;
@@ -23,6 +24,24 @@ namespace {
         return map ? map->encoding : Encoding::Linear;
     }
 
+    struct KeyWriter {
+
+        std::string& out;
+
+        template<class T>
+        void write(const T& value) {
+
+            static_assert(std::is_trivially_copyable_v<T>);
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void write(const std::string& str) {
+
+            write(str.size());
+            out.append(str);
+        }
+    };
+
 }// namespace
 
 ProgramParameters::ProgramParameters(
@@ -35,34 +54,34 @@ ProgramParameters::ProgramParameters(
         Material* material,
         const std::unordered_map<std::string, std::string>& shaderIDs) {
 
-    auto mapMaterial = dynamic_cast<MaterialWithMap*>(material);
-    auto alphaMaterial = dynamic_cast<MaterialWithAlphaMap*>(material);
-    auto aomapMaterial = dynamic_cast<MaterialWithAoMap*>(material);
-    auto bumpmapMaterial = dynamic_cast<MaterialWithBumpMap*>(material);
-    auto matcapMaterial = dynamic_cast<MaterialWithMatCap*>(material);
-    auto gradientMaterial = dynamic_cast<MaterialWithGradientMap*>(material);
-    auto envmapMaterial = dynamic_cast<MaterialWithEnvMap*>(material);
-    auto lightmapMaterial = dynamic_cast<MaterialWithLightMap*>(material);
-    auto emissiveMaterial = dynamic_cast<MaterialWithEmissive*>(material);
-    auto normalMaterial = dynamic_cast<MaterialWithNormalMap*>(material);
-    auto specularMapMaterial = dynamic_cast<MaterialWithSpecularMap*>(material);
-    auto displacementMapMaterial = dynamic_cast<MaterialWithDisplacementMap*>(material);
-    auto combineMaterial = dynamic_cast<MaterialWithCombine*>(material);
-    auto flatshadeMaterial = dynamic_cast<MaterialWithFlatShading*>(material);
-    auto vertextangentsMaterial = dynamic_cast<MaterialWithVertexTangents*>(material);
-    auto depthpackMaterial = dynamic_cast<MaterialWithDepthPacking*>(material);
-    auto sheenMaterial = dynamic_cast<MaterialWithSheen*>(material);
-    auto shaderMaterial = dynamic_cast<ShaderMaterial*>(material);
-    auto definesMaterial = dynamic_cast<MaterialWithDefines*>(material);
-    // auto thicknessMaterial = dynamic_cast<MaterialWithThickness*>(material);
-    auto roughnessMaterial = dynamic_cast<MaterialWithRoughness*>(material);
-    auto metallnessMaterial = dynamic_cast<MaterialWithMetalness*>(material);
+    auto mapMaterial = material->as<MaterialWithMap>();
+    auto alphaMaterial = material->as<MaterialWithAlphaMap>();
+    auto aomapMaterial = material->as<MaterialWithAoMap>();
+    auto bumpmapMaterial = material->as<MaterialWithBumpMap>();
+    auto matcapMaterial = material->as<MaterialWithMatCap>();
+    auto gradientMaterial = material->as<MaterialWithGradientMap>();
+    auto envmapMaterial = material->as<MaterialWithEnvMap>();
+    auto lightmapMaterial = material->as<MaterialWithLightMap>();
+    auto emissiveMaterial = material->as<MaterialWithEmissive>();
+    auto normalMaterial = material->as<MaterialWithNormalMap>();
+    auto specularMapMaterial = material->as<MaterialWithSpecularMap>();
+    auto displacementMapMaterial = material->as<MaterialWithDisplacementMap>();
+    auto combineMaterial = material->as<MaterialWithCombine>();
+    auto flatshadeMaterial = material->as<MaterialWithFlatShading>();
+    auto vertextangentsMaterial = material->as<MaterialWithVertexTangents>();
+    auto depthpackMaterial = material->as<MaterialWithDepthPacking>();
+    auto sheenMaterial = material->as<MaterialWithSheen>();
+    auto shaderMaterial = material->as<ShaderMaterial>();
+    auto definesMaterial = material->as<MaterialWithDefines>();
+    // auto thicknessMaterial = material->as<MaterialWithThickness>();
+    auto roughnessMaterial = material->as<MaterialWithRoughness>();
+    auto metallnessMaterial = material->as<MaterialWithMetalness>();
 
     std::string vShader, fShader;
     if (shaderIDs.contains(material->type())) {
 
         shaderID = shaderIDs.at(material->type());
-        const auto shader = shaders::ShaderLib::instance().get(*shaderID);
+        const auto& shader = shaders::ShaderLib::instance().get(*shaderID);
         vShader = shader.vertexShader;
         fShader = shader.fragmentShader;
 
@@ -82,12 +101,14 @@ ProgramParameters::ProgramParameters(
     }
 
     isRawShaderMaterial = material->is<RawShaderMaterial>();
+    uniformBlocks = renderer.uniformBlocks && !isRawShaderMaterial;
 
     precision = "highp";
 
-    auto instancedMesh = dynamic_cast<InstancedMesh*>(object);
+    auto instancedMesh = object->as<InstancedMesh>();
     instancing = instancedMesh != nullptr;
     instancingColor = instancedMesh != nullptr && instancedMesh->instanceColor() != nullptr;
+    batching = object->is<BatchedMesh>();
 
     supportsVertexTextures = GLCapabilities::instance().vertexTextures;
     outputEncoding = renderer.outputEncoding;
@@ -141,9 +162,12 @@ ProgramParameters::ProgramParameters(
     vertexAlphas = material->vertexColors &&
                    object->geometry() &&
                    object->geometry()->hasAttribute("color") &&
-                   object->geometry()->getAttribute<float>("color")->itemSize() == 4;
+                   object->geometry()->getAttribute("color")->itemSize() == 4;
     vertexUvs = true;     // TODO
     uvsVertexOnly = false;// TODO;
+    octahedralNormals = object->geometry() &&
+                        object->geometry()->hasAttribute("normal") &&
+                        object->geometry()->getAttribute("normal")->itemSize() == 2;
 
     fog = scene->fog.has_value();
     useFog = material->fog;
@@ -165,16 +189,20 @@ ProgramParameters::ProgramParameters(
         morphNormals = m->morphNormals;
     }
 
-    numDirLights = lights.directional.size();
-    numPointLights = lights.point.size();
-    numSpotLights = lights.spot.size();
-    numRectAreaLights = 0;
-    numHemiLights = lights.hemi.size();
+    // only the fragment lighting of these shaders loops over the clusters, other programs keep every light in the arrays
+    clusteredLights = lights.clustered && shaderID && (*shaderID == "phong" || *shaderID == "toon" || *shaderID == "physical");
 
     numDirLightShadows = lights.directionalShadowMap.size();
     numPointLightShadows = lights.pointShadowMap.size();
     numSpotLightShadows = lights.spotShadowMap.size();
 
+    // shadow-casting lights come first, the rest of the arrays is shaded through the clusters
+    numDirLights = lights.directional.size();
+    numPointLights = clusteredLights ? numPointLightShadows : lights.point.size();
+    numSpotLights = clusteredLights ? numSpotLightShadows : lights.spot.size();
+    numRectAreaLights = 0;
+    numHemiLights = lights.hemi.size();
+
     numClippingPlanes = clipping.numPlanes;
     numClipIntersection = clipping.numIntersection;
 
@@ -199,105 +227,124 @@ ProgramParameters::ProgramParameters(
     }
 }
 
-std::string ProgramParameters::hash() const {
-
-    std::stringstream s;
-
-    s << std::to_string(instancing) << '\n';
-    s << std::to_string(instancingColor) << '\n';
-
-    s << std::to_string(supportsVertexTextures) << '\n';
-    s << std::to_string(as_integer(outputEncoding)) << '\n';
-    s << std::to_string(map) << '\n';
-    s << std::to_string(as_integer(mapEncoding)) << '\n';
-    s << std::to_string(matcap) << '\n';
-    s << std::to_string(as_integer(matcapEncoding)) << '\n';
-    s << std::to_string(envMap) << '\n';
-    s << std::to_string(as_integer(envMapEncoding)) << '\n';
-    s << std::to_string(envMapMode) << '\n';
-    s << std::to_string(as_integer(envMapEncoding)) << '\n';
-    s << std::to_string(envMapCubeUV) << '\n';
-    s << std::to_string(lightMap) << '\n';
-    s << std::to_string(as_integer(lightMapEncoding)) << '\n';
-    s << std::to_string(aoMap) << '\n';
-    s << std::to_string(emissiveMap) << '\n';
-    s << std::to_string(as_integer(emissiveMapEncoding)) << '\n';
-    s << std::to_string(bumpMap) << '\n';
-    s << std::to_string(normalMap) << '\n';
-    s << std::to_string(objectSpaceNormalMap) << '\n';
-    s << std::to_string(tangentSpaceNormalMap) << '\n';
-    s << std::to_string(clearcoatMap) << '\n';
-    s << std::to_string(clearcoatRoughnessMap) << '\n';
-    s << std::to_string(clearcoatNormalMap) << '\n';
-    s << std::to_string(displacementMap) << '\n';
-    s << std::to_string(roughnessMap) << '\n';
-    s << std::to_string(metalnessMap) << '\n';
-    s << std::to_string(specularMap) << '\n';
-    s << std::to_string(alphaMap) << '\n';
-
-    s << std::to_string(gradientMap) << '\n';
-
-    if (sheen.has_value()) {
-        s << *sheen << '\n';
-    } else {
-        s << "undefined \n";
-    }
-
-    s << std::to_string(transmission) << '\n';
-    s << std::to_string(transmissionMap) << '\n';
-    s << std::to_string(thicknessMap) << '\n';
-
-    s << (combine.has_value() ? std::to_string(as_integer(*combine)) : std::string("undefined")) << '\n';
-
-    s << std::to_string(vertexTangents) << '\n';
-    s << std::to_string(vertexColors) << '\n';
-    s << std::to_string(vertexAlphas) << '\n';
-    s << std::to_string(vertexUvs) << '\n';
-    s << std::to_string(uvsVertexOnly) << '\n';
-
-    s << std::to_string(fog) << '\n';
-    s << std::to_string(useFog) << '\n';
-    s << std::to_string(fogExp2) << '\n';
-
-    s << std::to_string(flatShading) << '\n';
-
-    s << std::to_string(sizeAttenuation) << '\n';
-    s << std::to_string(logarithmicDepthBuffer) << '\n';
+void ProgramParameters::writeKey(std::string& out) const {
 
-    s << std::to_string(morphTargets) << '\n';
-    s << std::to_string(morphNormals) << '\n';
+    KeyWriter w{out};
 
-    s << std::to_string(skinning) << '\n';
-    s << std::to_string(useVertexTexture) << '\n';
+    if (shaderID) {
 
-    s << std::to_string(numDirLights) << '\n';
-    s << std::to_string(numPointLights) << '\n';
-    s << std::to_string(numSpotLights) << '\n';
-    s << std::to_string(numRectAreaLights) << '\n';
-    s << std::to_string(numHemiLights) << '\n';
+        w.write(*shaderID);
 
-    s << std::to_string(numDirLightShadows) << '\n';
-    s << std::to_string(numPointLightShadows) << '\n';
-    s << std::to_string(numSpotLightShadows) << '\n';
-
-    s << std::to_string(numClippingPlanes) << '\n';
-    s << std::to_string(numClipIntersection) << '\n';
-
-    s << std::to_string(dithering) << '\n';
-
-    s << std::to_string(shadowMapEnabled) << '\n';
-    s << std::to_string(as_integer(shadowMapType)) << '\n';
-
-    s << std::to_string(as_integer(toneMapping)) << '\n';
-    s << std::to_string(physicallyCorrectLights) << '\n';
+    } else {
 
-    s << std::to_string(premultipliedAlpha) << '\n';
+        w.write(fragmentShader);
+        w.write(vertexShader);
+    }
 
-    s << std::to_string(alphaTest) << '\n';
-    s << std::to_string(doubleSided) << '\n';
-    s << std::to_string(flipSided) << '\n';
+    w.write(defines.size());
+    for (const auto& [name, value] : defines) {
 
-    s << std::to_string(depthPacking) << '\n';
+        w.write(name);
+        w.write(value);
+    }
 
-    return s.str();
+    if (isRawShaderMaterial) return;
+
+    w.write(instancing);
+    w.write(instancingColor);
+    w.write(batching);
+
+    w.write(supportsVertexTextures);
+    w.write(outputEncoding);
+    w.write(map);
+    w.write(mapEncoding);
+    w.write(matcap);
+    w.write(matcapEncoding);
+    w.write(envMap);
+    w.write(envMapEncoding);
+    w.write(envMapMode);
+    w.write(envMapCubeUV);
+    w.write(lightMap);
+    w.write(lightMapEncoding);
+    w.write(aoMap);
+    w.write(emissiveMap);
+    w.write(emissiveMapEncoding);
+    w.write(bumpMap);
+    w.write(normalMap);
+    w.write(objectSpaceNormalMap);
+    w.write(tangentSpaceNormalMap);
+    w.write(clearcoatMap);
+    w.write(clearcoatRoughnessMap);
+    w.write(clearcoatNormalMap);
+    w.write(displacementMap);
+    w.write(roughnessMap);
+    w.write(metalnessMap);
+    w.write(specularMap);
+    w.write(alphaMap);
+
+    w.write(gradientMap);
+
+    w.write(sheen.has_value());
+    if (sheen) w.write(*sheen);
+
+    w.write(transmission);
+    w.write(transmissionMap);
+    w.write(thicknessMap);
+
+    w.write(combine.has_value());
+    if (combine) w.write(*combine);
+
+    w.write(vertexTangents);
+    w.write(vertexColors);
+    w.write(vertexAlphas);
+    w.write(vertexUvs);
+    w.write(uvsVertexOnly);
+    w.write(octahedralNormals);
+
+    w.write(fog);
+    w.write(useFog);
+    w.write(fogExp2);
+
+    w.write(flatShading);
+
+    w.write(sizeAttenuation);
+    w.write(logarithmicDepthBuffer);
+    w.write(uniformBlocks);
+
+    w.write(morphTargets);
+    w.write(morphNormals);
+
+    w.write(skinning);
+    w.write(useVertexTexture);
+
+    w.write(numDirLights);
+    w.write(numPointLights);
+    w.write(numSpotLights);
+    w.write(numRectAreaLights);
+    w.write(numHemiLights);
+
+    w.write(numDirLightShadows);
+    w.write(numPointLightShadows);
+    w.write(numSpotLightShadows);
+
+    w.write(clusteredLights);
+
+    w.write(numClippingPlanes);
+    w.write(numClipIntersection);
+
+    w.write(dithering);
+
+    w.write(shadowMapEnabled);
+    w.write(shadowMapType);
+
+    w.write(toneMapping);
+    w.write(physicallyCorrectLights);
+
+    w.write(premultipliedAlpha);
+
+    w.write(alphaTest);
+    w.write(doubleSided);
+    w.write(flipSided);
+
+    w.write(depthPacking);
 }
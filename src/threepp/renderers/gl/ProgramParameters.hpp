@@ -33,6 +33,7 @@ namespace threepp {
 
             bool instancing{};
             bool instancingColor{};
+            bool batching{};
 
             bool supportsVertexTextures;
             Encoding outputEncoding{};
@@ -77,6 +78,7 @@ namespace threepp {
             bool vertexAlphas{};
             bool vertexUvs{};
             bool uvsVertexOnly{};
+            bool octahedralNormals{};
 
             bool fog{};
             bool useFog{};
@@ -86,6 +88,7 @@ namespace threepp {
 
             bool sizeAttenuation{};
             bool logarithmicDepthBuffer{};
+            bool uniformBlocks{};
 
             bool skinning{};
             size_t maxBones{};
@@ -104,6 +107,8 @@ namespace threepp {
             size_t numPointLightShadows{};
             size_t numSpotLightShadows{};
 
+            bool clusteredLights{};
+
             int numClippingPlanes{};
             int numClipIntersection{};
 
@@ -137,7 +142,8 @@ namespace threepp {
                     Material* material,
                     const std::unordered_map<std::string, std::string>& shaderIDs);
 
-            [[nodiscard]] std::string hash() const;
+            // Appends the parameters that affect the generated shader code to out, as raw bytes.
+            void writeKey(std::string& out) const;
         };
 
     }// namespace gl
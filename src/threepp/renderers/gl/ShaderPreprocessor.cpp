@@ -0,0 +1,316 @@
+
+#include "threepp/renderers/gl/ShaderPreprocessor.hpp"
+
+#include "threepp/renderers/shaders/ShaderChunk.hpp"
+#include "threepp/utils/StringUtils.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr std::string_view includeDirective = "#include";
+    constexpr std::string_view unrollStart = "#pragma unroll_loop_start";
+    constexpr std::string_view unrollEnd = "#pragma unroll_loop_end";
+    constexpr std::string_view loopIndex = "UNROLLED_LOOP_INDEX";
+
+    // upper bound on cached sources, user supplied ShaderMaterial sources should not grow the cache forever
+    constexpr size_t maxCachedSources = 512;
+
+    // same classes as \s, \d and \w in ECMAScript regular expressions
+
+    inline bool isSpace(char c) {
+
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    inline bool isDigit(char c) {
+
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool isWord(char c) {
+
+        return isDigit(c) || c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    // A forward-only matcher over a string, each method consumes input on success.
+    struct Scanner {
+
+        std::string_view str;
+        size_t pos;
+
+        // \s*
+        void spaces() {
+
+            while (pos < str.size() && isSpace(str[pos])) ++pos;
+        }
+
+        // \s+
+        bool requireSpaces() {
+
+            const auto start = pos;
+            spaces();
+
+            return pos > start;
+        }
+
+        bool literal(std::string_view lit) {
+
+            if (str.compare(pos, lit.size(), lit) != 0) return false;
+            pos += lit.size();
+
+            return true;
+        }
+
+        // (\d+)
+        bool digits(std::string_view& out) {
+
+            const auto start = pos;
+            while (pos < str.size() && isDigit(str[pos])) ++pos;
+            out = str.substr(start, pos - start);
+
+            return pos > start;
+        }
+    };
+
+    // #include +<([\w\d.]+)>, returns the end of the directive and the chunk name
+    bool matchInclude(std::string_view str, size_t pos, size_t& end, std::string_view& name) {
+
+        Scanner s{str, pos + includeDirective.size()};
+
+        const auto spacesStart = s.pos;
+        while (s.pos < str.size() && str[s.pos] == ' ') ++s.pos;
+        if (s.pos == spacesStart || !s.literal("<")) return false;
+
+        const auto nameStart = s.pos;
+        while (s.pos < str.size() && (isWord(str[s.pos]) || str[s.pos] == '.')) ++s.pos;
+        if (s.pos == nameStart) return false;
+
+        name = str.substr(nameStart, s.pos - nameStart);
+        if (!s.literal(">")) return false;
+
+        end = s.pos;
+        return true;
+    }
+
+    std::string expandIncludes(const std::string& str) {
+
+        std::string result;
+        size_t pos = 0;
+
+        for (auto it = str.find(includeDirective); it != std::string::npos; it = str.find(includeDirective, it + 1)) {
+
+            size_t end;
+            std::string_view name;
+            if (!matchInclude(str, it, end, name)) continue;
+
+            const std::string chunkName(name);
+            const std::string* chunk = nullptr;
+            try {
+                chunk = &shaders::ShaderChunk::instance().get(chunkName);
+            } catch (const std::out_of_range&) {
+            }
+
+            if (!chunk || chunk->empty()) {
+                throw std::logic_error("unable to resolve #include <" + chunkName + ">");
+            }
+
+            if (result.empty()) result.reserve(str.size() * 2);
+            result.append(str, pos, it - pos);
+            result.append(*chunk);
+
+            pos = end;
+            it = end - 1;
+        }
+
+        if (pos == 0) return str;
+
+        result.append(str, pos, std::string::npos);
+        return result;
+    }
+
+    // A loop body split into text and index slots, so that each iteration is a plain concatenation.
+    struct LoopBody {
+
+        std::vector<std::string_view> text;// text[k] precedes slot k, the last entry trails the body
+        std::vector<bool> bracketed;       // [ i ] rather than UNROLLED_LOOP_INDEX
+
+        explicit LoopBody(std::string_view body) {
+
+            // \[\s*i\s*\] is replaced first, then UNROLLED_LOOP_INDEX. The two patterns cannot overlap or produce one another,
+            // so both can be located in a single pass over the original body.
+
+            size_t last = 0;
+            size_t pos = 0;
+            while (pos < body.size()) {
+
+                if (body[pos] == '[') {
+
+                    Scanner s{body, pos + 1};
+                    s.spaces();
+                    if (s.literal("i")) {
+
+                        s.spaces();
+                        if (s.literal("]")) {
+
+                            text.emplace_back(body.substr(last, pos - last));
+                            bracketed.emplace_back(true);
+                            pos = last = s.pos;
+                            continue;
+                        }
+                    }
+
+                } else if (body[pos] == loopIndex.front() && body.compare(pos, loopIndex.size(), loopIndex) == 0) {
+
+                    text.emplace_back(body.substr(last, pos - last));
+                    bracketed.emplace_back(false);
+                    pos = last = pos + loopIndex.size();
+                    continue;
+                }
+
+                ++pos;
+            }
+
+            text.emplace_back(body.substr(last));
+        }
+
+        void append(std::string& out, int index) const {
+
+            const auto indexStr = std::to_string(index);
+
+            for (size_t k = 0; k < bracketed.size(); k++) {
+
+                out.append(text[k]);
+                if (bracketed[k]) {
+
+                    out.append("[ ").append(indexStr).append(" ]");
+
+                } else {
+
+                    out.append(indexStr);
+                }
+            }
+
+            out.append(text.back());
+        }
+    };
+
+    struct LoopMatch {
+
+        size_t end;
+        std::string_view start;
+        std::string_view stop;
+        std::string_view body;
+    };
+
+    // #pragma unroll_loop_start\s+for\s*\(\s*int\s+i\s*=\s*(\d+)\s*;\s*i\s*<\s*(\d+)\s*;\s*i\s*\+\+\s*\)\s*\{([\s\S]+?)\}\s+#pragma unroll_loop_end
+    bool matchLoop(std::string_view str, size_t pos, LoopMatch& match) {
+
+        Scanner s{str, pos + unrollStart.size()};
+
+        if (!s.requireSpaces() || !s.literal("for")) return false;
+        s.spaces();
+        if (!s.literal("(")) return false;
+        s.spaces();
+        if (!s.literal("int") || !s.requireSpaces() || !s.literal("i")) return false;
+        s.spaces();
+        if (!s.literal("=")) return false;
+        s.spaces();
+        if (!s.digits(match.start)) return false;
+        s.spaces();
+        if (!s.literal(";")) return false;
+        s.spaces();
+        if (!s.literal("i")) return false;
+        s.spaces();
+        if (!s.literal("<")) return false;
+        s.spaces();
+        if (!s.digits(match.stop)) return false;
+        s.spaces();
+        if (!s.literal(";")) return false;
+        s.spaces();
+        if (!s.literal("i")) return false;
+        s.spaces();
+        if (!s.literal("++")) return false;
+        s.spaces();
+        if (!s.literal(")")) return false;
+        s.spaces();
+        if (!s.literal("{")) return false;
+
+        const auto bodyStart = s.pos;
+
+        // the body is lazy and non-empty: stop at the first closing brace followed by whitespace and the end pragma
+        for (auto close = str.find('}', bodyStart + 1); close != std::string_view::npos; close = str.find('}', close + 1)) {
+
+            Scanner e{str, close + 1};
+            if (e.requireSpaces() && e.literal(unrollEnd)) {
+
+                match.body = str.substr(bodyStart, close - bodyStart);
+                match.end = e.pos;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+}// namespace
+
+std::string gl::resolveIncludes(const std::string& source) {
+
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::string> cache;
+
+    {
+        std::lock_guard lock(mutex);
+        if (const auto it = cache.find(source); it != cache.end()) {
+
+            return it->second;
+        }
+    }
+
+    auto result = expandIncludes(source);
+
+    std::lock_guard lock(mutex);
+    if (cache.size() >= maxCachedSources) cache.clear();
+    cache.emplace(source, result);
+
+    return result;
+}
+
+std::string gl::unrollLoops(const std::string& source) {
+
+    std::string result;
+    size_t pos = 0;
+
+    for (auto it = source.find(unrollStart); it != std::string::npos; it = source.find(unrollStart, it + 1)) {
+
+        LoopMatch match{};
+        if (!matchLoop(source, it, match)) continue;
+
+        if (result.empty()) result.reserve(source.size() * 2);
+        result.append(source, pos, it - pos);
+
+        const auto start = utils::parseInt(std::string(match.start));
+        const auto end = utils::parseInt(std::string(match.stop));
+
+        const LoopBody body(match.body);
+        for (int i = start; i < end; ++i) {
+
+            body.append(result, i);
+        }
+
+        pos = match.end;
+        it = match.end - 1;
+    }
+
+    if (pos == 0) return source;
+
+    result.append(source, pos, std::string::npos);
+    return result;
+}
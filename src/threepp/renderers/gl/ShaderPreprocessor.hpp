@@ -0,0 +1,22 @@
+
+#ifndef THREEPP_SHADERPREPROCESSOR_HPP
+#define THREEPP_SHADERPREPROCESSOR_HPP
+
+#include <string>
+
+namespace threepp::gl {
+
+    // Replaces every "#include <name>" with the corresponding ShaderChunk.
+    // Results are cached by source, as the same ShaderLib sources are expanded for every program variant.
+    std::string resolveIncludes(const std::string& source);
+
+    // Expands loops of the form
+    //   #pragma unroll_loop_start
+    //   for ( int i = 0; i < N; i ++ ) { ... }
+    //   #pragma unroll_loop_end
+    // replacing [ i ] and UNROLLED_LOOP_INDEX with the iteration index.
+    std::string unrollLoops(const std::string& source);
+
+}// namespace threepp::gl
+
+#endif//THREEPP_SHADERPREPROCESSOR_HPP
@@ -7,6 +7,11 @@
 using namespace threepp;
 
 
+Scene::Scene() {
+
+    addKind(this);
+}
+
 std::shared_ptr<Scene> Scene::create() {
 
     return std::make_shared<Scene>();
@@ -0,0 +1,596 @@
+
+#include "threepp/textures/CompressedTextureDecoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace threepp;
+
+namespace {
+
+    // a decoded 4x4 block, RGBA pixels in row-major order
+    using Block = std::array<std::array<unsigned char, 4>, 16>;
+
+    unsigned char clampByte(int value) {
+
+        return static_cast<unsigned char>(std::clamp(value, 0, 255));
+    }
+
+    // BC1-5
+
+    void expand565(uint16_t color, int* rgb) {
+
+        const auto r = (color >> 11) & 31;
+        const auto g = (color >> 5) & 63;
+        const auto b = color & 31;
+
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    // transparent: the three color mode (c0 <= c1) has a transparent fourth color, as in RGBA DXT1.
+    // fourColors: c0 <= c1 is not looked at, as for the color part of DXT5.
+    void decodeBC1(const unsigned char* data, Block& out, bool transparent, bool fourColors) {
+
+        const uint16_t c0 = data[0] | (data[1] << 8);
+        const uint16_t c1 = data[2] | (data[3] << 8);
+
+        int colors[4][4];
+        expand565(c0, colors[0]);
+        expand565(c1, colors[1]);
+        colors[0][3] = colors[1][3] = colors[2][3] = colors[3][3] = 255;
+
+        for (unsigned c = 0; c < 3; c++) {
+
+            if (c0 > c1 || fourColors) {
+
+                colors[2][c] = (2 * colors[0][c] + colors[1][c] + 1) / 3;
+                colors[3][c] = (colors[0][c] + 2 * colors[1][c] + 1) / 3;
+
+            } else {
+
+                colors[2][c] = (colors[0][c] + colors[1][c]) / 2;
+                colors[3][c] = 0;
+            }
+        }
+
+        if (c0 <= c1 && !fourColors && transparent) colors[3][3] = 0;
+
+        const uint32_t indices = data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<uint32_t>(data[7]) << 24);
+
+        for (unsigned i = 0; i < 16; i++) {
+
+            const auto& color = colors[(indices >> (2 * i)) & 3];
+            for (unsigned c = 0; c < 4; c++) out[i][c] = static_cast<unsigned char>(color[c]);
+        }
+    }
+
+    // one channel, as in BC4, BC5 and the alpha of BC3
+    void decodeBC4(const unsigned char* data, Block& out, unsigned channel) {
+
+        const int v0 = data[0];
+        const int v1 = data[1];
+
+        int values[8]{v0, v1};
+
+        if (v0 > v1) {
+
+            for (int i = 1; i < 7; i++) values[i + 1] = ((7 - i) * v0 + i * v1 + 3) / 7;
+
+        } else {
+
+            for (int i = 1; i < 5; i++) values[i + 1] = ((5 - i) * v0 + i * v1 + 2) / 5;
+            values[6] = 0;
+            values[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (unsigned i = 0; i < 6; i++) indices |= static_cast<uint64_t>(data[2 + i]) << (8 * i);
+
+        for (unsigned i = 0; i < 16; i++) {
+
+            out[i][channel] = static_cast<unsigned char>(values[(indices >> (3 * i)) & 7]);
+        }
+    }
+
+    // BC7
+
+    struct BC7Mode {
+
+        int subsets;
+        int partitionBits;
+        int rotationBits;
+        int indexSelectionBits;
+        int colorBits;
+        int alphaBits;
+        int endpointPBits;
+        int sharedPBits;
+        int indexBits;
+        int indexBits2;
+    };
+
+    constexpr BC7Mode bc7Modes[8]{
+            {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+            {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+            {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+            {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+            {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+            {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+            {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+            {2, 6, 0, 0, 5, 5, 1, 0, 2, 0}};
+
+    // subset of each pixel, one bit per pixel
+    constexpr uint16_t bc7Partitions2[64]{
+            0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+            0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+            0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+            0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+            0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+            0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+            0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+            0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22};
+
+    // subset of each pixel, two bits per pixel
+    constexpr uint32_t bc7Partitions3[64]{
+            0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+            0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+            0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+            0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+            0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+            0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+            0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+            0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254};
+
+    // pixels whose index has one bit less, besides pixel 0
+    constexpr uint8_t bc7Anchors2[64]{
+            15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+            15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+            15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+            6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15};
+
+    constexpr uint8_t bc7Anchors3a[64]{
+            3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+            3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+            8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+            3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3};
+
+    constexpr uint8_t bc7Anchors3b[64]{
+            15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+            15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+            15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+            15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8};
+
+    constexpr int bc7Weights2[4]{0, 21, 43, 64};
+    constexpr int bc7Weights3[8]{0, 9, 18, 27, 37, 46, 55, 64};
+    constexpr int bc7Weights4[16]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct BitReader {
+
+        const unsigned char* data;
+        unsigned int position;
+
+        unsigned int read(int count) {
+
+            unsigned int value = 0;
+            for (int i = 0; i < count; i++, position++) {
+                value |= ((data[position >> 3] >> (position & 7)) & 1u) << i;
+            }
+
+            return value;
+        }
+    };
+
+    int bc7Interpolate(int e0, int e1, unsigned int index, int indexBits) {
+
+        const auto weight = indexBits == 2 ? bc7Weights2[index] : indexBits == 3 ? bc7Weights3[index] : bc7Weights4[index];
+
+        return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+    }
+
+    void decodeBC7(const unsigned char* data, Block& out) {
+
+        unsigned int mode = 0;
+        while (mode < 8 && !(data[0] & (1u << mode))) mode++;
+
+        if (mode == 8) {
+            // reserved, decodes to transparent black
+            out = {};
+            return;
+        }
+
+        const auto& m = bc7Modes[mode];
+        BitReader bits{data, mode + 1};
+
+        const auto partition = bits.read(m.partitionBits);
+        const auto rotation = bits.read(m.rotationBits);
+        const auto indexSelection = bits.read(m.indexSelectionBits);
+
+        const int endpointCount = m.subsets * 2;
+        int endpoints[6][4];
+
+        for (int c = 0; c < 3; c++) {
+            for (int e = 0; e < endpointCount; e++) endpoints[e][c] = static_cast<int>(bits.read(m.colorBits));
+        }
+        for (int e = 0; e < endpointCount; e++) endpoints[e][3] = m.alphaBits ? static_cast<int>(bits.read(m.alphaBits)) : 255;
+
+        int colorBits = m.colorBits;
+        int alphaBits = m.alphaBits;
+        const int channels = alphaBits ? 4 : 3;
+
+        if (m.endpointPBits || m.sharedPBits) {
+
+            unsigned int pBits[6];
+            if (m.endpointPBits) {
+                for (int e = 0; e < endpointCount; e++) pBits[e] = bits.read(1);
+            } else {
+                for (int s = 0; s < m.subsets; s++) pBits[2 * s] = pBits[2 * s + 1] = bits.read(1);
+            }
+
+            for (int e = 0; e < endpointCount; e++) {
+                for (int c = 0; c < channels; c++) endpoints[e][c] = (endpoints[e][c] << 1) | static_cast<int>(pBits[e]);
+            }
+
+            colorBits++;
+            if (alphaBits) alphaBits++;
+        }
+
+        for (int e = 0; e < endpointCount; e++) {
+
+            for (int c = 0; c < channels; c++) {
+
+                const auto count = c < 3 ? colorBits : alphaBits;
+                const auto value = endpoints[e][c] << (8 - count);
+                endpoints[e][c] = value | (value >> count);
+            }
+        }
+
+        const auto subsetOf = [&](unsigned int i) -> unsigned int {
+            if (m.subsets == 2) return (bc7Partitions2[partition] >> i) & 1;
+            if (m.subsets == 3) return (bc7Partitions3[partition] >> (2 * i)) & 3;
+            return 0;
+        };
+
+        const auto isAnchor = [&](unsigned int i) {
+            if (i == 0) return true;
+            if (m.subsets == 2) return i == bc7Anchors2[partition];
+            if (m.subsets == 3) return i == bc7Anchors3a[partition] || i == bc7Anchors3b[partition];
+            return false;
+        };
+
+        unsigned int indices[16];
+        unsigned int indices2[16];
+
+        for (unsigned int i = 0; i < 16; i++) indices[i] = bits.read(m.indexBits - (isAnchor(i) ? 1 : 0));
+        if (m.indexBits2) {
+            for (unsigned int i = 0; i < 16; i++) indices2[i] = bits.read(m.indexBits2 - (i == 0 ? 1 : 0));
+        }
+
+        for (unsigned int i = 0; i < 16; i++) {
+
+            const auto subset = subsetOf(i);
+            const auto& e0 = endpoints[2 * subset];
+            const auto& e1 = endpoints[2 * subset + 1];
+
+            auto colorIndex = indices[i];
+            auto colorIndexBits = m.indexBits;
+            auto alphaIndex = m.indexBits2 ? indices2[i] : indices[i];
+            auto alphaIndexBits = m.indexBits2 ? m.indexBits2 : m.indexBits;
+
+            if (indexSelection) {
+                std::swap(colorIndex, alphaIndex);
+                std::swap(colorIndexBits, alphaIndexBits);
+            }
+
+            int pixel[4];
+            for (int c = 0; c < 3; c++) pixel[c] = bc7Interpolate(e0[c], e1[c], colorIndex, colorIndexBits);
+            pixel[3] = bc7Interpolate(e0[3], e1[3], alphaIndex, alphaIndexBits);
+
+            if (rotation > 0) std::swap(pixel[3], pixel[rotation - 1]);
+
+            for (int c = 0; c < 4; c++) out[i][c] = static_cast<unsigned char>(pixel[c]);
+        }
+    }
+
+    // ETC2
+
+    constexpr int etc1Modifiers[8][4]{
+            {2, 8, -2, -8},
+            {5, 17, -5, -17},
+            {9, 29, -9, -29},
+            {13, 42, -13, -42},
+            {18, 60, -18, -60},
+            {24, 80, -24, -80},
+            {33, 106, -33, -106},
+            {47, 183, -47, -183}};
+
+    constexpr int etc2Distances[8]{3, 6, 11, 16, 23, 32, 41, 64};
+
+    constexpr int eacModifiers[16][8]{
+            {-3, -6, -9, -15, 2, 5, 8, 14},
+            {-3, -7, -10, -13, 2, 6, 9, 12},
+            {-2, -5, -8, -13, 1, 4, 7, 12},
+            {-2, -4, -6, -13, 1, 3, 5, 12},
+            {-3, -6, -8, -12, 2, 5, 7, 11},
+            {-3, -7, -9, -11, 2, 6, 8, 10},
+            {-4, -7, -8, -11, 3, 6, 7, 10},
+            {-3, -5, -8, -11, 2, 4, 7, 10},
+            {-2, -6, -8, -10, 1, 5, 7, 9},
+            {-2, -5, -8, -10, 1, 4, 7, 9},
+            {-2, -4, -8, -10, 1, 3, 7, 9},
+            {-2, -5, -7, -10, 1, 4, 6, 9},
+            {-3, -4, -7, -10, 2, 3, 6, 9},
+            {-1, -2, -3, -10, 0, 1, 2, 9},
+            {-4, -6, -8, -9, 3, 5, 7, 8},
+            {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+    int signExtend3(int value) {
+
+        return value >= 4 ? value - 8 : value;
+    }
+
+    int expand4(int value) {
+
+        return value * 17;
+    }
+
+    int expand5(int value) {
+
+        return (value << 3) | (value >> 2);
+    }
+
+    int expand6(int value) {
+
+        return (value << 2) | (value >> 4);
+    }
+
+    int expand7(int value) {
+
+        return (value << 1) | (value >> 6);
+    }
+
+    void decodeETC2(const unsigned char* data, Block& out) {
+
+        const uint32_t low = (static_cast<uint32_t>(data[4]) << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+
+        // 2-bit index of pixel x, y, the pixels being stored column by column
+        const auto pixelIndex = [&](unsigned int x, unsigned int y) {
+            const auto k = x * 4 + y;
+            return (((low >> (k + 16)) & 1) << 1) | ((low >> k) & 1);
+        };
+
+        const auto paint = [&](const int (&colors)[4][3]) {
+            for (unsigned int y = 0; y < 4; y++) {
+                for (unsigned int x = 0; x < 4; x++) {
+                    const auto& color = colors[pixelIndex(x, y)];
+                    out[y * 4 + x] = {clampByte(color[0]), clampByte(color[1]), clampByte(color[2]), 255};
+                }
+            }
+        };
+
+        const bool differential = data[3] & 2;
+        const bool flip = data[3] & 1;
+
+        int base1[3], base2[3];
+
+        if (!differential) {
+
+            for (unsigned int c = 0; c < 3; c++) {
+                base1[c] = expand4(data[c] >> 4);
+                base2[c] = expand4(data[c] & 15);
+            }
+
+        } else {
+
+            int base[3], delta[3];
+            for (unsigned int c = 0; c < 3; c++) {
+                base[c] = data[c] >> 3;
+                delta[c] = base[c] + signExtend3(data[c] & 7);
+            }
+
+            if (delta[0] < 0 || delta[0] > 31) {
+
+                // T mode
+                const int r1 = (((data[0] >> 3) & 3) << 2) | (data[0] & 3);
+                const int c1[3]{expand4(r1), expand4(data[1] >> 4), expand4(data[1] & 15)};
+                const int c2[3]{expand4(data[2] >> 4), expand4(data[2] & 15), expand4(data[3] >> 4)};
+                const int d = etc2Distances[(((data[3] >> 2) & 3) << 1) | (data[3] & 1)];
+
+                const int colors[4][3]{
+                        {c1[0], c1[1], c1[2]},
+                        {c2[0] + d, c2[1] + d, c2[2] + d},
+                        {c2[0], c2[1], c2[2]},
+                        {c2[0] - d, c2[1] - d, c2[2] - d}};
+                paint(colors);
+                return;
+            }
+
+            if (delta[1] < 0 || delta[1] > 31) {
+
+                // H mode
+                const int r1 = (data[0] >> 3) & 15;
+                const int g1 = ((data[0] & 7) << 1) | ((data[1] >> 4) & 1);
+                const int b1 = (((data[1] >> 3) & 1) << 3) | ((data[1] & 3) << 1) | (data[2] >> 7);
+                const int r2 = (data[2] >> 3) & 15;
+                const int g2 = ((data[2] & 7) << 1) | (data[3] >> 7);
+                const int b2 = (data[3] >> 3) & 15;
+
+                const bool ordered = ((r1 << 8) | (g1 << 4) | b1) >= ((r2 << 8) | (g2 << 4) | b2);
+                const int d = etc2Distances[(((data[3] >> 2) & 1) << 2) | ((data[3] & 1) << 1) | (ordered ? 1 : 0)];
+
+                const int c1[3]{expand4(r1), expand4(g1), expand4(b1)};
+                const int c2[3]{expand4(r2), expand4(g2), expand4(b2)};
+
+                const int colors[4][3]{
+                        {c1[0] + d, c1[1] + d, c1[2] + d},
+                        {c1[0] - d, c1[1] - d, c1[2] - d},
+                        {c2[0] + d, c2[1] + d, c2[2] + d},
+                        {c2[0] - d, c2[1] - d, c2[2] - d}};
+                paint(colors);
+                return;
+            }
+
+            if (delta[2] < 0 || delta[2] > 31) {
+
+                // planar mode, a gradient through the origin, horizontal and vertical colors
+                const int origin[3]{
+                        expand6((data[0] >> 1) & 63),
+                        expand7(((data[0] & 1) << 6) | ((data[1] >> 1) & 63)),
+                        expand6(((data[1] & 1) << 5) | (((data[2] >> 3) & 3) << 3) | ((data[2] & 3) << 1) | (data[3] >> 7))};
+                const int horizontal[3]{
+                        expand6((((data[3] >> 2) & 31) << 1) | (data[3] & 1)),
+                        expand7(static_cast<int>((low >> 25) & 127)),
+                        expand6(static_cast<int>((low >> 19) & 63))};
+                const int vertical[3]{
+                        expand6(static_cast<int>((low >> 13) & 63)),
+                        expand7(static_cast<int>((low >> 6) & 127)),
+                        expand6(static_cast<int>(low & 63))};
+
+                for (int y = 0; y < 4; y++) {
+                    for (int x = 0; x < 4; x++) {
+                        auto& pixel = out[y * 4 + x];
+                        for (unsigned int c = 0; c < 3; c++) {
+                            pixel[c] = clampByte((x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2);
+                        }
+                        pixel[3] = 255;
+                    }
+                }
+                return;
+            }
+
+            for (unsigned int c = 0; c < 3; c++) {
+                base1[c] = expand5(base[c]);
+                base2[c] = expand5(delta[c]);
+            }
+        }
+
+        // individual and differential modes, two sub-blocks side by side (or on top of each other when flipped)
+
+        const int table1 = data[3] >> 5;
+        const int table2 = (data[3] >> 2) & 7;
+
+        for (unsigned int y = 0; y < 4; y++) {
+            for (unsigned int x = 0; x < 4; x++) {
+
+                const bool second = flip ? y >= 2 : x >= 2;
+                const auto& base = second ? base2 : base1;
+                const auto modifier = etc1Modifiers[second ? table2 : table1][pixelIndex(x, y)];
+
+                out[y * 4 + x] = {clampByte(base[0] + modifier), clampByte(base[1] + modifier), clampByte(base[2] + modifier), 255};
+            }
+        }
+    }
+
+    void decodeEACAlpha(const unsigned char* data, Block& out) {
+
+        const int base = data[0];
+        const int multiplier = data[1] >> 4;
+        const auto& modifiers = eacModifiers[data[1] & 15];
+
+        uint64_t indices = 0;
+        for (unsigned int i = 2; i < 8; i++) indices = (indices << 8) | data[i];
+
+        for (unsigned int k = 0; k < 16; k++) {
+
+            const auto index = (indices >> (45 - 3 * k)) & 7;
+            out[(k % 4) * 4 + k / 4][3] = clampByte(base + modifiers[index] * multiplier);
+        }
+    }
+
+    void decodeBlock(Format format, const unsigned char* data, Block& out) {
+
+        switch (format) {
+            case Format::RGB_S3TC_DXT1:
+                decodeBC1(data, out, false, false);
+                break;
+            case Format::RGBA_S3TC_DXT1:
+                decodeBC1(data, out, true, false);
+                break;
+            case Format::RGBA_S3TC_DXT5:
+                decodeBC1(data + 8, out, false, true);
+                decodeBC4(data, out, 3);
+                break;
+            case Format::RED_RGTC1:
+                out.fill({0, 0, 0, 255});
+                decodeBC4(data, out, 0);
+                break;
+            case Format::RED_GREEN_RGTC2:
+                out.fill({0, 0, 0, 255});
+                decodeBC4(data, out, 0);
+                decodeBC4(data + 8, out, 1);
+                break;
+            case Format::RGBA_BPTC:
+                decodeBC7(data, out);
+                break;
+            case Format::RGB_ETC2:
+                decodeETC2(data, out);
+                break;
+            case Format::RGBA_ETC2_EAC:
+                decodeETC2(data + 8, out);
+                decodeEACAlpha(data, out);
+                break;
+            default:
+                throw std::runtime_error("[CompressedTextureDecoder] Not a compressed format");
+        }
+    }
+
+}// namespace
+
+
+size_t threepp::compressedBlockBytes(Format format) {
+
+    switch (format) {
+        case Format::RGB_S3TC_DXT1:
+        case Format::RGBA_S3TC_DXT1:
+        case Format::RED_RGTC1:
+        case Format::RGB_ETC2:
+            return 8;
+        case Format::RGBA_S3TC_DXT5:
+        case Format::RED_GREEN_RGTC2:
+        case Format::RGBA_BPTC:
+        case Format::RGBA_ETC2_EAC:
+            return 16;
+        default:
+            throw std::runtime_error("[CompressedTextureDecoder] Not a compressed format");
+    }
+}
+
+size_t threepp::compressedLevelBytes(Format format, unsigned int width, unsigned int height) {
+
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * compressedBlockBytes(format);
+}
+
+std::vector<unsigned char> threepp::decompressImage(Format format, const unsigned char* data, unsigned int width, unsigned int height) {
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+
+    const auto blocksX = (width + 3) / 4;
+    const auto blocksY = (height + 3) / 4;
+    const auto blockBytes = compressedBlockBytes(format);
+
+    Block block;
+
+    for (unsigned int by = 0; by < blocksY; by++) {
+
+        for (unsigned int bx = 0; bx < blocksX; bx++) {
+
+            decodeBlock(format, data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes, block);
+
+            // blocks on the right and bottom edges may hang over the level
+            const auto columns = std::min(4u, width - bx * 4);
+            const auto rows = std::min(4u, height - by * 4);
+
+            for (unsigned int y = 0; y < rows; y++) {
+
+                auto target = pixels.data() + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4) * 4;
+                for (unsigned int x = 0; x < columns; x++) {
+                    std::copy(block[y * 4 + x].begin(), block[y * 4 + x].end(), target + x * 4);
+                }
+            }
+        }
+    }
+
+    return pixels;
+}
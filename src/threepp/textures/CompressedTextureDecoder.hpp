@@ -0,0 +1,24 @@
+
+#ifndef THREEPP_COMPRESSEDTEXTUREDECODER_HPP
+#define THREEPP_COMPRESSEDTEXTUREDECODER_HPP
+
+#include "threepp/constants.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace threepp {
+
+    // Bytes per 4x4 block of a compressed format.
+    size_t compressedBlockBytes(Format format);
+
+    // Bytes of a width x height level of a compressed format, partial blocks included.
+    size_t compressedLevelBytes(Format format, unsigned int width, unsigned int height);
+
+    // Decodes a level of a compressed format into RGBA bytes, for GPUs without support for the format.
+    // Red and red-green formats fill the remaining channels as sampling them would (0 for green and blue, 255 for alpha).
+    std::vector<unsigned char> decompressImage(Format format, const unsigned char* data, unsigned int width, unsigned int height);
+
+}// namespace threepp
+
+#endif//THREEPP_COMPRESSEDTEXTUREDECODER_HPP
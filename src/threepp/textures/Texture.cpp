@@ -22,6 +22,14 @@ std::shared_ptr<Texture> Texture::create(const Image& image) {
     return std::shared_ptr<Texture>(new Texture({image}));
 }
 
+std::shared_ptr<Texture> Texture::create(Image&& image) {
+
+    std::vector<Image> images;
+    images.emplace_back(std::move(image));
+
+    return std::shared_ptr<Texture>(new Texture(std::move(images)));
+}
+
 std::shared_ptr<Texture> Texture::create(std::vector<Image> image) {
 
     return std::shared_ptr<Texture>(new Texture(std::move(image)));
@@ -191,6 +199,7 @@ Texture& Texture::copy(const Texture& source) {
     this->premultiplyAlpha = source.premultiplyAlpha;
     this->unpackAlignment = source.unpackAlignment;
     this->encoding = source.encoding;
+    this->releaseDataAfterUpload = source.releaseDataAfterUpload;
 
     return *this;
 }
@@ -1,7 +1,11 @@
 
 #include "threepp/utils/BufferGeometryUtils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 
 using namespace threepp;
 
@@ -53,6 +57,78 @@ namespace {
         return TypedBufferAttribute<T>::create(array, itemSize.value(), normalized.value());
     }
 
+    template<typename T>
+    inline bool tryMergeBufferAttributes(const std::vector<BufferAttribute*>& attributes, std::unique_ptr<BufferAttribute>& result) {
+
+        if (!attributes.front()->typed<T>()) return false;
+
+        std::vector<TypedBufferAttribute<T>*> typed;
+        for (auto& a : attributes) {
+
+            auto t = a->typed<T>();
+            if (!t) return true;// mixed types can not be merged, result stays empty
+
+            typed.emplace_back(t);
+        }
+
+        result = mergeBufferAttributes<T>(typed);
+
+        return true;
+    }
+
+    template<typename T>
+    std::vector<T> quantize(const FloatBufferAttribute& attribute, Vector3 offset, float scale) {
+
+        constexpr auto maxValue = static_cast<float>(std::numeric_limits<T>::max());
+
+        const auto& array = attribute.array();
+        std::vector<T> result(array.size());
+        for (size_t i = 0; i < array.size(); i++) {
+
+            const auto value = (array[i] - offset[static_cast<unsigned>(i % 3)]) / scale;
+            result[i] = static_cast<T>(std::round(std::clamp(value, 0.f, 1.f) * maxValue));
+        }
+
+        return result;
+    }
+
+    template<typename T>
+    std::vector<T> octahedralEncode(const FloatBufferAttribute& attribute) {
+
+        constexpr auto maxValue = static_cast<float>(std::numeric_limits<T>::max());
+
+        const auto signNotZero = [](float v) { return v >= 0 ? 1.f : -1.f; };
+
+        std::vector<T> result(attribute.count() * 2);
+        for (auto i = 0; i < attribute.count(); i++) {
+
+            auto x = attribute.getX(i);
+            auto y = attribute.getY(i);
+            const auto z = attribute.getZ(i);
+
+            // project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+            const auto l1 = std::abs(x) + std::abs(y) + std::abs(z);
+            if (l1 > 0) {
+
+                x /= l1;
+                y /= l1;
+            }
+
+            if (z < 0) {
+
+                const auto fx = (1 - std::abs(y)) * signNotZero(x);
+                const auto fy = (1 - std::abs(x)) * signNotZero(y);
+                x = fx;
+                y = fy;
+            }
+
+            result[i * 2 + 0] = static_cast<T>(std::round(std::clamp(x, -1.f, 1.f) * maxValue));
+            result[i * 2 + 1] = static_cast<T>(std::round(std::clamp(y, -1.f, 1.f) * maxValue));
+        }
+
+        return result;
+    }
+
 }// namespace
 
 std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector<BufferGeometry*>& geometries, bool useGroups) {
@@ -114,9 +190,9 @@ std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector
 
                 count = geometry->getIndex()->count();
 
-            } else if (geometry->getAttribute<float>("position")) {
+            } else if (geometry->hasAttribute("position")) {
 
-                count = geometry->getAttribute<float>("position")->count();
+                count = geometry->getAttribute("position")->count();
 
             } else {
 
@@ -146,7 +222,7 @@ std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector
                 mergedIndex.emplace_back(index->getX(j) + indexOffset);
             }
 
-            indexOffset += geometry->getAttribute<float>("position")->count();
+            indexOffset += geometry->getAttribute("position")->count();
         }
 
         mergedGeometry->setIndex(mergedIndex);
@@ -157,19 +233,13 @@ std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector
     for (const auto& [name, attr] : attributes) {
 
         std::unique_ptr<BufferAttribute> mergedAttribute;
-        if (attr.front()->typed<unsigned int>()) {
-            std::vector<TypedBufferAttribute<unsigned int>*> typed;
-            for (auto& a : attr) {
-                typed.emplace_back(a->typed<unsigned int>());
-            }
-            mergedAttribute = mergeBufferAttributes<unsigned int>(typed);
-        } else if (attr.front()->typed<float>()) {
-            std::vector<TypedBufferAttribute<float>*> typed;
-            for (auto& a : attr) {
-                typed.emplace_back(a->typed<float>());
-            }
-            mergedAttribute = mergeBufferAttributes<float>(typed);
-        }
+        tryMergeBufferAttributes<float>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<unsigned int>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<uint16_t>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<HalfFloat>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<int16_t>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<uint8_t>(attr, mergedAttribute) ||
+                tryMergeBufferAttributes<int8_t>(attr, mergedAttribute);
 
         if (!mergedAttribute) {
 
@@ -194,3 +264,72 @@ std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector
 
     return mergeBufferGeometries(arr, useGroups);
 }
+
+Matrix4 threepp::quantizePositions(BufferGeometry& geometry, int bits) {
+
+    const auto position = geometry.getAttribute<float>("position");
+    if (!position || (bits != 8 && bits != 16)) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .quantizePositions() requires a float position attribute and a bit depth of 8 or 16." << std::endl;
+        return {};
+    }
+
+    if (geometry.getMorphAttribute("position")) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .quantizePositions() does not support morph targets." << std::endl;
+        return {};
+    }
+
+    geometry.computeBoundingBox();
+    geometry.computeBoundingSphere();
+
+    const auto& box = *geometry.boundingBox;
+    const auto size = box.getSize();
+    auto scale = std::max({size.x, size.y, size.z});
+    if (scale == 0) scale = 1;
+
+    Matrix4 dequantize;
+    dequantize.makeScale(scale, scale, scale).setPosition(box.min());
+
+    std::unique_ptr<BufferAttribute> quantized;
+    if (bits == 16) {
+
+        quantized = Uint16BufferAttribute::create(quantize<uint16_t>(*position, box.min(), scale), 3, true);
+
+    } else {
+
+        quantized = Uint8BufferAttribute::create(quantize<uint8_t>(*position, box.min(), scale), 3, true);
+    }
+
+    quantized->setUsage(position->getUsage());
+    geometry.setAttribute("position", std::move(quantized));
+
+    const auto inverse = Matrix4(dequantize).invert();
+    geometry.boundingBox->applyMatrix4(inverse);
+    geometry.boundingSphere->applyMatrix4(inverse);
+
+    return dequantize;
+}
+
+void threepp::encodeNormalsOctahedral(BufferGeometry& geometry, int bits) {
+
+    const auto normal = geometry.getAttribute<float>("normal");
+    if (!normal || normal->itemSize() != 3 || (bits != 8 && bits != 16)) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .encodeNormalsOctahedral() requires a three component float normal attribute and a bit depth of 8 or 16." << std::endl;
+        return;
+    }
+
+    std::unique_ptr<BufferAttribute> encoded;
+    if (bits == 16) {
+
+        encoded = Int16BufferAttribute::create(octahedralEncode<int16_t>(*normal), 2, true);
+
+    } else {
+
+        encoded = Int8BufferAttribute::create(octahedralEncode<int8_t>(*normal), 2, true);
+    }
+
+    encoded->setUsage(normal->getUsage());
+    geometry.setAttribute("normal", std::move(encoded));
+}
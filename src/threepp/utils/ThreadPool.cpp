@@ -0,0 +1,210 @@
+
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    // set while a thread runs pool work, so that nested parallelFor calls run inline instead of deadlocking
+    thread_local bool insideJob = false;
+
+}// namespace
+
+struct ThreadPool::Impl {
+
+    explicit Impl(unsigned int numThreads) {
+
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        // the calling thread is one of the participants
+        for (unsigned i = 1; i < numThreads; i++) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    [[nodiscard]] size_t size() const {
+
+        return workers_.size() + 1;
+    }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+
+        if (count == 0) return;
+
+        if (workers_.empty() || count == 1 || insideJob) {
+            for (size_t i = 0; i < count; i++) fn(i);
+            return;
+        }
+
+        // one job at a time, concurrent callers wait their turn
+        std::lock_guard<std::mutex> submitLock(submitMutex_);
+
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            job_ = &fn;
+            jobSize_ = count;
+            next_ = 0;
+            pending_ = count;
+            ++generation_;
+        }
+        cv_.notify_all();
+
+        runJob(fn, count);
+
+        std::unique_lock<std::mutex> lock(m_);
+        // workers that picked up this job must be done with it before fn goes out of scope
+        done_.wait(lock, [this] { return pending_ == 0 && active_ == 0; });
+        job_ = nullptr;
+
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void submit(std::function<void()> fn) {
+
+        if (workers_.empty()) {
+            fn();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            tasks_.emplace_back(std::move(fn));
+        }
+        cv_.notify_one();
+    }
+
+    ~Impl() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+private:
+    std::vector<std::thread> workers_;
+
+    std::mutex submitMutex_;
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::condition_variable done_;
+
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t jobSize_ = 0;
+    std::atomic<size_t> next_ = 0;
+    size_t pending_ = 0;
+    size_t active_ = 0;
+    size_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::deque<std::function<void()>> tasks_;
+
+    void runJob(const std::function<void(size_t)>& fn, size_t count) {
+
+        size_t completed = 0;
+        insideJob = true;
+        for (size_t i = next_++; i < count; i = next_++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_);
+                if (!error_) error_ = std::current_exception();
+            }
+            ++completed;
+        }
+        insideJob = false;
+
+        if (completed > 0) {
+            std::lock_guard<std::mutex> lock(m_);
+            pending_ -= completed;
+            if (pending_ == 0) done_.notify_all();
+        }
+    }
+
+    static void runTask(const std::function<void()>& task) {
+
+        insideJob = true;
+        try {
+            task();
+        } catch (...) {
+            // nobody to report to, tasks are expected to handle their own errors
+        }
+        insideJob = false;
+    }
+
+    void workerLoop() {
+
+        size_t seenGeneration = 0;
+
+        while (true) {
+
+            const std::function<void(size_t)>* job;
+            size_t count;
+
+            {
+                std::unique_lock<std::mutex> lock(m_);
+                cv_.wait(lock, [&] { return stop_ || (job_ && generation_ != seenGeneration) || !tasks_.empty(); });
+
+                if (stop_) return;
+
+                if (!job_ || generation_ == seenGeneration) {
+
+                    // no parallelFor waiting on us, run a submitted task
+                    auto task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                    lock.unlock();
+
+                    runTask(task);
+                    continue;
+                }
+
+                seenGeneration = generation_;
+                job = job_;
+                count = jobSize_;
+                ++active_;
+            }
+
+            runJob(*job, count);
+
+            std::lock_guard<std::mutex> lock(m_);
+            if (--active_ == 0 && pending_ == 0) done_.notify_all();
+        }
+    }
+};
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : pimpl_(std::make_unique<Impl>(numThreads)) {}
+
+size_t ThreadPool::size() const {
+
+    return pimpl_->size();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+
+    pimpl_->parallelFor(count, fn);
+}
+
+void ThreadPool::submit(std::function<void()> fn) {
+
+    pimpl_->submit(std::move(fn));
+}
+
+ThreadPool::~ThreadPool() = default;